@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListArena.h"
+
+#import <pthread.h>
+
+namespace IGListKit {
+
+// pthread keys instead of thread_local so the destructor runs on iOS 8
+static pthread_key_t IGListArenaKey;
+static pthread_once_t IGListArenaKeyOnce = PTHREAD_ONCE_INIT;
+
+static void IGListArenaDestroy(void *arena) {
+    delete static_cast<IGListArena *>(arena);
+}
+
+static void IGListArenaCreateKey(void) {
+    pthread_key_create(&IGListArenaKey, IGListArenaDestroy);
+}
+
+IGListArena *IGListArenaForCurrentThread() {
+    pthread_once(&IGListArenaKeyOnce, IGListArenaCreateKey);
+    IGListArena *arena = static_cast<IGListArena *>(pthread_getspecific(IGListArenaKey));
+    if (arena == nullptr) {
+        arena = new IGListArena();
+        pthread_setspecific(IGListArenaKey, arena);
+    }
+    return arena;
+}
+
+} // namespace IGListKit
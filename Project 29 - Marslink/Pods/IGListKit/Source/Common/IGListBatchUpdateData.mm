@@ -8,47 +8,66 @@
  */
 
 #import "IGListBatchUpdateData.h"
+#import "IGListBatchUpdateDataInternal.h"
 #import <IGListKit/IGListCompatibility.h>
 
-#import <unordered_map>
+#import <vector>
 
 #import <IGListKit/IGListAssert.h>
 
-// Plucks the given move from available moves and turns it into a delete + insert
-static void convertMoveToDeleteAndInsert(NSMutableSet<IGListMoveIndex *> *moves,
-                                         IGListMoveIndex *move,
-                                         NSMutableIndexSet *deletes,
-                                         NSMutableIndexSet *inserts) {
-    [moves removeObject:move];
-
-    // add a delete and insert respecting the move's from and to sections
-    // delete + insert will result in reloading the entire section
-    [deletes addIndex:move.from];
-    [inserts addIndex:move.to];
+#import "IGListBatchUpdateCleanup.h"
+#import "IGListMoveIndexPathInternal.h"
+
+using namespace IGListKit;
+
+static IGListSectionBitmap bitmapFromRuns(IGListRunIndexSet *indexes) {
+    IGListSectionBitmap bitmap;
+    for (const auto &run : [indexes runs].runs()) {
+        bitmap.setRange(run.location, run.length);
+    }
+    return bitmap;
 }
 
-@implementation IGListBatchUpdateData
-
-// Converts all section moves that have index path operations into a section delete + insert.
-+ (void)cleanIndexPathsWithMap:(const std::unordered_map<NSInteger, IGListMoveIndex*> &)map
-                         moves:(NSMutableSet<IGListMoveIndex *> *)moves
-                    indexPaths:(NSMutableArray<NSIndexPath *> *)indexPaths
-                       deletes:(NSMutableIndexSet *)deletes
-                       inserts:(NSMutableIndexSet *)inserts {
-    for (NSInteger i = indexPaths.count - 1; i >= 0; i--) {
-        NSIndexPath *path = indexPaths[i];
-        const auto it = map.find(path.section);
-        if (it != map.end() && it->second != nil) {
-            [indexPaths removeObjectAtIndex:i];
-            convertMoveToDeleteAndInsert(moves, it->second, deletes, inserts);
-        }
+static IGListRunIndexSet *runsFromBitmap(const IGListSectionBitmap &bitmap) {
+    IGListRunIndexSet *indexes = [IGListRunIndexSet new];
+    bitmap.enumerateRanges([indexes](size_t location, size_t length) {
+        [indexes addIndexesInRange:NSMakeRange(location, length)];
+    });
+    return indexes;
+}
+
+static std::vector<uint64_t> packedIndexPaths(NSArray<NSIndexPath *> *indexPaths) {
+    std::vector<uint64_t> packed;
+    packed.reserve(indexPaths.count);
+    for (NSIndexPath *path in indexPaths) {
+        packed.push_back(IGListPackIndexPath(path.section, path.item));
     }
+    return packed;
+}
+
+static NSArray<NSIndexPath *> *indexPathsAtPositions(const std::vector<uint64_t> &packed,
+                                                     const std::vector<size_t> &positions) {
+    NSMutableArray<NSIndexPath *> *result = [NSMutableArray arrayWithCapacity:positions.size()];
+    for (const size_t position : positions) {
+        const uint64_t key = packed[position];
+        [result addObject:[NSIndexPath indexPathForItem:IGListPackedItem(key) inSection:IGListPackedSection(key)]];
+    }
+    return result;
+}
+
+static NSArray *objectsAtPositions(NSArray *objects, const std::vector<size_t> &positions) {
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:positions.size()];
+    for (const size_t position : positions) {
+        [result addObject:objects[position]];
+    }
+    return result;
+}
+
+@implementation IGListBatchUpdateData {
+    NSIndexSet *_insertSections;
+    NSIndexSet *_deleteSections;
 }
 
-/**
- Converts all section moves that are also reloaded, or have index path inserts, deletes, or reloads into a section
- delete + insert in order to avoid UICollectionView heap corruptions, exceptions, and animation/snapshot bugs.
- */
 - (instancetype)initWithInsertSections:(NSIndexSet *)insertSections
                         deleteSections:(NSIndexSet *)deleteSections
                           moveSections:(NSSet<IGListMoveIndex *> *)moveSections
@@ -57,79 +76,143 @@ static void convertMoveToDeleteAndInsert(NSMutableSet<IGListMoveIndex *> *moves,
                         moveIndexPaths:(NSArray<IGListMoveIndexPath *> *)moveIndexPaths {
     IGParameterAssert(insertSections != nil);
     IGParameterAssert(deleteSections != nil);
+    if (self = [super init]) {
+        [self cleanInsertSections:[IGListRunIndexSet indexSetWithIndexSet:insertSections]
+                   deleteSections:[IGListRunIndexSet indexSetWithIndexSet:deleteSections]
+                     moveSections:moveSections
+                 insertIndexPaths:insertIndexPaths
+                 deleteIndexPaths:deleteIndexPaths
+                   moveIndexPaths:moveIndexPaths];
+    }
+    return self;
+}
+
+- (instancetype)initWithInsertSectionRuns:(IGListRunIndexSet *)insertSections
+                        deleteSectionRuns:(IGListRunIndexSet *)deleteSections
+                             moveSections:(NSSet<IGListMoveIndex *> *)moveSections
+                         insertIndexPaths:(NSArray<NSIndexPath *> *)insertIndexPaths
+                         deleteIndexPaths:(NSArray<NSIndexPath *> *)deleteIndexPaths
+                           moveIndexPaths:(NSArray<IGListMoveIndexPath *> *)moveIndexPaths {
+    IGParameterAssert(insertSections != nil);
+    IGParameterAssert(deleteSections != nil);
+    if (self = [super init]) {
+        [self cleanInsertSections:insertSections
+                   deleteSections:deleteSections
+                     moveSections:moveSections
+                 insertIndexPaths:insertIndexPaths
+                 deleteIndexPaths:deleteIndexPaths
+                   moveIndexPaths:moveIndexPaths];
+    }
+    return self;
+}
+
+- (instancetype)initWithInsertSectionRuns:(IGListRunIndexSet *)insertSections
+                        deleteSectionRuns:(IGListRunIndexSet *)deleteSections
+                             moveSections:(NSSet<IGListMoveIndex *> *)moveSections
+                   packedInsertIndexPaths:(const std::vector<uint64_t> &)insertIndexPaths
+                   packedDeleteIndexPaths:(const std::vector<uint64_t> &)deleteIndexPaths
+                     packedMoveIndexPaths:(const std::vector<IGListPackedMove> &)moveIndexPaths {
+    IGParameterAssert(insertSections != nil);
+    IGParameterAssert(deleteSections != nil);
     IGParameterAssert(moveSections != nil);
-    IGParameterAssert(insertIndexPaths != nil);
-    IGParameterAssert(deleteIndexPaths != nil);
-    IGParameterAssert(moveIndexPaths != nil);
     if (self = [super init]) {
-        NSMutableSet<IGListMoveIndex *> *mMoveSections = [moveSections mutableCopy];
-        NSMutableIndexSet *mDeleteSections = [deleteSections mutableCopy];
-        NSMutableIndexSet *mInsertSections = [insertSections mutableCopy];
-        NSMutableSet<IGListMoveIndexPath *> *mMoveIndexPaths = [moveIndexPaths mutableCopy];
-
-        // these collections should NEVER be mutated during cleanup passes, otherwise sections that have multiple item
-        // changes (e.g. a moved section that has a delete + reload on different index paths w/in the section) will only
-        // convert one of the item changes into a section delete+insert. this will fail hard and be VERY difficult to
-        // debug
-        const NSInteger moveCount = [moveSections count];
-        std::unordered_map<NSInteger, IGListMoveIndex*> fromMap(moveCount);
-        std::unordered_map<NSInteger, IGListMoveIndex*> toMap(moveCount);
-        for (IGListMoveIndex *move in moveSections) {
-            const NSInteger from = move.from;
-            const NSInteger to = move.to;
-
-            // if the move is already deleted or inserted, discard it because count-changing operations must match
-            // with data source changes
-            if ([deleteSections containsIndex:from] || [insertSections containsIndex:to]) {
-                [mMoveSections removeObject:move];
-            } else {
-                fromMap[from] = move;
-                toMap[to] = move;
-            }
+        IGListBatchUpdateCleanup cleanup;
+        cleanup.insertItems = insertIndexPaths;
+        cleanup.deleteItems = deleteIndexPaths;
+        cleanup.itemMoveFromSections.reserve(moveIndexPaths.size());
+        for (const auto &move : moveIndexPaths) {
+            cleanup.itemMoveFromSections.push_back(IGListPackedSection(move.from));
         }
 
-        NSMutableArray<NSIndexPath *> *mInsertIndexPaths = [insertIndexPaths mutableCopy];
-
-        // avoid a flaky UICollectionView bug when deleting from the same index path twice
-        // exposes a possible data source inconsistency issue
-        NSMutableArray<NSIndexPath *> *mDeleteIndexPaths = [[[NSSet setWithArray:deleteIndexPaths] allObjects] mutableCopy];
-
-        // avoids a bug where a cell is animated twice and one of the snapshot cells is never removed from the hierarchy
-        [IGListBatchUpdateData cleanIndexPathsWithMap:fromMap moves:mMoveSections indexPaths:mDeleteIndexPaths deletes:mDeleteSections inserts:mInsertSections];
-
-        // prevents a bug where UICollectionView corrupts the heap memory when inserting into a section that is moved
-        [IGListBatchUpdateData cleanIndexPathsWithMap:toMap moves:mMoveSections indexPaths:mInsertIndexPaths deletes:mDeleteSections inserts:mInsertSections];
-
-        for (IGListMoveIndexPath *move in moveIndexPaths) {
-            // if the section w/ an index path move is deleted, just drop the move
-            if ([deleteSections containsIndex:move.from.section]) {
-                [mMoveIndexPaths removeObject:move];
-            }
-
-            // if a move is inside a section that is moved, convert the section move to a delete+insert
-            const auto it = fromMap.find(move.from.section);
-            if (it != fromMap.end() && it->second != nil) {
-                IGListMoveIndex *sectionMove = it->second;
-                [mMoveIndexPaths removeObject:move];
-                [mMoveSections removeObject:sectionMove];
-                [mDeleteSections addIndex:sectionMove.from];
-                [mInsertSections addIndex:sectionMove.to];
-            }
-        }
+        [self runCleanup:cleanup insertSections:insertSections deleteSections:deleteSections moveSections:moveSections];
 
-        _deleteSections = [mDeleteSections copy];
-        _insertSections = [mInsertSections copy];
-        _moveSections = [mMoveSections copy];
-        _deleteIndexPaths = [mDeleteIndexPaths copy];
-        _insertIndexPaths = [mInsertIndexPaths copy];
-        _moveIndexPaths = [mMoveIndexPaths copy];
+        _deleteIndexPaths = indexPathsAtPositions(deleteIndexPaths, cleanup.keptDeleteItems);
+        _insertIndexPaths = indexPathsAtPositions(insertIndexPaths, cleanup.keptInsertItems);
+        NSMutableArray<IGListMoveIndexPath *> *moves = [NSMutableArray arrayWithCapacity:cleanup.keptItemMoves.size()];
+        for (const size_t position : cleanup.keptItemMoves) {
+            const IGListPackedMove &move = moveIndexPaths[position];
+            NSIndexPath *from = [NSIndexPath indexPathForItem:IGListPackedItem(move.from) inSection:IGListPackedSection(move.from)];
+            NSIndexPath *to = [NSIndexPath indexPathForItem:IGListPackedItem(move.to) inSection:IGListPackedSection(move.to)];
+            [moves addObject:[[IGListMoveIndexPath alloc] initWithFrom:from to:to]];
+        }
+        _moveIndexPaths = moves;
     }
     return self;
 }
 
+/**
+ Converts all section moves that are also reloaded, or have index path inserts, deletes, or reloads into a section
+ delete + insert in order to avoid UICollectionView heap corruptions, exceptions, and animation/snapshot bugs.
+
+ The cleanup runs over section bitmaps and packed index paths. Foundation objects are only built for the result, and
+ kept index paths and moves are the caller's own objects.
+ */
+- (void)cleanInsertSections:(IGListRunIndexSet *)insertSections
+             deleteSections:(IGListRunIndexSet *)deleteSections
+               moveSections:(NSSet<IGListMoveIndex *> *)moveSections
+           insertIndexPaths:(NSArray<NSIndexPath *> *)insertIndexPaths
+           deleteIndexPaths:(NSArray<NSIndexPath *> *)deleteIndexPaths
+             moveIndexPaths:(NSArray<IGListMoveIndexPath *> *)moveIndexPaths {
+    IGParameterAssert(moveSections != nil);
+    IGParameterAssert(insertIndexPaths != nil);
+    IGParameterAssert(deleteIndexPaths != nil);
+    IGParameterAssert(moveIndexPaths != nil);
+
+    IGListBatchUpdateCleanup cleanup;
+    cleanup.insertItems = packedIndexPaths(insertIndexPaths);
+    cleanup.deleteItems = packedIndexPaths(deleteIndexPaths);
+
+    cleanup.itemMoveFromSections.reserve(moveIndexPaths.count);
+    for (IGListMoveIndexPath *move in moveIndexPaths) {
+        cleanup.itemMoveFromSections.push_back(move.from.section);
+    }
+
+    [self runCleanup:cleanup insertSections:insertSections deleteSections:deleteSections moveSections:moveSections];
+
+    _deleteIndexPaths = objectsAtPositions(deleteIndexPaths, cleanup.keptDeleteItems);
+    _insertIndexPaths = objectsAtPositions(insertIndexPaths, cleanup.keptInsertItems);
+    _moveIndexPaths = objectsAtPositions(moveIndexPaths, cleanup.keptItemMoves);
+}
+
+/// Fills in the section inputs of a cleanup whose item inputs are set, runs it, and stores the resulting sections.
+- (void)runCleanup:(IGListBatchUpdateCleanup &)cleanup
+    insertSections:(IGListRunIndexSet *)insertSections
+    deleteSections:(IGListRunIndexSet *)deleteSections
+      moveSections:(NSSet<IGListMoveIndex *> *)moveSections {
+    cleanup.insertSections = bitmapFromRuns(insertSections);
+    cleanup.deleteSections = bitmapFromRuns(deleteSections);
+
+    NSArray<IGListMoveIndex *> *sectionMoves = [moveSections allObjects];
+    cleanup.sectionMoves.reserve(sectionMoves.count);
+    for (IGListMoveIndex *move in sectionMoves) {
+        cleanup.sectionMoves.push_back({move.from, move.to});
+    }
+
+    cleanup.run();
+
+    _deleteSectionRuns = runsFromBitmap(cleanup.deleteSections);
+    _insertSectionRuns = runsFromBitmap(cleanup.insertSections);
+    _moveSections = [NSSet setWithArray:objectsAtPositions(sectionMoves, cleanup.keptSectionMoves)];
+}
+
+// section indexes are carried as runs and bridged once, the first time they are handed to UIKit
+- (NSIndexSet *)insertSections {
+    if (_insertSections == nil) {
+        _insertSections = self.insertSectionRuns.indexSet;
+    }
+    return _insertSections;
+}
+
+- (NSIndexSet *)deleteSections {
+    if (_deleteSections == nil) {
+        _deleteSections = self.deleteSectionRuns.indexSet;
+    }
+    return _deleteSections;
+}
+
 - (NSString *)description {
     return [NSString stringWithFormat:@"<%@ %p; deleteSections: %zi; insertSections: %zi; moveSections: %zi; deleteIndexPaths: %zi; insertIndexPaths: %zi;>",
-            NSStringFromClass(self.class), self, self.deleteSections.count, self.insertSections.count, self.moveSections.count,
+            NSStringFromClass(self.class), self, self.deleteSectionRuns.count, self.insertSectionRuns.count, self.moveSections.count,
             self.deleteIndexPaths.count, self.insertIndexPaths.count];
 }
 
@@ -9,7 +9,6 @@
 
 #import "IGListDiff.h"
 
-#import <stack>
 #import <unordered_map>
 #import <vector>
 
@@ -17,12 +16,24 @@
 #import <IGListKit/IGListMacros.h>
 #import <IGListKit/IGListExperiments.h>
 
+#import "IGListArena.h"
+#import "IGListDiffableInternal.h"
+#import "IGListDiffInternal.h"
 #import "IGListIndexPathResultInternal.h"
 #import "IGListIndexSetResultInternal.h"
 #import "IGListMoveIndexInternal.h"
 #import "IGListMoveIndexPathInternal.h"
 
 using namespace std;
+using namespace IGListKit;
+
+/// Node of the per-entry stack of old indexes. Nodes live in one arena-backed array instead of a heap-allocated stack per entry.
+struct IGListIndexNode {
+    /// The index of the data in the old array, or NSNotFound
+    NSInteger index;
+    /// Position of the next node in the stack, or -1 at the bottom
+    NSInteger next;
+};
 
 /// Used to track data stats while diffing.
 struct IGListEntry {
@@ -30,8 +41,8 @@ struct IGListEntry {
     NSInteger oldCounter = 0;
     /// The number of times the data occurs in the new array
     NSInteger newCounter = 0;
-    /// The indexes of the data in the old array
-    stack<NSInteger> oldIndexes;
+    /// Top of the stack of indexes of the data in the old array, or -1 when empty
+    NSInteger oldIndexes = -1;
     /// Flag marking if the data has been updated between arrays by checking the isEqual: method
     BOOL updated = NO;
 };
@@ -47,24 +58,6 @@ struct IGListRecord {
     }
 };
 
-static id<NSObject> IGListTableKey(id<IGListDiffable> object) {
-    id<NSObject> key = [object diffIdentifier];
-    NSCAssert(key != nil, @"Cannot use a nil key for the diffIdentifier of object %@", object);
-    return key;
-}
-
-struct IGListEqualID {
-    bool operator()(const id a, const id b) const {
-        return (a == b) || [a isEqual: b];
-    }
-};
-
-struct IGListHashID {
-    size_t operator()(const id o) const {
-        return (size_t)[o hash];
-    }
-};
-
 static id IGListDiffing(BOOL returnIndexPaths,
                         NSInteger fromSection,
                         NSInteger toSection,
@@ -75,21 +68,38 @@ static id IGListDiffing(BOOL returnIndexPaths,
     const NSInteger newCount = newArray.count;
     const NSInteger oldCount = oldArray.count;
 
+    // all scratch storage is served from the calling thread's arena, which is rewound (not freed) when the scope exits.
+    // the scope must outlive every container below
+    IGListArenaScope arenaScope;
+    IGListArena *arena = arenaScope.arena();
+
     // symbol table uses the old/new array diffIdentifier as the key and IGListEntry as the value
     // using id<NSObject> as the key provided by https://lists.gnu.org/archive/html/discuss-gnustep/2011-07/msg00019.html
-    unordered_map<id<NSObject>, IGListEntry, IGListHashID, IGListEqualID> table;
+    typedef IGListArenaAllocator<pair<const id<NSObject>, IGListEntry>> IGListTableAllocator;
+    unordered_map<id<NSObject>, IGListEntry, IGListHashID, IGListEqualID, IGListTableAllocator> table(newCount + oldCount,
+                                                                                                    IGListHashID(),
+                                                                                                    IGListEqualID(),
+                                                                                                    IGListTableAllocator(arena));
+
+    // backing storage for every entry's stack of old indexes. each new and old item pushes exactly one node
+    IGListArenaVector<IGListIndexNode> indexNodes{IGListArenaAllocator<IGListIndexNode>(arena)};
+    indexNodes.reserve(newCount + oldCount);
+    auto pushOldIndex = [&indexNodes](IGListEntry &entry, NSInteger index) {
+        indexNodes.push_back({index, entry.oldIndexes});
+        entry.oldIndexes = (NSInteger)indexNodes.size() - 1;
+    };
 
     // pass 1
     // create an entry for every item in the new array
     // increment its new count for each occurence
-    vector<IGListRecord> newResultsArray(newCount);
+    IGListArenaVector<IGListRecord> newResultsArray(newCount, IGListRecord(), IGListArenaAllocator<IGListRecord>(arena));
     for (NSInteger i = 0; i < newCount; i++) {
         id<NSObject> key = IGListTableKey(newArray[i]);
         IGListEntry &entry = table[key];
         entry.newCounter++;
 
         // add NSNotFound for each occurence of the item in the new array
-        entry.oldIndexes.push(NSNotFound);
+        pushOldIndex(entry, NSNotFound);
 
         // note: the entry is just a pointer to the entry which is stack-allocated in the table
         newResultsArray[i].entry = &entry;
@@ -100,14 +110,14 @@ static id IGListDiffing(BOOL returnIndexPaths,
     // increment its old count for each occurence
     // record the original index of the item in the old array
     // MUST be done in descending order to respect the oldIndexes stack construction
-    vector<IGListRecord> oldResultsArray(oldCount);
+    IGListArenaVector<IGListRecord> oldResultsArray(oldCount, IGListRecord(), IGListArenaAllocator<IGListRecord>(arena));
     for (NSInteger i = oldCount - 1; i >= 0; i--) {
         id<NSObject> key = IGListTableKey(oldArray[i]);
         IGListEntry &entry = table[key];
         entry.oldCounter++;
 
         // push the original indices where the item occurred onto the index stack
-        entry.oldIndexes.push(i);
+        pushOldIndex(entry, i);
 
         // note: the entry is just a pointer to the entry which is stack-allocated in the table
         oldResultsArray[i].entry = &entry;
@@ -119,9 +129,10 @@ static id IGListDiffing(BOOL returnIndexPaths,
         IGListEntry *entry = newResultsArray[i].entry;
 
         // grab and pop the top original index. if the item was inserted this will be NSNotFound
-        NSCAssert(!entry->oldIndexes.empty(), @"Old indexes is empty while iterating new item %zi. Should have NSNotFound", i);
-        const NSInteger originalIndex = entry->oldIndexes.top();
-        entry->oldIndexes.pop();
+        NSCAssert(entry->oldIndexes != -1, @"Old indexes is empty while iterating new item %zi. Should have NSNotFound", i);
+        const IGListIndexNode &top = indexNodes[entry->oldIndexes];
+        const NSInteger originalIndex = top.index;
+        entry->oldIndexes = top.next;
 
         if (originalIndex < oldCount) {
             const id<IGListDiffable> n = newArray[i];
@@ -135,8 +146,9 @@ static id IGListDiffing(BOOL returnIndexPaths,
                     break;
                 case IGListDiffEquality:
                     // use -[IGListDiffable isEqualToDiffableObject:] between both version of data to see if anything has changed
-                    // skip the equality check if both indexes point to the same object
-                    if (n != o && ![n isEqualToDiffableObject:o]) {
+                    // skip the equality check if both indexes point to the same object, and compare -diffVersion instead
+                    // when both objects are versioned
+                    if (n != o && !IGListDiffableIsEqual(n, o)) {
                         entry->updated = YES;
                     }
                     break;
@@ -192,7 +204,8 @@ static id IGListDiffing(BOOL returnIndexPaths,
     };
 
     // track offsets from deleted items to calculate where items have moved
-    vector<NSInteger> deleteOffsets(oldCount), insertOffsets(newCount);
+    IGListArenaVector<NSInteger> deleteOffsets(oldCount, 0, IGListArenaAllocator<NSInteger>(arena));
+    IGListArenaVector<NSInteger> insertOffsets(newCount, 0, IGListArenaAllocator<NSInteger>(arena));
     NSInteger runningOffset = 0;
 
     // iterate old array records checking for deletes
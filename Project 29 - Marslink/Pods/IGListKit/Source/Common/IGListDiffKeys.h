@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Marks a missing index in a key diff result, the equivalent of `NSNotFound`.
+ */
+FOUNDATION_EXTERN const size_t IGListKeyNotFound NS_SWIFT_NAME(ListKeyNotFound);
+
+/**
+ A move from an index in the old keys to an index in the new keys.
+ */
+NS_SWIFT_NAME(ListKeyMove)
+typedef struct IGListKeyMove {
+    size_t from;
+    size_t to;
+} IGListKeyMove;
+
+/**
+ The result of diffing two arrays of keys. All arrays live in a single allocation owned by the result and are only valid
+ until the result is passed to `IGListKeyDiffResultRelease()`.
+ */
+NS_SWIFT_NAME(ListKeyDiffResult)
+typedef struct IGListKeyDiffResult {
+    /// The indexes inserted into the new keys, ascending.
+    const size_t *_Nullable inserts;
+    size_t insertCount;
+    /// The indexes deleted from the old keys, ascending.
+    const size_t *_Nullable deletes;
+    size_t deleteCount;
+    /// The indexes in the old keys whose version changed, ascending.
+    const size_t *_Nullable updates;
+    size_t updateCount;
+    /// The moves from old to new indexes, ordered by new index.
+    const IGListKeyMove *_Nullable moves;
+    size_t moveCount;
+    /// For each old key, its index in the new keys or `IGListKeyNotFound`. Has `oldCount` elements.
+    const size_t *_Nullable oldToNew;
+    /// For each new key, its index in the old keys or `IGListKeyNotFound`. Has `newCount` elements.
+    const size_t *_Nullable newToOld;
+    /// :nodoc:
+    void *_Nullable _storage;
+} IGListKeyDiffResult;
+
+/**
+ Diffs two arrays of 64-bit keys with the same algorithm as `IGListDiff()`, without Objective-C objects.
+
+ Equal keys identify the same object, like equal diff identifiers. When both version arrays are provided an object is
+ updated if its versions differ, like `-[IGListDiffable diffVersion]`. Otherwise no updates are reported.
+
+ @param oldKeys The old keys.
+ @param oldCount The number of old keys.
+ @param newKeys The new keys.
+ @param newCount The number of new keys.
+ @param oldVersions Optional versions, one for each old key.
+ @param newVersions Optional versions, one for each new key.
+
+ @return A result that must be passed to `IGListKeyDiffResultRelease()`. If memory runs out, every array of the result is
+ `NULL` and every count is zero, which callers with keys to diff can detect from `oldToNew` or `newToOld`.
+
+ @note Scratch storage is served from the calling thread's diffing arena, so the only allocation is the result itself.
+ */
+NS_SWIFT_NAME(ListDiffKeys(_:_:_:_:_:_:))
+FOUNDATION_EXTERN IGListKeyDiffResult IGListDiffKeys(const uint64_t *_Nullable oldKeys,
+                                                     size_t oldCount,
+                                                     const uint64_t *_Nullable newKeys,
+                                                     size_t newCount,
+                                                     const uint64_t *_Nullable oldVersions,
+                                                     const uint64_t *_Nullable newVersions);
+
+/**
+ Frees the storage of a key diff result and clears it.
+
+ @param result The result to release.
+ */
+NS_SWIFT_NAME(ListKeyDiffResultRelease(_:))
+FOUNDATION_EXTERN void IGListKeyDiffResultRelease(IGListKeyDiffResult *result);
+
+NS_ASSUME_NONNULL_END
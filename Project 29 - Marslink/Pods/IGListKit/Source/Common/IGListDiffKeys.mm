@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListDiffKeys.h"
+
+#import <cstdlib>
+#import <cstring>
+#import <new>
+
+#import <IGListKit/IGListAssert.h>
+
+#import "IGListArena.h"
+#import "IGListKeyDiff.h"
+
+using namespace IGListKit;
+
+const size_t IGListKeyNotFound = kIGListKeyNotFound;
+
+static IGListKeyDiffResult IGListDiffKeysThrowing(const uint64_t *oldKeys,
+                                                  size_t oldCount,
+                                                  const uint64_t *newKeys,
+                                                  size_t newCount,
+                                                  const uint64_t *oldVersions,
+                                                  const uint64_t *newVersions) {
+    IGListArenaScope arenaScope;
+    IGListKeyDiffOutput output(arenaScope.arena());
+    IGListKeyDiffing(oldKeys, oldCount, newKeys, newCount, oldVersions, newVersions, arenaScope.arena(), output);
+
+    // pack every array into one allocation so the result is a single free
+    const size_t moveCount = output.moves.size();
+    const size_t indexCount = output.inserts.size() + output.deletes.size() + output.updates.size() + oldCount + newCount;
+    const size_t bytes = moveCount * sizeof(IGListKeyMove) + indexCount * sizeof(size_t);
+    char *storage = bytes > 0 ? static_cast<char *>(malloc(bytes)) : nullptr;
+    if (bytes > 0 && storage == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    IGListKeyDiffResult result = {};
+    result._storage = storage;
+
+    IGListKeyMove *moves = reinterpret_cast<IGListKeyMove *>(storage);
+    for (size_t i = 0; i < moveCount; i++) {
+        moves[i] = {output.moves[i].first, output.moves[i].second};
+    }
+    result.moves = moves;
+    result.moveCount = moveCount;
+
+    size_t *cursor = reinterpret_cast<size_t *>(storage + moveCount * sizeof(IGListKeyMove));
+    auto pack = [&cursor](const IGListArenaVector<size_t> &source, const size_t **destination) {
+        if (!source.empty()) {
+            memcpy(cursor, source.data(), source.size() * sizeof(size_t));
+        }
+        *destination = cursor;
+        cursor += source.size();
+        return source.size();
+    };
+    result.insertCount = pack(output.inserts, &result.inserts);
+    result.deleteCount = pack(output.deletes, &result.deletes);
+    result.updateCount = pack(output.updates, &result.updates);
+    pack(output.oldToNew, &result.oldToNew);
+    pack(output.newToOld, &result.newToOld);
+
+    return result;
+}
+
+IGListKeyDiffResult IGListDiffKeys(const uint64_t *oldKeys,
+                                   size_t oldCount,
+                                   const uint64_t *newKeys,
+                                   size_t newCount,
+                                   const uint64_t *oldVersions,
+                                   const uint64_t *newVersions) {
+    IGParameterAssert(oldKeys != NULL || oldCount == 0);
+    IGParameterAssert(newKeys != NULL || newCount == 0);
+    IGAssert((oldVersions == NULL) == (newVersions == NULL), @"Provide versions for both arrays of keys or neither");
+
+    // C and Swift callers cannot catch C++ exceptions, so running out of memory returns an empty result
+    try {
+        return IGListDiffKeysThrowing(oldKeys, oldCount, newKeys, newCount, oldVersions, newVersions);
+    } catch (const std::bad_alloc &) {
+        return IGListKeyDiffResult();
+    }
+}
+
+void IGListKeyDiffResultRelease(IGListKeyDiffResult *result) {
+    IGParameterAssert(result != NULL);
+    free(result->_storage);
+    *result = IGListKeyDiffResult();
+}
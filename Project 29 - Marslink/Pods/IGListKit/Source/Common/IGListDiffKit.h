@@ -23,10 +23,13 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import <IGListKit/IGListBatchUpdateData.h>
 #import <IGListKit/IGListDiff.h>
 #import <IGListKit/IGListDiffable.h>
+#import <IGListKit/IGListDiffKeys.h>
 #import <IGListKit/IGListExperiments.h>
+#import <IGListKit/IGListHashQualityReport.h>
 #import <IGListKit/IGListIndexPathResult.h>
 #import <IGListKit/IGListIndexSetResult.h>
 #import <IGListKit/IGListMoveIndex.h>
 #import <IGListKit/IGListMoveIndexPath.h>
+#import <IGListKit/IGListMovePlanning.h>
 #import <IGListKit/NSNumber+IGListDiffable.h>
 #import <IGListKit/NSString+IGListDiffable.h>
@@ -37,4 +37,19 @@ NS_SWIFT_NAME(ListDiffable)
  */
 - (BOOL)isEqualToDiffableObject:(nullable id<IGListDiffable>)object;
 
+@optional
+
+/**
+ Returns a revision number for the object's contents.
+
+ @return A number that changes whenever the contents of the object change.
+
+ @note When both objects being compared implement this method, the diffing algorithm and `IGListAdapter` compare
+ versions instead of calling `-isEqualToDiffableObject:`. Use this when your models are immutable records that already
+ carry a revision, such as rows from a store that tracks changes.
+
+ @warning Two objects with the same `-diffIdentifier` and the same version must be equal.
+ */
+- (uint64_t)diffVersion;
+
 @end
@@ -18,10 +18,12 @@ NS_SWIFT_NAME(ListExperiment)
 typedef NS_OPTIONS (NSInteger, IGListExperiment) {
     /// Specifies no experiments.
     IGListExperimentNone = 1 << 1,
-    /// Test updater diffing performed on a background queue.
+    /// Diff updates on a background queue. Equivalent to `IGListAdapterUpdater.diffsInBackground`.
     IGListExperimentBackgroundDiffing = 1 << 2,
-    /// Test fallback to reloadData when "too many" update operations.
+    /// Fall back to reloadData when it is measured to be cheaper than batch updates. See `IGListUpdateCostModel`.
     IGListExperimentReloadDataFallback = 1 << 3,
+    /// Test replacing diff moves with the cheapest equivalent plan of moves and delete+insert pairs.
+    IGListExperimentMovePlanning = 1 << 4,
 };
 
 /**
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListDiffable.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A diagnostic snapshot of how a set of objects distributes in the symbol table used by `IGListDiff()`.
+
+ The table is keyed on `-[IGListDiffable diffIdentifier]` using `-hash` and `-isEqual:`. Poor `-hash` implementations
+ (for example XOR-ing a few small integers) put many identifiers in the same bucket and turn lookups into linear scans.
+ */
+NS_SWIFT_NAME(ListHashQualityReport)
+@interface IGListHashQualityReport : NSObject
+
+/**
+ The number of unique identifiers that were analyzed.
+ */
+@property (nonatomic, assign, readonly) NSInteger identifierCount;
+
+/**
+ The number of buckets in the table after inserting every identifier.
+ */
+@property (nonatomic, assign, readonly) NSInteger bucketCount;
+
+/**
+ The number of buckets holding at least one identifier.
+ */
+@property (nonatomic, assign, readonly) NSInteger occupiedBucketCount;
+
+/**
+ The length of the longest bucket chain. Lookups in this bucket compare against every identifier in the chain.
+ */
+@property (nonatomic, assign, readonly) NSInteger longestChainLength;
+
+/**
+ The mean chain length over occupied buckets. A well distributed table stays close to 1.
+ */
+@property (nonatomic, assign, readonly) double averageChainLength;
+
+/**
+ The number of identifiers whose `-hash` equals the hash of another identifier that is not `-isEqual:` to it.
+ */
+@property (nonatomic, assign, readonly) NSInteger hashCollisionCount;
+
+/**
+ A sample of identifier groups sharing the same `-hash` while not being equal. Capped to keep reports small.
+ */
+@property (nonatomic, copy, readonly) NSArray<NSArray<id<NSObject>> *> *collidingIdentifiers;
+
+/**
+ The classes of objects whose identifiers take part in a hash collision, most frequent first.
+ */
+@property (nonatomic, copy, readonly) NSArray<Class> *offendingClasses;
+
+/**
+ `YES` if the table has collisions or chains long enough to degrade diffing, otherwise `NO`.
+ */
+@property (nonatomic, assign, readonly, getter=isPathological) BOOL pathological;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+/**
+ Analyzes how the identifiers of a collection distribute in the diffing symbol table.
+
+ @param objects The objects to analyze. Objects with equal identifiers are counted once, as in the diff.
+
+ @return A report describing bucket distribution and identifier hash collisions.
+
+ @note This walks the collection several times and is intended for sampled diagnostics, not every update.
+ */
+NS_SWIFT_NAME(ListHashQualityAnalyze(_:))
+FOUNDATION_EXTERN IGListHashQualityReport *IGListHashQualityAnalyze(NSArray<id<IGListDiffable>> *_Nullable objects);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListHashQualityReport.h"
+
+#import <unordered_map>
+#import <vector>
+
+#import "IGListDiffInternal.h"
+
+// keep reports small enough to log
+static const NSInteger kIGListHashQualityMaxCollidingGroups = 16;
+static const NSInteger kIGListHashQualityMaxGroupSize = 8;
+
+// chains this long mean lookups for the bucket scan several identifiers with -isEqual:
+static const NSInteger kIGListHashQualityPathologicalChainLength = 8;
+
+@interface IGListHashQualityReport ()
+
+- (instancetype)initWithIdentifierCount:(NSInteger)identifierCount
+                            bucketCount:(NSInteger)bucketCount
+                    occupiedBucketCount:(NSInteger)occupiedBucketCount
+                     longestChainLength:(NSInteger)longestChainLength
+                     hashCollisionCount:(NSInteger)hashCollisionCount
+                   collidingIdentifiers:(NSArray<NSArray<id<NSObject>> *> *)collidingIdentifiers
+                       offendingClasses:(NSArray<Class> *)offendingClasses NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation IGListHashQualityReport
+
+- (instancetype)initWithIdentifierCount:(NSInteger)identifierCount
+                            bucketCount:(NSInteger)bucketCount
+                    occupiedBucketCount:(NSInteger)occupiedBucketCount
+                     longestChainLength:(NSInteger)longestChainLength
+                     hashCollisionCount:(NSInteger)hashCollisionCount
+                   collidingIdentifiers:(NSArray<NSArray<id<NSObject>> *> *)collidingIdentifiers
+                       offendingClasses:(NSArray<Class> *)offendingClasses {
+    if (self = [super init]) {
+        _identifierCount = identifierCount;
+        _bucketCount = bucketCount;
+        _occupiedBucketCount = occupiedBucketCount;
+        _longestChainLength = longestChainLength;
+        _averageChainLength = occupiedBucketCount > 0 ? (double)identifierCount / (double)occupiedBucketCount : 0.0;
+        _hashCollisionCount = hashCollisionCount;
+        _collidingIdentifiers = [collidingIdentifiers copy];
+        _offendingClasses = [offendingClasses copy];
+    }
+    return self;
+}
+
+- (BOOL)isPathological {
+    return self.hashCollisionCount > 0 || self.longestChainLength >= kIGListHashQualityPathologicalChainLength;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ %p; %zi identifiers; %zi/%zi buckets used; longest chain: %zi; collisions: %zi; offending classes: %@>",
+            NSStringFromClass(self.class), self, self.identifierCount, self.occupiedBucketCount, self.bucketCount,
+            self.longestChainLength, self.hashCollisionCount, self.offendingClasses];
+}
+
+@end
+
+IGListHashQualityReport *IGListHashQualityAnalyze(NSArray<id<IGListDiffable>> *objects) {
+    const NSInteger count = objects.count;
+
+    // mirror the symbol table built by IGListDiffing() so the bucket layout is exactly what the diff sees
+    std::unordered_map<id<NSObject>, Class, IGListHashID, IGListEqualID> table(count);
+    for (id<IGListDiffable> object in objects) {
+        table.emplace(IGListTableKey(object), [(id)object class]);
+    }
+
+    const size_t bucketCount = table.bucket_count();
+    NSInteger occupiedBucketCount = 0;
+    NSInteger longestChainLength = 0;
+    for (size_t i = 0; i < bucketCount; i++) {
+        const NSInteger chainLength = table.bucket_size(i);
+        if (chainLength > 0) {
+            occupiedBucketCount++;
+            longestChainLength = MAX(longestChainLength, chainLength);
+        }
+    }
+
+    // the table already merged equal identifiers, so any two keys sharing a full hash value are a true collision
+    std::unordered_map<size_t, std::vector<std::pair<id<NSObject>, Class>>> groups;
+    const IGListHashID hasher;
+    for (const auto &entry : table) {
+        groups[hasher(entry.first)].push_back(entry);
+    }
+
+    NSInteger hashCollisionCount = 0;
+    NSMutableArray<NSArray<id<NSObject>> *> *collidingIdentifiers = [NSMutableArray new];
+    NSCountedSet *classCounts = [NSCountedSet new];
+    for (const auto &group : groups) {
+        const auto &members = group.second;
+        if (members.size() < 2) {
+            continue;
+        }
+        hashCollisionCount += members.size();
+
+        NSMutableArray<id<NSObject>> *identifiers = [NSMutableArray new];
+        for (const auto &member : members) {
+            [classCounts addObject:member.second];
+            if (identifiers.count < kIGListHashQualityMaxGroupSize) {
+                [identifiers addObject:member.first];
+            }
+        }
+        if (collidingIdentifiers.count < kIGListHashQualityMaxCollidingGroups) {
+            [collidingIdentifiers addObject:identifiers];
+        }
+    }
+
+    NSArray<Class> *offendingClasses = [[classCounts allObjects] sortedArrayUsingComparator:^NSComparisonResult(Class a, Class b) {
+        const NSUInteger left = [classCounts countForObject:a];
+        const NSUInteger right = [classCounts countForObject:b];
+        if (left == right) {
+            return [NSStringFromClass(a) compare:NSStringFromClass(b)];
+        }
+        return left > right ? NSOrderedAscending : NSOrderedDescending;
+    }];
+
+    return [[IGListHashQualityReport alloc] initWithIdentifierCount:table.size()
+                                                        bucketCount:bucketCount
+                                                occupiedBucketCount:occupiedBucketCount
+                                                 longestChainLength:longestChainLength
+                                                 hashCollisionCount:hashCollisionCount
+                                               collidingIdentifiers:collidingIdentifiers
+                                                   offendingClasses:offendingClasses];
+}
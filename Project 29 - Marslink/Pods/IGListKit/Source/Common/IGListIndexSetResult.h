@@ -72,6 +72,39 @@ NS_SWIFT_NAME(ListIndexSetResult)
  */
 - (IGListIndexSetResult *)resultForBatchUpdates;
 
+/**
+ Composes this result with a result diffed from this result's new collection, producing the result of diffing this
+ result's old collection directly against the other result's new collection.
+
+ An object is updated if either result updated it, or if it was deleted and then inserted again.
+
+ @param result A result whose old collection is this result's new collection.
+
+ @return A result from this result's old collection to `result`'s new collection.
+
+ @note Composition is exact for collections with unique diff identifiers, which `IGListAdapter` guarantees.
+ */
+- (IGListIndexSetResult *)resultByComposingResult:(IGListIndexSetResult *)result;
+
+/**
+ Creates a result from changes that are already known, such as a change set sent by a server, so that it can be applied
+ without diffing.
+
+ @param inserts The indexes inserted into the new collection.
+ @param deletes The indexes deleted from the old collection.
+ @param updates The indexes in the old collection that need updated. Must not be deleted.
+ @param moves The moves from an index in the old collection to an index in the new collection.
+
+ @return A new result.
+
+ @note A result created this way has no identifiers, so `-oldIndexForIdentifier:` and `-newIndexForIdentifier:` return
+ `NSNotFound`. Indexes follow the rules of `-[UICollectionView performBatchUpdates:completion:]`.
+ */
+- (instancetype)initWithInserts:(NSIndexSet *)inserts
+                        deletes:(NSIndexSet *)deletes
+                        updates:(NSIndexSet *)updates
+                          moves:(NSArray<IGListMoveIndex *> *)moves;
+
 /**
  :nodoc:
  */
@@ -9,7 +9,9 @@
 
 #import "IGListIndexSetResult.h"
 #import "IGListIndexSetResultInternal.h"
+#import "IGListMoveIndexInternal.h"
 
+#import <IGListKit/IGListAssert.h>
 #import <IGListKit/IGListMoveIndex.h>
 
 @implementation IGListIndexSetResult {
@@ -34,6 +36,21 @@
     return self;
 }
 
+- (instancetype)initWithInserts:(NSIndexSet *)inserts
+                        deletes:(NSIndexSet *)deletes
+                        updates:(NSIndexSet *)updates
+                          moves:(NSArray<IGListMoveIndex *> *)moves {
+    IGParameterAssert(inserts != nil);
+    IGParameterAssert(deletes != nil);
+    IGParameterAssert(updates != nil);
+    IGParameterAssert(moves != nil);
+    return [self initWithInserts:inserts deletes:deletes updates:updates moves:moves oldIndexMap:nil newIndexMap:nil];
+}
+
+- (BOOL)hasIdentifiers {
+    return _oldIndexMap != nil;
+}
+
 - (BOOL)hasChanges {
     return self.changeCount > 0;
 }
@@ -62,13 +79,20 @@
         }
     }
 
-    // iterate all new identifiers. if its index is updated, delete from the old index and insert the new index
-    for (id<NSObject> key in [_oldIndexMap keyEnumerator]) {
-        const NSInteger index = [[_oldIndexMap objectForKey:key] integerValue];
-        if ([filteredUpdates containsIndex:index]) {
-            [deletes addIndex:index];
-            [inserts addIndex:[[_newIndexMap objectForKey:key] integerValue]];
+    if (self.hasIdentifiers) {
+        // iterate all new identifiers. if its index is updated, delete from the old index and insert the new index
+        for (id<NSObject> key in [_oldIndexMap keyEnumerator]) {
+            const NSInteger index = [[_oldIndexMap objectForKey:key] integerValue];
+            if ([filteredUpdates containsIndex:index]) {
+                [deletes addIndex:index];
+                [inserts addIndex:[[_newIndexMap objectForKey:key] integerValue]];
+            }
         }
+    } else {
+        [self enumerateNewIndexesForOldIndexes:filteredUpdates usingBlock:^(NSInteger oldIndex, NSInteger newIndex) {
+            [deletes addIndex:oldIndex];
+            [inserts addIndex:newIndex];
+        }];
     }
 
     return [[IGListIndexSetResult alloc] initWithInserts:inserts
@@ -79,6 +103,200 @@
                                              newIndexMap:_newIndexMap];
 }
 
+- (IGListIndexSetResult *)resultByComposingResult:(IGListIndexSetResult *)result {
+    IGParameterAssert(result != nil);
+    IGAssert(self.hasIdentifiers && result.hasIdentifiers, @"Only results of a diff can be composed");
+    IGAssert(_newIndexMap.count == result->_oldIndexMap.count,
+             @"Composed results must share a collection, got %zi and %zi objects", _newIndexMap.count, result->_oldIndexMap.count);
+
+    NSMapTable<id<NSObject>, NSNumber *> *oldIndexMap = _oldIndexMap;
+    NSMapTable<id<NSObject>, NSNumber *> *middleIndexMap = result->_oldIndexMap;
+    NSMapTable<id<NSObject>, NSNumber *> *newIndexMap = result->_newIndexMap;
+    const NSInteger oldCount = oldIndexMap.count;
+    const NSInteger newCount = newIndexMap.count;
+
+    // order the identifiers of both ends by index
+    NSMutableArray<id<NSObject>> *oldIdentifiers = [NSMutableArray arrayWithCapacity:oldCount];
+    NSMutableArray<id<NSObject>> *newIdentifiers = [NSMutableArray arrayWithCapacity:newCount];
+    for (NSInteger i = 0; i < oldCount; i++) {
+        [oldIdentifiers addObject:[NSNull null]];
+    }
+    for (NSInteger i = 0; i < newCount; i++) {
+        [newIdentifiers addObject:[NSNull null]];
+    }
+    for (id<NSObject> key in oldIndexMap) {
+        oldIdentifiers[[[oldIndexMap objectForKey:key] integerValue]] = key;
+    }
+    for (id<NSObject> key in newIndexMap) {
+        newIdentifiers[[[newIndexMap objectForKey:key] integerValue]] = key;
+    }
+
+    NSMutableIndexSet *inserts = [NSMutableIndexSet new];
+    NSMutableIndexSet *deletes = [NSMutableIndexSet new];
+    NSMutableIndexSet *updates = [NSMutableIndexSet new];
+    NSMutableArray<IGListMoveIndex *> *moves = [NSMutableArray new];
+
+    // track offsets from deleted items to calculate where items have moved, exactly as the diff does
+    NSInteger *deleteOffsets = (NSInteger *)calloc(MAX(oldCount, 1), sizeof(NSInteger));
+    NSInteger runningOffset = 0;
+    for (NSInteger i = 0; i < oldCount; i++) {
+        deleteOffsets[i] = runningOffset;
+        if ([newIndexMap objectForKey:oldIdentifiers[i]] == nil) {
+            [deletes addIndex:i];
+            runningOffset++;
+        }
+    }
+
+    runningOffset = 0;
+    for (NSInteger i = 0; i < newCount; i++) {
+        id<NSObject> identifier = newIdentifiers[i];
+        NSNumber *oldIndexNumber = [oldIndexMap objectForKey:identifier];
+        if (oldIndexNumber == nil) {
+            [inserts addIndex:i];
+            runningOffset++;
+            continue;
+        }
+
+        const NSInteger oldIndex = [oldIndexNumber integerValue];
+        NSNumber *middleIndex = [middleIndexMap objectForKey:identifier];
+        if ([self.updates containsIndex:oldIndex]
+            || middleIndex == nil
+            || [result.updates containsIndex:[middleIndex integerValue]]) {
+            [updates addIndex:oldIndex];
+        }
+        if (oldIndex - deleteOffsets[oldIndex] + runningOffset != i) {
+            [moves addObject:[[IGListMoveIndex alloc] initWithFrom:oldIndex to:i]];
+        }
+    }
+    free(deleteOffsets);
+
+    return [[IGListIndexSetResult alloc] initWithInserts:inserts
+                                                 deletes:deletes
+                                                 updates:updates
+                                                   moves:moves
+                                             oldIndexMap:oldIndexMap
+                                             newIndexMap:newIndexMap];
+}
+
+- (void)enumerateCommonIndexesUsingBlock:(void (^)(NSInteger, NSInteger))block {
+    IGParameterAssert(block != nil);
+    for (id<NSObject> key in [_oldIndexMap keyEnumerator]) {
+        NSNumber *newIndex = [_newIndexMap objectForKey:key];
+        if (newIndex != nil) {
+            block([[_oldIndexMap objectForKey:key] integerValue], [newIndex integerValue]);
+        }
+    }
+}
+
+- (instancetype)resultWithInserts:(NSIndexSet *)inserts
+                          deletes:(NSIndexSet *)deletes
+                            moves:(NSArray<IGListMoveIndex *> *)moves {
+    // an updated object that is now deleted and reinserted is updated by its insert
+    NSMutableIndexSet *updates = [self.updates mutableCopy];
+    [updates removeIndexes:deletes];
+    return [[IGListIndexSetResult alloc] initWithInserts:inserts
+                                                 deletes:deletes
+                                                 updates:updates
+                                                   moves:moves
+                                             oldIndexMap:_oldIndexMap
+                                             newIndexMap:_newIndexMap];
+}
+
+- (void)enumerateNewIndexesForOldIndexes:(NSIndexSet *)oldIndexes
+                             usingBlock:(void (^)(NSInteger, NSInteger))block {
+    IGParameterAssert(oldIndexes != nil);
+    IGParameterAssert(block != nil);
+    if (oldIndexes.count == 0) {
+        return;
+    }
+
+    // gathered once for every index mapped, since a delta can hold many updates and moves
+    NSIndexSet *deletes = self.deletes;
+    NSMutableIndexSet *movedFrom = [NSMutableIndexSet new];
+    NSMutableIndexSet *taken = [self.inserts mutableCopy];
+    NSMutableDictionary<NSNumber *, NSNumber *> *moveDestinations =
+    [NSMutableDictionary dictionaryWithCapacity:self.moves.count];
+    for (IGListMoveIndex *move in self.moves) {
+        [movedFrom addIndex:move.from];
+        [taken addIndex:move.to];
+        moveDestinations[@(move.from)] = @(move.to);
+    }
+
+    [oldIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        const NSInteger oldIndex = idx;
+        if ([deletes containsIndex:oldIndex]) {
+            block(oldIndex, NSNotFound);
+            return;
+        }
+        NSNumber *moveDestination = moveDestinations[@(oldIndex)];
+        if (moveDestination != nil) {
+            block(oldIndex, moveDestination.integerValue);
+            return;
+        }
+
+        // objects that stay in place keep their order and fill the new indexes that inserts and moves do not take, so
+        // find the smallest index with exactly `rank` free indexes before it
+        const NSRange before = NSMakeRange(0, oldIndex);
+        const NSInteger rank = oldIndex
+        - [deletes countOfIndexesInRange:before]
+        - [movedFrom countOfIndexesInRange:before];
+        NSInteger newIndex = rank;
+        NSInteger takenCount = [taken countOfIndexesInRange:NSMakeRange(0, newIndex + 1)];
+        while (rank + takenCount != newIndex) {
+            newIndex = rank + takenCount;
+            takenCount = [taken countOfIndexesInRange:NSMakeRange(0, newIndex + 1)];
+        }
+        block(oldIndex, newIndex);
+    }];
+}
+
+- (NSString *)failureReasonForDeltaFromCount:(NSInteger)fromCount toCount:(NSInteger)toCount {
+    NSIndexSet *inserts = self.inserts;
+    NSIndexSet *deletes = self.deletes;
+    NSIndexSet *updates = self.updates;
+
+    if (inserts.count > 0 && inserts.lastIndex >= toCount) {
+        return [NSString stringWithFormat:@"Insert at %zi is out of bounds for %zi objects", inserts.lastIndex, toCount];
+    }
+    if (deletes.count > 0 && deletes.lastIndex >= fromCount) {
+        return [NSString stringWithFormat:@"Delete at %zi is out of bounds for %zi objects", deletes.lastIndex, fromCount];
+    }
+    if (updates.count > 0 && updates.lastIndex >= fromCount) {
+        return [NSString stringWithFormat:@"Update at %zi is out of bounds for %zi objects", updates.lastIndex, fromCount];
+    }
+    __block BOOL updatesDeleted = NO;
+    [updates enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        updatesDeleted = [deletes intersectsIndexesInRange:range];
+        *stop = updatesDeleted;
+    }];
+    if (updatesDeleted) {
+        return @"Updated indexes must not also be deleted";
+    }
+
+    NSMutableIndexSet *movedFrom = [NSMutableIndexSet new];
+    NSMutableIndexSet *movedTo = [NSMutableIndexSet new];
+    for (IGListMoveIndex *move in self.moves) {
+        if (move.from < 0 || move.from >= fromCount || move.to < 0 || move.to >= toCount) {
+            return [NSString stringWithFormat:@"Move from %zi to %zi is out of bounds for %zi and %zi objects",
+                    move.from, move.to, fromCount, toCount];
+        }
+        if ([deletes containsIndex:move.from] || [movedFrom containsIndex:move.from]) {
+            return [NSString stringWithFormat:@"Index %zi is moved after being deleted or moved", move.from];
+        }
+        if ([inserts containsIndex:move.to] || [movedTo containsIndex:move.to]) {
+            return [NSString stringWithFormat:@"Index %zi is moved to after being inserted or moved to", move.to];
+        }
+        [movedFrom addIndex:move.from];
+        [movedTo addIndex:move.to];
+    }
+
+    if (fromCount - (NSInteger)deletes.count + (NSInteger)inserts.count != toCount) {
+        return [NSString stringWithFormat:@"%zi objects with %zi deletes and %zi inserts do not make %zi objects",
+                fromCount, deletes.count, inserts.count, toCount];
+    }
+    return nil;
+}
+
 - (NSInteger)oldIndexForIdentifier:(id<NSObject>)identifier {
     NSNumber *index = [_oldIndexMap objectForKey:identifier];
     return index == nil ? NSNotFound : [index integerValue];
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListIndexSetResult.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Relative costs used to choose how objects that changed position are animated.
+ */
+NS_SWIFT_NAME(ListMoveCostModel)
+typedef struct IGListMoveCostModel {
+    /// The cost of a single move.
+    double moveCost;
+    /// The additional cost of a move for each index it travels.
+    double moveDistanceCost;
+    /// The cost of deleting an object at its old index and inserting it at its new index instead of moving it.
+    double deleteInsertCost;
+} IGListMoveCostModel;
+
+/**
+ A cost model that minimizes the number of moves and never converts a move into a delete+insert pair.
+ */
+FOUNDATION_EXTERN const IGListMoveCostModel IGListMoveCostModelDefault;
+
+/**
+ Replaces the moves of a diff result with the cheapest equivalent mix of moves and delete+insert pairs.
+
+ The diff emits a move for every object whose offset index changed, so moving one object to the front of a list moves
+ every object. The planner keeps the longest ordered subsequence of common objects in place and emits each remaining
+ object as a move or as a delete+insert pair, whichever is cheaper for that object.
+
+ @param result A result returned from `IGListDiff()` or `IGListDiffExperiment()`.
+ @param costModel The relative operation costs.
+
+ @return A result with the same inserts, deletes and updates plus the planned operations, or `result` itself if its moves
+ are already the cheapest.
+ */
+NS_SWIFT_NAME(ListIndexSetResultPlanningMoves(_:costModel:))
+FOUNDATION_EXTERN IGListIndexSetResult *IGListIndexSetResultPlanningMoves(IGListIndexSetResult *result,
+                                                                          IGListMoveCostModel costModel);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListMovePlanning.h"
+
+#import <IGListKit/IGListAssert.h>
+
+#import "IGListIndexSetResultInternal.h"
+#import "IGListMoveIndexInternal.h"
+#import "IGListMovePlanner.h"
+
+using namespace IGListKit;
+
+// move, move distance, delete+insert
+const IGListMoveCostModel IGListMoveCostModelDefault = {1, 0, 2};
+
+IGListIndexSetResult *IGListIndexSetResultPlanningMoves(IGListIndexSetResult *result, IGListMoveCostModel costModel) {
+    IGParameterAssert(result != nil);
+    if (result.moves.count == 0) {
+        return result;
+    }
+
+    const IGListMovePlannerCost model = {costModel.moveCost, costModel.moveDistanceCost, costModel.deleteInsertCost};
+
+    std::vector<IGListIndexPair> common;
+    [result enumerateCommonIndexesUsingBlock:^(NSInteger oldIndex, NSInteger newIndex) {
+        common.push_back({oldIndex, newIndex});
+    }];
+
+    std::vector<IGListIndexPair> diffMoves;
+    diffMoves.reserve(result.moves.count);
+    for (IGListMoveIndex *move in result.moves) {
+        diffMoves.push_back({move.from, move.to});
+    }
+
+    const IGListMovePlan plan = IGListPlanMoves(std::move(common), model);
+    if (plan.cost >= IGListMovesCost(diffMoves, model)) {
+        return result;
+    }
+
+    NSMutableArray<IGListMoveIndex *> *moves = [NSMutableArray arrayWithCapacity:plan.moves.size()];
+    for (const auto &move : plan.moves) {
+        [moves addObject:[[IGListMoveIndex alloc] initWithFrom:(NSInteger)move.first to:(NSInteger)move.second]];
+    }
+
+    NSMutableIndexSet *deletes = [result.deletes mutableCopy];
+    NSMutableIndexSet *inserts = [result.inserts mutableCopy];
+    for (const auto &pair : plan.deleteInserts) {
+        [deletes addIndex:(NSInteger)pair.first];
+        [inserts addIndex:(NSInteger)pair.second];
+    }
+
+    return [result resultWithInserts:inserts deletes:deletes moves:moves];
+}
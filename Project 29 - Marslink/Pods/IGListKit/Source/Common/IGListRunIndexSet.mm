@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListRunIndexSet.h"
+
+#import <IGListKit/IGListAssert.h>
+
+using namespace IGListKit;
+
+@implementation IGListRunIndexSet {
+    IGListIndexRuns _runs;
+}
+
++ (instancetype)indexSetWithIndexSet:(NSIndexSet *)indexSet {
+    IGListRunIndexSet *runIndexSet = [self new];
+    [indexSet enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        runIndexSet->_runs.addRange(range.location, range.length);
+    }];
+    return runIndexSet;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    IGListRunIndexSet *copy = [[IGListRunIndexSet allocWithZone:zone] init];
+    copy->_runs = _runs;
+    return copy;
+}
+
+- (const IGListIndexRuns &)runs {
+    return _runs;
+}
+
+- (NSUInteger)count {
+    return _runs.count();
+}
+
+- (NSIndexSet *)indexSet {
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet new];
+    for (const auto &run : _runs.runs()) {
+        [indexSet addIndexesInRange:NSMakeRange(run.location, run.length)];
+    }
+    return indexSet;
+}
+
+- (BOOL)containsIndex:(NSUInteger)index {
+    return _runs.contains(index);
+}
+
+- (void)addIndex:(NSUInteger)index {
+    _runs.add(index);
+}
+
+- (void)addIndexesInRange:(NSRange)range {
+    _runs.addRange(range.location, range.length);
+}
+
+- (void)removeIndex:(NSUInteger)index {
+    _runs.remove(index);
+}
+
+- (void)removeAllIndexes {
+    _runs.clear();
+}
+
+- (void)unionIndexSet:(IGListRunIndexSet *)indexSet {
+    IGParameterAssert(indexSet != nil);
+    _runs.unionWith(indexSet->_runs);
+}
+
+- (void)enumerateIndexesUsingBlock:(void (^)(NSUInteger, BOOL *))block {
+    IGParameterAssert(block != nil);
+    BOOL stop = NO;
+    _runs.enumerate([&stop, block](size_t index) {
+        block(index, &stop);
+        return !stop;
+    });
+}
+
+- (void)enumerateRangesUsingBlock:(void (^)(NSRange, BOOL *))block {
+    IGParameterAssert(block != nil);
+    BOOL stop = NO;
+    for (const auto &run : _runs.runs()) {
+        block(NSMakeRange(run.location, run.length), &stop);
+        if (stop) {
+            break;
+        }
+    }
+}
+
+- (BOOL)isEqual:(id)object {
+    if (object == self) {
+        return YES;
+    }
+    if (![object isKindOfClass:[IGListRunIndexSet class]]) {
+        return NO;
+    }
+    return _runs == ((IGListRunIndexSet *)object)->_runs;
+}
+
+- (NSUInteger)hash {
+    // mix every run boundary so sets with the same count and run count still spread across buckets
+    NSUInteger hash = _runs.runs().size();
+    for (const auto &run : _runs.runs()) {
+        hash = hash * 31 + run.location;
+        hash = hash * 31 + run.length;
+    }
+    return hash;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ %p; %zi indexes in %zi runs>",
+            NSStringFromClass(self.class), self, (NSInteger)self.count, (NSInteger)_runs.runs().size()];
+}
+
+@end
@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListArena_h
+#define IGListArena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace IGListKit {
+
+/// Number of resets over which peak usage is tracked before the arena is allowed to shrink.
+static const size_t kIGListArenaTrimWindow = 32;
+
+/// Smallest block the arena will request from the system.
+static const size_t kIGListArenaMinimumBlockSize = 4 * 1024;
+
+/**
+ A monotonic bump allocator. Memory is handed out from retained blocks and only released on reset(), so repeated work of
+ the same shape (e.g. diffing a stream of similarly sized arrays) performs no heap allocations once warmed up.
+
+ Not thread safe. Use IGListArenaScope to borrow the arena owned by the current thread.
+ */
+class IGListArena {
+public:
+    IGListArena() : _offset(0), _used(0), _peak(0), _windowPeak(0), _resets(0), _inUse(false) {}
+
+    ~IGListArena() {
+        for (auto &block : _blocks) {
+            std::free(block.data);
+        }
+    }
+
+    IGListArena(const IGListArena &) = delete;
+    IGListArena &operator=(const IGListArena &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment) {
+        if (bytes == 0) {
+            bytes = 1;
+        }
+        if (!_blocks.empty()) {
+            Block &block = _blocks.back();
+            const size_t start = (_offset + alignment - 1) & ~(alignment - 1);
+            if (start + bytes <= block.size) {
+                _used += (start + bytes) - _offset;
+                _offset = start + bytes;
+                return block.data + start;
+            }
+        }
+        // overflow into a new block, at least doubling the capacity so a cold arena converges in a few diffs
+        const size_t size = _maxSize(bytes + alignment, _maxSize(capacity(), kIGListArenaMinimumBlockSize));
+        _pushBlock(size);
+        const size_t start = (reinterpret_cast<uintptr_t>(_blocks.back().data) % alignment) == 0
+        ? 0
+        : alignment - (reinterpret_cast<uintptr_t>(_blocks.back().data) % alignment);
+        _used += start + bytes;
+        _offset = start + bytes;
+        return _blocks.back().data + start;
+    }
+
+    /**
+     Rewinds the arena. All memory handed out since the last reset must be dead.
+
+     Blocks are retained. When a diff spilled into several blocks they are coalesced into a single block sized to the
+     high-water mark. When the arena has been much larger than its peak usage for a full trim window, it shrinks back.
+     */
+    void reset() {
+        _peak = _maxSize(_peak, _used);
+        _windowPeak = _maxSize(_windowPeak, _used);
+        _resets++;
+
+        const size_t target = _maxSize(_windowPeak, kIGListArenaMinimumBlockSize);
+        if (_blocks.size() > 1) {
+            // coalesce so the next diff of this size is served by one contiguous block
+            _releaseBlocks();
+            _pushBlock(_maxSize(_peak, kIGListArenaMinimumBlockSize));
+        } else if (_resets >= kIGListArenaTrimWindow) {
+            // trim when capacity is more than 4x what the last window needed
+            if (capacity() > 4 * target) {
+                _releaseBlocks();
+                _pushBlock(target);
+                _peak = target;
+            }
+            _resets = 0;
+            _windowPeak = 0;
+        }
+
+        _offset = 0;
+        _used = 0;
+    }
+
+    /// Total bytes retained by the arena.
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto &block : _blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    /// The largest number of bytes used between two resets.
+    size_t highWaterMark() const {
+        return _peak;
+    }
+
+    /// Used by IGListArenaScope to detect re-entrant diffs on the same thread.
+    bool inUse() const {
+        return _inUse;
+    }
+
+    void setInUse(bool inUse) {
+        _inUse = inUse;
+    }
+
+private:
+    struct Block {
+        char *data;
+        size_t size;
+    };
+
+    static size_t _maxSize(size_t a, size_t b) {
+        return a > b ? a : b;
+    }
+
+    void _pushBlock(size_t size) {
+        char *data = static_cast<char *>(std::malloc(size));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        _blocks.push_back({data, size});
+        _offset = 0;
+    }
+
+    void _releaseBlocks() {
+        for (auto &block : _blocks) {
+            std::free(block.data);
+        }
+        _blocks.clear();
+    }
+
+    std::vector<Block> _blocks;
+    size_t _offset;
+    size_t _used;
+    size_t _peak;
+    size_t _windowPeak;
+    size_t _resets;
+    bool _inUse;
+};
+
+/**
+ Returns the arena owned by the calling thread, creating it on first use. The arena is destroyed when the thread exits.
+ */
+IGListArena *IGListArenaForCurrentThread();
+
+/**
+ Borrows the current thread's arena for the lifetime of the scope and resets it on exit. If the arena is already borrowed
+ (a re-entrant diff from inside -isEqualToDiffableObject:, for example) a private arena is used instead.
+
+ Declare the scope before any container that allocates from it so the containers are destroyed first.
+ */
+class IGListArenaScope {
+public:
+    IGListArenaScope() : _arena(IGListArenaForCurrentThread()) {
+        if (_arena->inUse()) {
+            _arena = &_fallback;
+        }
+        _arena->setInUse(true);
+    }
+
+    ~IGListArenaScope() {
+        _arena->reset();
+        _arena->setInUse(false);
+    }
+
+    IGListArenaScope(const IGListArenaScope &) = delete;
+    IGListArenaScope &operator=(const IGListArenaScope &) = delete;
+
+    IGListArena *arena() const {
+        return _arena;
+    }
+
+private:
+    IGListArena *_arena;
+    IGListArena _fallback;
+};
+
+/**
+ A minimal C++11 allocator that serves memory from an IGListArena. Deallocation is a no-op; memory is reclaimed when the
+ arena is reset.
+ */
+template <typename T>
+struct IGListArenaAllocator {
+    typedef T value_type;
+
+    IGListArena *arena;
+
+    explicit IGListArenaAllocator(IGListArena *a) noexcept : arena(a) {}
+
+    template <typename U>
+    IGListArenaAllocator(const IGListArenaAllocator<U> &other) noexcept : arena(other.arena) {}
+
+    template <typename U>
+    struct rebind {
+        typedef IGListArenaAllocator<U> other;
+    };
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, size_t) noexcept {}
+};
+
+template <typename T, typename U>
+inline bool operator==(const IGListArenaAllocator<T> &a, const IGListArenaAllocator<U> &b) {
+    return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const IGListArenaAllocator<T> &a, const IGListArenaAllocator<U> &b) {
+    return a.arena != b.arena;
+}
+
+template <typename T>
+using IGListArenaVector = std::vector<T, IGListArenaAllocator<T>>;
+
+} // namespace IGListKit
+
+#endif /* IGListArena_h */
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListBatchUpdateCleanup_h
+#define IGListBatchUpdateCleanup_h
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace IGListKit {
+
+/// A dense set of section indexes, one bit per section.
+class IGListSectionBitmap {
+public:
+    void set(size_t index) {
+        const size_t word = index / 64;
+        if (word >= _words.size()) {
+            _words.resize(word + 1, 0);
+        }
+        _words[word] |= (uint64_t)1 << (index % 64);
+    }
+
+    void setRange(size_t location, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        const size_t last = location + length - 1;
+        if (last / 64 >= _words.size()) {
+            _words.resize(last / 64 + 1, 0);
+        }
+        for (size_t index = location; index <= last;) {
+            const size_t bit = index % 64;
+            const size_t span = std::min<size_t>(64 - bit, last - index + 1);
+            const uint64_t mask = span == 64 ? ~(uint64_t)0 : (((uint64_t)1 << span) - 1) << bit;
+            _words[index / 64] |= mask;
+            index += span;
+        }
+    }
+
+    bool test(size_t index) const {
+        const size_t word = index / 64;
+        return word < _words.size() && (_words[word] & ((uint64_t)1 << (index % 64))) != 0;
+    }
+
+    /// Calls `block(location, length)` for every run of set bits in ascending order.
+    template <typename F>
+    void enumerateRanges(F block) const {
+        size_t start = 0;
+        bool inRange = false;
+        const size_t count = _words.size() * 64;
+        for (size_t index = 0; index < count; index++) {
+            const uint64_t word = _words[index / 64];
+            if (!inRange && word == 0) {
+                // skip empty words
+                index += 63 - (index % 64);
+                continue;
+            }
+            const bool isSet = (word & ((uint64_t)1 << (index % 64))) != 0;
+            if (isSet && !inRange) {
+                start = index;
+                inRange = true;
+            } else if (!isSet && inRange) {
+                block(start, index - start);
+                inRange = false;
+            }
+        }
+        if (inRange) {
+            block(start, count - start);
+        }
+    }
+
+private:
+    std::vector<uint64_t> _words;
+};
+
+/// Packs an item index path into a single sortable key.
+inline uint64_t IGListPackIndexPath(int64_t section, int64_t item) {
+    assert(section >= 0 && section <= UINT32_MAX && item >= 0 && item <= UINT32_MAX);
+    return ((uint64_t)section << 32) | (uint64_t)(uint32_t)item;
+}
+
+inline size_t IGListPackedSection(uint64_t key) {
+    return (size_t)(key >> 32);
+}
+
+inline size_t IGListPackedItem(uint64_t key) {
+    return (size_t)(uint32_t)key;
+}
+
+/// An item move between two packed index paths.
+struct IGListPackedMove {
+    uint64_t from;
+    uint64_t to;
+};
+
+/**
+ The cleanup performed by IGListBatchUpdateData over flat storage.
+
+ Section sets are bitmaps and item operations are packed vectors. Outputs are positions into the input vectors, so the
+ caller can hand back its original objects without creating new ones.
+ */
+struct IGListBatchUpdateCleanup {
+    /// (from, to) of each section move.
+    typedef std::pair<size_t, size_t> SectionMove;
+
+    // inputs
+    IGListSectionBitmap insertSections;
+    IGListSectionBitmap deleteSections;
+    std::vector<SectionMove> sectionMoves;
+    std::vector<uint64_t> insertItems;
+    std::vector<uint64_t> deleteItems;
+    /// The section each item move starts from.
+    std::vector<size_t> itemMoveFromSections;
+
+    // outputs
+    /// Positions in `sectionMoves` that survive as moves.
+    std::vector<size_t> keptSectionMoves;
+    /// Positions in `insertItems` to keep.
+    std::vector<size_t> keptInsertItems;
+    /// Positions in `deleteItems` to keep, one per distinct index path.
+    std::vector<size_t> keptDeleteItems;
+    /// Positions in `itemMoveFromSections` to keep.
+    std::vector<size_t> keptItemMoves;
+
+    void run() {
+        const int32_t none = -1;
+        const size_t moveCount = sectionMoves.size();
+
+        // section index -> move position. sized to the largest section referenced by a move so lookups stay flat
+        size_t sectionCount = 0;
+        for (const auto &move : sectionMoves) {
+            sectionCount = std::max(sectionCount, std::max(move.first, move.second) + 1);
+        }
+        std::vector<int32_t> fromMove(sectionCount, none);
+        std::vector<int32_t> toMove(sectionCount, none);
+        auto lookup = [none](const std::vector<int32_t> &map, size_t section) {
+            return section < map.size() ? map[section] : none;
+        };
+
+        // if the move is already deleted or inserted, discard it because count-changing operations must match with
+        // data source changes. these maps are never mutated afterwards so every item change in a moved section is
+        // converted, not just the first one
+        std::vector<bool> dropped(moveCount, false);
+        std::vector<bool> converted(moveCount, false);
+        for (size_t i = 0; i < moveCount; i++) {
+            const SectionMove &move = sectionMoves[i];
+            if (deleteSections.test(move.first) || insertSections.test(move.second)) {
+                dropped[i] = true;
+            } else {
+                fromMove[move.first] = (int32_t)i;
+                toMove[move.second] = (int32_t)i;
+            }
+        }
+
+        // avoid a flaky UICollectionView bug when deleting from the same index path twice. sort (key, position) pairs
+        // so duplicates are adjacent, keeping the first position of each
+        std::vector<std::pair<uint64_t, size_t>> deletes(deleteItems.size());
+        for (size_t i = 0; i < deleteItems.size(); i++) {
+            deletes[i] = {deleteItems[i], i};
+        }
+        std::sort(deletes.begin(), deletes.end());
+
+        // avoids a bug where a cell is animated twice and one of the snapshot cells is never removed from the hierarchy
+        keptDeleteItems.clear();
+        keptDeleteItems.reserve(deletes.size());
+        for (size_t i = 0; i < deletes.size(); i++) {
+            if (i > 0 && deletes[i].first == deletes[i - 1].first) {
+                continue;
+            }
+            const int32_t move = lookup(fromMove, IGListPackedSection(deletes[i].first));
+            if (move != none) {
+                converted[move] = true;
+            } else {
+                keptDeleteItems.push_back(deletes[i].second);
+            }
+        }
+        std::sort(keptDeleteItems.begin(), keptDeleteItems.end());
+
+        // prevents a bug where UICollectionView corrupts the heap memory when inserting into a section that is moved
+        keptInsertItems.clear();
+        keptInsertItems.reserve(insertItems.size());
+        for (size_t i = 0; i < insertItems.size(); i++) {
+            const int32_t move = lookup(toMove, IGListPackedSection(insertItems[i]));
+            if (move != none) {
+                converted[move] = true;
+            } else {
+                keptInsertItems.push_back(i);
+            }
+        }
+
+        // if the section w/ an index path move is deleted, just drop the move. if a move is inside a section that is
+        // moved, convert the section move to a delete+insert
+        keptItemMoves.clear();
+        keptItemMoves.reserve(itemMoveFromSections.size());
+        for (size_t i = 0; i < itemMoveFromSections.size(); i++) {
+            const size_t section = itemMoveFromSections[i];
+            const int32_t move = lookup(fromMove, section);
+            if (move != none) {
+                converted[move] = true;
+            } else if (!deleteSections.test(section)) {
+                keptItemMoves.push_back(i);
+            }
+        }
+
+        // delete + insert will result in reloading the entire section
+        keptSectionMoves.clear();
+        for (size_t i = 0; i < moveCount; i++) {
+            if (converted[i]) {
+                deleteSections.set(sectionMoves[i].first);
+                insertSections.set(sectionMoves[i].second);
+            } else if (!dropped[i]) {
+                keptSectionMoves.push_back(i);
+            }
+        }
+    }
+};
+
+} // namespace IGListKit
+
+#endif /* IGListBatchUpdateCleanup_h */
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListBatchUpdateData.h>
+
+#import "IGListRunIndexSet.h"
+
+#ifdef __cplusplus
+#import <vector>
+
+#import "IGListBatchUpdateCleanup.h"
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface IGListBatchUpdateData ()
+
+- (instancetype)initWithInsertSectionRuns:(IGListRunIndexSet *)insertSections
+                        deleteSectionRuns:(IGListRunIndexSet *)deleteSections
+                             moveSections:(NSSet<IGListMoveIndex *> *)moveSections
+                         insertIndexPaths:(NSArray<NSIndexPath *> *)insertIndexPaths
+                         deleteIndexPaths:(NSArray<NSIndexPath *> *)deleteIndexPaths
+                           moveIndexPaths:(NSArray<IGListMoveIndexPath *> *)moveIndexPaths NS_DESIGNATED_INITIALIZER;
+
+#ifdef __cplusplus
+/**
+ Creates update data from packed item operations. Index path objects are only created for the operations that survive
+ cleanup.
+ */
+- (instancetype)initWithInsertSectionRuns:(IGListRunIndexSet *)insertSections
+                        deleteSectionRuns:(IGListRunIndexSet *)deleteSections
+                             moveSections:(NSSet<IGListMoveIndex *> *)moveSections
+                   packedInsertIndexPaths:(const std::vector<uint64_t> &)insertIndexPaths
+                   packedDeleteIndexPaths:(const std::vector<uint64_t> &)deleteIndexPaths
+                     packedMoveIndexPaths:(const std::vector<IGListKit::IGListPackedMove> &)moveIndexPaths NS_DESIGNATED_INITIALIZER;
+#endif
+
+@property (nonatomic, strong, readonly) IGListRunIndexSet *insertSectionRuns;
+@property (nonatomic, strong, readonly) IGListRunIndexSet *deleteSectionRuns;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,32 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListDiffable.h>
+
+/// Symbol table key functions shared by IGListDiffing() and tools that need to mirror its table exactly.
+
+static inline id<NSObject> IGListTableKey(id<IGListDiffable> object) {
+    id<NSObject> key = [object diffIdentifier];
+    NSCAssert(key != nil, @"Cannot use a nil key for the diffIdentifier of object %@", object);
+    return key;
+}
+
+struct IGListEqualID {
+    bool operator()(const id a, const id b) const {
+        return (a == b) || [a isEqual: b];
+    }
+};
+
+struct IGListHashID {
+    size_t operator()(const id o) const {
+        return (size_t)[o hash];
+    }
+};
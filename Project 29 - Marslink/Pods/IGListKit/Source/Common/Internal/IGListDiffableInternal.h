@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListDiffableInternal_h
+#define IGListDiffableInternal_h
+
+#import <IGListKit/IGListDiffable.h>
+
+/**
+ Returns YES if both objects implement the optional -[IGListDiffable diffVersion].
+ */
+static inline BOOL IGListDiffableHasVersions(id<IGListDiffable> a, id<IGListDiffable> b) {
+    return [(id)a respondsToSelector:@selector(diffVersion)] && [(id)b respondsToSelector:@selector(diffVersion)];
+}
+
+/**
+ Compares two objects sharing a diff identifier. Versioned objects are compared with an integer compare, all others fall
+ back to -[IGListDiffable isEqualToDiffableObject:].
+ */
+static inline BOOL IGListDiffableIsEqual(id<IGListDiffable> a, id<IGListDiffable> b) {
+    if (a == b) {
+        return YES;
+    }
+    if (IGListDiffableHasVersions(a, b)) {
+        return [a diffVersion] == [b diffVersion];
+    }
+    return [a isEqualToDiffableObject:b];
+}
+
+#endif /* IGListDiffableInternal_h */
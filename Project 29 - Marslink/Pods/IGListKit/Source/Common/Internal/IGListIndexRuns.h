@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListIndexRuns_h
+#define IGListIndexRuns_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace IGListKit {
+
+/**
+ A run-length encoded set of indexes. Runs are sorted, non-empty, and never overlap or touch, so every set has exactly one
+ representation and set operations are linear in the number of runs rather than the number of indexes.
+ */
+class IGListIndexRuns {
+public:
+    struct Run {
+        size_t location;
+        size_t length;
+
+        size_t end() const {
+            return location + length;
+        }
+
+        bool operator==(const Run &other) const {
+            return location == other.location && length == other.length;
+        }
+    };
+
+    IGListIndexRuns() {}
+
+    const std::vector<Run> &runs() const {
+        return _runs;
+    }
+
+    bool empty() const {
+        return _runs.empty();
+    }
+
+    /// Removes every index, keeping the storage.
+    void clear() {
+        _runs.clear();
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (const auto &run : _runs) {
+            total += run.length;
+        }
+        return total;
+    }
+
+    bool operator==(const IGListIndexRuns &other) const {
+        return _runs == other._runs;
+    }
+
+    bool contains(size_t index) const {
+        // first run starting after index, the candidate is the one before it
+        auto it = std::upper_bound(_runs.begin(), _runs.end(), index, [](size_t value, const Run &run) {
+            return value < run.location;
+        });
+        return it != _runs.begin() && index < (it - 1)->end();
+    }
+
+    void add(size_t index) {
+        addRange(index, 1);
+    }
+
+    void addRange(size_t location, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        size_t start = location;
+        size_t end = location + length;
+
+        // every run touching [start, end] is absorbed into one run
+        auto first = std::lower_bound(_runs.begin(), _runs.end(), start, [](const Run &run, size_t value) {
+            return run.end() < value;
+        });
+        auto last = first;
+        while (last != _runs.end() && last->location <= end) {
+            start = std::min(start, last->location);
+            end = std::max(end, last->end());
+            ++last;
+        }
+        first = _runs.erase(first, last);
+        _runs.insert(first, Run{start, end - start});
+    }
+
+    void remove(size_t index) {
+        removeRange(index, 1);
+    }
+
+    void removeRange(size_t location, size_t length) {
+        if (length == 0 || _runs.empty()) {
+            return;
+        }
+        IGListIndexRuns removed;
+        removed._runs.push_back(Run{location, length});
+        subtract(removed);
+    }
+
+    /// Adds every index of `other`. O(runs).
+    void unionWith(const IGListIndexRuns &other) {
+        if (other._runs.empty()) {
+            return;
+        }
+        std::vector<Run> merged;
+        merged.reserve(_runs.size() + other._runs.size());
+        auto a = _runs.begin();
+        auto b = other._runs.begin();
+        while (a != _runs.end() || b != other._runs.end()) {
+            const Run &next = (b == other._runs.end() || (a != _runs.end() && a->location <= b->location)) ? *a++ : *b++;
+            if (!merged.empty() && next.location <= merged.back().end()) {
+                merged.back().length = std::max(merged.back().end(), next.end()) - merged.back().location;
+            } else {
+                merged.push_back(next);
+            }
+        }
+        _runs.swap(merged);
+    }
+
+    /// Removes every index of `other`. O(runs).
+    void subtract(const IGListIndexRuns &other) {
+        if (other._runs.empty() || _runs.empty()) {
+            return;
+        }
+        std::vector<Run> result;
+        result.reserve(_runs.size() + other._runs.size());
+        auto b = other._runs.begin();
+        for (const Run &run : _runs) {
+            size_t start = run.location;
+            const size_t end = run.end();
+            // skip holes entirely before this run
+            while (b != other._runs.end() && b->end() <= start) {
+                ++b;
+            }
+            auto hole = b;
+            while (start < end && hole != other._runs.end() && hole->location < end) {
+                if (hole->location > start) {
+                    result.push_back(Run{start, hole->location - start});
+                }
+                start = std::max(start, hole->end());
+                if (hole->end() <= end) {
+                    ++hole;
+                } else {
+                    break;
+                }
+            }
+            if (start < end) {
+                result.push_back(Run{start, end - start});
+            }
+            b = hole;
+        }
+        _runs.swap(result);
+    }
+
+    /// Calls `block(index)` for every index in ascending order until it returns `false`.
+    template <typename F>
+    void enumerate(F block) const {
+        for (const auto &run : _runs) {
+            for (size_t index = run.location; index < run.end(); index++) {
+                if (!block(index)) {
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<Run> _runs;
+};
+
+} // namespace IGListKit
+
+#endif /* IGListIndexRuns_h */
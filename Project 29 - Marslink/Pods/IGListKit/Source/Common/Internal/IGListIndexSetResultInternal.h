@@ -24,6 +24,22 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, assign, readonly) NSInteger changeCount;
 
+// NO for results created from known changes rather than by a diff
+@property (nonatomic, assign, readonly) BOOL hasIdentifiers;
+
+// where the objects at old indexes end up, computed from the changes alone. NSNotFound for deleted objects
+- (void)enumerateNewIndexesForOldIndexes:(NSIndexSet *)oldIndexes
+                             usingBlock:(void (^)(NSInteger oldIndex, NSInteger newIndex))block;
+
+// nil if the changes can be applied to a collection of fromCount objects to produce one of toCount objects
+- (nullable NSString *)failureReasonForDeltaFromCount:(NSInteger)fromCount toCount:(NSInteger)toCount;
+
+- (void)enumerateCommonIndexesUsingBlock:(void (^)(NSInteger oldIndex, NSInteger newIndex))block;
+
+- (instancetype)resultWithInserts:(NSIndexSet *)inserts
+                          deletes:(NSIndexSet *)deletes
+                            moves:(NSArray<IGListMoveIndex *> *)moves;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListKeyDiff_h
+#define IGListKeyDiff_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "IGListArena.h"
+
+namespace IGListKit {
+
+/// Marks a missing index in the key diff, the equivalent of NSNotFound.
+static const size_t kIGListKeyNotFound = SIZE_MAX;
+
+/// Output of IGListKeyDiffing(). Every vector is served from the arena passed to the diff.
+struct IGListKeyDiffOutput {
+    explicit IGListKeyDiffOutput(IGListArena *arena)
+    : inserts(IGListArenaAllocator<size_t>(arena)),
+    deletes(IGListArenaAllocator<size_t>(arena)),
+    updates(IGListArenaAllocator<size_t>(arena)),
+    moves(IGListArenaAllocator<std::pair<size_t, size_t>>(arena)),
+    oldToNew(IGListArenaAllocator<size_t>(arena)),
+    newToOld(IGListArenaAllocator<size_t>(arena)) {}
+
+    /// Indexes inserted into the new collection.
+    IGListArenaVector<size_t> inserts;
+    /// Indexes deleted from the old collection.
+    IGListArenaVector<size_t> deletes;
+    /// Indexes in the old collection whose version changed.
+    IGListArenaVector<size_t> updates;
+    /// (old index, new index) of every move.
+    IGListArenaVector<std::pair<size_t, size_t>> moves;
+    /// The new index of each old key, or kIGListKeyNotFound when deleted.
+    IGListArenaVector<size_t> oldToNew;
+    /// The old index of each new key, or kIGListKeyNotFound when inserted.
+    IGListArenaVector<size_t> newToOld;
+};
+
+/**
+ The IGListDiffing() algorithm over raw 64-bit keys. Equal keys identify the same object, and when both version arrays
+ are provided an object is updated if its versions differ. Without versions no updates are reported.
+
+ Duplicate keys are handled exactly like duplicate diff identifiers: the first occurrences in each collection are
+ paired, and extra occurrences are inserted or deleted.
+ */
+inline void IGListKeyDiffing(const uint64_t *oldKeys,
+                             size_t oldCount,
+                             const uint64_t *newKeys,
+                             size_t newCount,
+                             const uint64_t *oldVersions,
+                             const uint64_t *newVersions,
+                             IGListArena *arena,
+                             IGListKeyDiffOutput &output) {
+    struct Entry {
+        size_t oldCounter = 0;
+        size_t newCounter = 0;
+        /// Top of the stack of old indexes in `nodes`, or kIGListKeyNotFound when empty
+        size_t oldIndexes = kIGListKeyNotFound;
+        bool updated = false;
+    };
+    struct Node {
+        size_t index;
+        size_t next;
+    };
+
+    typedef IGListArenaAllocator<std::pair<const uint64_t, Entry>> TableAllocator;
+    std::unordered_map<uint64_t, Entry, std::hash<uint64_t>, std::equal_to<uint64_t>, TableAllocator> table(
+        oldCount + newCount, std::hash<uint64_t>(), std::equal_to<uint64_t>(), TableAllocator(arena));
+
+    IGListArenaVector<Node> nodes{IGListArenaAllocator<Node>(arena)};
+    nodes.reserve(oldCount + newCount);
+    auto push = [&nodes](Entry &entry, size_t index) {
+        nodes.push_back({index, entry.oldIndexes});
+        entry.oldIndexes = nodes.size() - 1;
+    };
+
+    // pass 1, every new key
+    IGListArenaVector<Entry *> newEntries(newCount, nullptr, IGListArenaAllocator<Entry *>(arena));
+    for (size_t i = 0; i < newCount; i++) {
+        Entry &entry = table[newKeys[i]];
+        entry.newCounter++;
+        push(entry, kIGListKeyNotFound);
+        newEntries[i] = &entry;
+    }
+
+    // pass 2, every old key in descending order so the stacks pop in ascending order
+    IGListArenaVector<Entry *> oldEntries(oldCount, nullptr, IGListArenaAllocator<Entry *>(arena));
+    for (size_t i = oldCount; i-- > 0;) {
+        Entry &entry = table[oldKeys[i]];
+        entry.oldCounter++;
+        push(entry, i);
+        oldEntries[i] = &entry;
+    }
+
+    // pass 3, pair keys present in both collections
+    const bool versioned = oldVersions != nullptr && newVersions != nullptr;
+    output.oldToNew.assign(oldCount, kIGListKeyNotFound);
+    output.newToOld.assign(newCount, kIGListKeyNotFound);
+    for (size_t i = 0; i < newCount; i++) {
+        Entry *entry = newEntries[i];
+        const Node &top = nodes[entry->oldIndexes];
+        const size_t originalIndex = top.index;
+        entry->oldIndexes = top.next;
+
+        if (originalIndex != kIGListKeyNotFound) {
+            if (versioned && oldVersions[originalIndex] != newVersions[i]) {
+                entry->updated = true;
+            }
+            if (entry->newCounter > 0 && entry->oldCounter > 0) {
+                output.newToOld[i] = originalIndex;
+                output.oldToNew[originalIndex] = i;
+            }
+        }
+    }
+
+    // pass 4, deletes with running offsets
+    IGListArenaVector<size_t> deleteOffsets(oldCount, 0, IGListArenaAllocator<size_t>(arena));
+    size_t runningOffset = 0;
+    for (size_t i = 0; i < oldCount; i++) {
+        deleteOffsets[i] = runningOffset;
+        if (output.oldToNew[i] == kIGListKeyNotFound) {
+            output.deletes.push_back(i);
+            runningOffset++;
+        }
+    }
+
+    // pass 5, inserts, updates and moves
+    runningOffset = 0;
+    for (size_t i = 0; i < newCount; i++) {
+        const size_t oldIndex = output.newToOld[i];
+        if (oldIndex == kIGListKeyNotFound) {
+            output.inserts.push_back(i);
+            runningOffset++;
+        } else {
+            if (newEntries[i]->updated) {
+                output.updates.push_back(oldIndex);
+            }
+            if (oldIndex - deleteOffsets[oldIndex] + runningOffset != i) {
+                output.moves.push_back({oldIndex, i});
+            }
+        }
+    }
+
+    // updates were collected in new order, report them in old order like the index set result
+    std::sort(output.updates.begin(), output.updates.end());
+}
+
+} // namespace IGListKit
+
+#endif /* IGListKeyDiff_h */
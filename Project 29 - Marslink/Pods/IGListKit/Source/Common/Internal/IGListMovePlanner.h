@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListMovePlanner_h
+#define IGListMovePlanner_h
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace IGListKit {
+
+/// An (old index, new index) pair for an object present in both collections.
+typedef std::pair<int64_t, int64_t> IGListIndexPair;
+
+/// Relative cost of the operations a move can be expressed with.
+struct IGListMovePlannerCost {
+    /// Cost of a single -[UICollectionView moveSection:toSection:].
+    double move;
+    /// Additional cost of a move per index of displacement.
+    double moveDistance;
+    /// Cost of deleting the old index and inserting the new index instead of moving.
+    double deleteInsert;
+};
+
+/// A set of operations that, applied together, produce the same ordering as the diff.
+struct IGListMovePlan {
+    /// Moves to emit.
+    std::vector<IGListIndexPair> moves;
+    /// Moves expressed as a delete of the old index plus an insert of the new index.
+    std::vector<IGListIndexPair> deleteInserts;
+    /// The total cost of the plan under the model it was built with.
+    double cost = 0;
+};
+
+inline double IGListMoveCost(const IGListMovePlannerCost &model, const IGListIndexPair &move) {
+    return model.move + model.moveDistance * (double)std::llabs(move.second - move.first);
+}
+
+/**
+ Plans the cheapest mix of moves and delete+insert pairs that relocates the given common objects.
+
+ Objects on a longest increasing subsequence of old indexes (taken in new order) stay put; UICollectionView shifts them
+ implicitly around deletes, inserts and moved objects. Every other object is relocated, and each one is emitted as a move
+ or as a delete+insert pair, whichever is cheaper for the distance it travels.
+
+ @param common Every object present in both collections as (old index, new index), in any order.
+ @param model The relative operation costs.
+
+ @return A plan whose operations produce the same final ordering as any valid move set for `common`.
+ */
+inline IGListMovePlan IGListPlanMoves(std::vector<IGListIndexPair> common, const IGListMovePlannerCost &model) {
+    IGListMovePlan plan;
+    const size_t count = common.size();
+    if (count == 0) {
+        return plan;
+    }
+
+    // walk in new order
+    std::sort(common.begin(), common.end(), [](const IGListIndexPair &a, const IGListIndexPair &b) {
+        return a.second < b.second;
+    });
+
+    // longest increasing subsequence of old indexes in new order, O(n log n) patience sort with back pointers
+    std::vector<size_t> tails;
+    std::vector<int64_t> predecessors(count, -1);
+    for (size_t i = 0; i < count; i++) {
+        const int64_t value = common[i].first;
+        auto it = std::lower_bound(tails.begin(), tails.end(), value, [&common](size_t index, int64_t v) {
+            return common[index].first < v;
+        });
+        const size_t position = it - tails.begin();
+        predecessors[i] = position > 0 ? (int64_t)tails[position - 1] : -1;
+        if (it == tails.end()) {
+            tails.push_back(i);
+        } else {
+            *it = i;
+        }
+    }
+    std::vector<bool> stationary(count, false);
+    for (int64_t i = tails.empty() ? -1 : (int64_t)tails.back(); i >= 0; i = predecessors[i]) {
+        stationary[i] = true;
+    }
+
+    // every relocated object is priced on its own since the cost of a move depends on how far that object travels
+    for (size_t i = 0; i < count; i++) {
+        if (stationary[i]) {
+            continue;
+        }
+        const double moveCost = IGListMoveCost(model, common[i]);
+        if (model.deleteInsert < moveCost) {
+            plan.deleteInserts.push_back(common[i]);
+            plan.cost += model.deleteInsert;
+        } else {
+            plan.moves.push_back(common[i]);
+            plan.cost += moveCost;
+        }
+    }
+
+    return plan;
+}
+
+/// Prices an existing move set, e.g. the raw moves from a diff, under a cost model.
+inline double IGListMovesCost(const std::vector<IGListIndexPair> &moves, const IGListMovePlannerCost &model) {
+    double cost = 0;
+    for (const auto &move : moves) {
+        cost += IGListMoveCost(model, move);
+    }
+    return cost;
+}
+
+} // namespace IGListKit
+
+#endif /* IGListMovePlanner_h */
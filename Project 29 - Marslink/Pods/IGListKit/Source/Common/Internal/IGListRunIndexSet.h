@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+
+#ifdef __cplusplus
+#import "IGListIndexRuns.h"
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A mutable run-length encoded index set used to carry section indexes through the update pipeline. Adding ranges and
+ unions are linear in the number of runs. Bridge to `NSIndexSet` only when handing indexes to UIKit.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListRunIndexSet : NSObject <NSCopying>
+
+/**
+ Creates a set with the indexes of an index set.
+
+ @param indexSet The indexes to copy, or `nil` for an empty set.
+
+ @return A new set.
+ */
++ (instancetype)indexSetWithIndexSet:(nullable NSIndexSet *)indexSet;
+
+/**
+ The number of indexes in the set.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ The indexes as an `NSIndexSet`, built from the runs on each call.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *indexSet;
+
+- (BOOL)containsIndex:(NSUInteger)index;
+
+- (void)addIndex:(NSUInteger)index;
+
+- (void)addIndexesInRange:(NSRange)range;
+
+- (void)removeIndex:(NSUInteger)index;
+
+- (void)removeAllIndexes;
+
+- (void)unionIndexSet:(IGListRunIndexSet *)indexSet;
+
+- (void)enumerateIndexesUsingBlock:(void (^)(NSUInteger index, BOOL *stop))block;
+
+- (void)enumerateRangesUsingBlock:(void (^)(NSRange range, BOOL *stop))block;
+
+#ifdef __cplusplus
+/**
+ The underlying runs, for C++ callers.
+ */
+- (const IGListKit::IGListIndexRuns &)runs;
+#endif
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -18,6 +18,7 @@
 
 @protocol IGListUpdatingDelegate;
 
+@class IGListIndexSetResult;
 @class IGListSectionController;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -86,6 +87,32 @@ NS_SWIFT_NAME(ListAdapter)
  */
 @property (nonatomic, assign) IGListExperiment experiments;
 
+/**
+ A flag indicating if section controllers that leave the list are kept and handed to new objects instead of asking the
+ data source for new ones. The default value is `NO`.
+
+ @note Reuse requires the data source to implement `-listAdapter:sectionControllerClassForObject:`. Section controllers
+ are sent `-prepareForReuse` once the update that removed them completes. Disabling reuse or changing the data source
+ releases the kept section controllers.
+ */
+@property (nonatomic, assign) BOOL reusesSectionControllers;
+
+/**
+ A flag indicating if section controllers are created only when their section is first used, instead of for every
+ object on each update. The default value is `NO`.
+
+ @note Until its section controller is created, a section reports its number of items from
+ `-listAdapter:numberOfItemsForObject:`. Without that method, sections whose data source implements
+ `-listAdapter:sectionControllerClassForObject:` report the number of items the first new section controller of the same
+ class had after `-didUpdateToObject:`. A section whose own section controller turns out to differ is reloaded with the
+ next batch update. Otherwise the section controller is created to count its items.
+
+ Section controllers are created when they are looked up, including by the collection view asking for sizes or cells,
+ so layouts that measure every item up front create all of them. The data source must return a section controller for
+ every object.
+ */
+@property (nonatomic, assign) BOOL createsSectionControllersLazily;
+
 /**
  Initializes a new `IGListAdapter` object.
 
@@ -126,6 +153,25 @@ NS_SWIFT_NAME(ListAdapter)
  */
 - (void)performUpdatesAnimated:(BOOL)animated completion:(nullable IGListUpdaterCompletion)completion;
 
+/**
+ Perform an update to new objects whose changes are already known, without diffing them.
+
+ @param delta The changes from the objects of the last update to `objects`, from `IGListDiff()` or created with
+ `-[IGListIndexSetResult initWithInserts:deletes:updates:moves:]`.
+ @param objects The new objects. The data source must return these objects from now on.
+ @param animated A flag indicating if the transition should be animated.
+ @param completion The block to execute when the updates complete.
+
+ @note Only inserted objects get new section controllers, and only inserted and updated objects are sent
+ `-didUpdateToObject:`. If the delta is merged with other queued updates, it is composed with theirs when all of them
+ come from `IGListDiff()`. Otherwise, or if the updater does not support deltas, the objects are diffed as in
+ `-performUpdatesAnimated:completion:`.
+ */
+- (void)performUpdatesWithDelta:(IGListIndexSetResult *)delta
+                        objects:(NSArray *)objects
+                       animated:(BOOL)animated
+                     completion:(nullable IGListUpdaterCompletion)completion;
+
 /**
  Perform an immediate reload of the data in the data source, discarding the old objects.
 
@@ -15,11 +15,26 @@
 
 #import "IGListSectionControllerInternal.h"
 #import "IGListDebugger.h"
+#import "IGListIndexSetResultInternal.h"
+#import "IGListSectionControllerReusePool.h"
+#import "IGListTracing.h"
+
+// section controllers kept for each class when reusing them
+static const NSInteger kIGListReusableSectionControllersPerClass = 32;
 
 @implementation IGListAdapter {
     NSMapTable<UICollectionReusableView *, IGListSectionController *> *_viewSectionControllerMap;
     // An array of blocks to execute once batch updates are finished
     NSMutableArray<void (^)()> *_queuedCompletionBlocks;
+
+    IGListSectionControllerReusePool *_reusePool;
+    // section controllers that may have left the section map, kept out of the pool until their update completes
+    NSHashTable<IGListSectionController *> *_departedSectionControllers;
+
+    // the item count new section controllers of each class start with, see -numberOfItemsInSection:
+    NSMapTable<Class, NSNumber *> *_placeholderItemCounts;
+    // the objects of placeholders that were counted with _placeholderItemCounts, and the count they were given
+    NSMapTable<id, NSNumber *> *_placeholderCountedObjects;
 }
 
 - (void)dealloc {
@@ -44,9 +59,7 @@
 
     if (self = [super init]) {
         NSPointerFunctions *keyFunctions = [updater objectLookupPointerFunctions];
-        NSPointerFunctions *valueFunctions = [NSPointerFunctions pointerFunctionsWithOptions:NSPointerFunctionsStrongMemory];
-        NSMapTable *table = [[NSMapTable alloc] initWithKeyPointerFunctions:keyFunctions valuePointerFunctions:valueFunctions capacity:0];
-        _sectionMap = [[IGListSectionMap alloc] initWithMapTable:table];
+        _sectionMap = [[IGListSectionMap alloc] initWithKeyPointerFunctions:keyFunctions];
 
         _displayHandler = [IGListDisplayHandler new];
         _workingRangeHandler = [[IGListWorkingRangeHandler alloc] initWithWorkingRangeSize:workingRangeSize];
@@ -113,6 +126,9 @@
 - (void)setDataSource:(id<IGListAdapterDataSource>)dataSource {
     if (_dataSource != dataSource) {
         _dataSource = dataSource;
+        _placeholderItemCounts = nil;
+        _placeholderCountedObjects = nil;
+        [self removeReusableSectionControllers];
         [self updateAfterPublicSettingsChange];
     }
 }
@@ -138,6 +154,15 @@
     }
 }
 
+- (void)setReusesSectionControllers:(BOOL)reusesSectionControllers {
+    IGAssertMainThread();
+
+    if (_reusesSectionControllers != reusesSectionControllers) {
+        _reusesSectionControllers = reusesSectionControllers;
+        [self removeReusableSectionControllers];
+    }
+}
+
 - (void)updateAfterPublicSettingsChange {
     id<IGListAdapterDataSource> dataSource = _dataSource;
     if (_collectionView != nil && dataSource != nil) {
@@ -316,32 +341,97 @@
         return;
     }
 
-    NSArray *fromObjects = self.sectionMap.objects;
+    const uint64_t objectsTrace = IGListTraceBegin();
     NSArray *newObjects = [dataSource objectsForListAdapter:self];
+    IGListTraceEnd(objectsTrace, "objectsForListAdapter", newObjects.count);
+
+    [self performUpdatesToObjects:newObjects
+                            delta:nil
+                         animated:animated
+                       dataSource:dataSource
+                   collectionView:collectionView
+                       completion:completion];
+}
+
+- (void)performUpdatesWithDelta:(IGListIndexSetResult *)delta
+                        objects:(NSArray *)objects
+                       animated:(BOOL)animated
+                     completion:(IGListUpdaterCompletion)completion {
+    IGAssertMainThread();
+    IGParameterAssert(delta != nil);
+    IGParameterAssert(objects != nil);
+
+    id<IGListAdapterDataSource> dataSource = self.dataSource;
+    UICollectionView *collectionView = self.collectionView;
+    if (dataSource == nil || collectionView == nil) {
+        IGLKLog(@"Warning: Your call to %s is ignored as dataSource or collectionView haven't been set.", __PRETTY_FUNCTION__);
+        if (completion) {
+            completion(NO);
+        }
+        return;
+    }
+
+    [self performUpdatesToObjects:objects
+                            delta:delta
+                         animated:animated
+                       dataSource:dataSource
+                   collectionView:collectionView
+                       completion:completion];
+}
+
+// prefers the updater's delta method even without a delta, so the section map can be patched with the diff it applies
+- (void)performUpdatesToObjects:(NSArray *)objects
+                          delta:(nullable IGListIndexSetResult *)delta
+                       animated:(BOOL)animated
+                     dataSource:(id<IGListAdapterDataSource>)dataSource
+                 collectionView:(UICollectionView *)collectionView
+                     completion:(nullable IGListUpdaterCompletion)completion {
+    NSArray *fromObjects = self.sectionMap.objects;
 
     [self enterBatchUpdates];
 
     __weak __typeof__(self) weakSelf = self;
-    [self.updater performUpdateWithCollectionView:collectionView
-                                      fromObjects:fromObjects
-                                        toObjects:newObjects
-                                         animated:animated
-                            objectTransitionBlock:^(NSArray *toObjects) {
-                                // temporarily capture the item map that we are transitioning from in case
-                                // there are any item deletes at the same
-                                weakSelf.previousSectionMap = [weakSelf.sectionMap copy];
-
-                                [weakSelf updateObjects:toObjects dataSource:dataSource];
-                            } completion:^(BOOL finished) {
-                                // release the previous items
-                                weakSelf.previousSectionMap = nil;
+    IGListObjectDeltaTransitionBlock objectTransitionBlock = ^(NSArray *toObjects, IGListIndexSetResult *appliedDelta) {
+        // temporarily capture the item map that we are transitioning from in case
+        // there are any item deletes at the same
+        weakSelf.previousSectionMap = [weakSelf.sectionMap copy];
+
+        if (appliedDelta != nil) {
+            [weakSelf updateObjects:toObjects delta:appliedDelta dataSource:dataSource];
+        } else {
+            [weakSelf updateObjects:toObjects dataSource:dataSource];
+        }
+    };
+    IGListUpdatingCompletion updateCompletion = ^(BOOL finished) {
+        // release the previous items
+        weakSelf.previousSectionMap = nil;
+        [weakSelf recycleDepartedSectionControllers];
 
-                                if (completion) {
-                                    completion(finished);
-                                }
+        if (completion) {
+            completion(finished);
+        }
 
-                                [weakSelf exitBatchUpdates];
-                            }];
+        [weakSelf exitBatchUpdates];
+    };
+
+    id<IGListUpdatingDelegate> updater = self.updater;
+    if ([updater respondsToSelector:@selector(performUpdateWithCollectionView:fromObjects:toObjects:delta:animated:objectTransitionBlock:completion:)]) {
+        [updater performUpdateWithCollectionView:collectionView
+                                     fromObjects:fromObjects
+                                       toObjects:objects
+                                           delta:delta
+                                        animated:animated
+                           objectTransitionBlock:objectTransitionBlock
+                                      completion:updateCompletion];
+    } else {
+        [updater performUpdateWithCollectionView:collectionView
+                                     fromObjects:fromObjects
+                                       toObjects:objects
+                                        animated:animated
+                           objectTransitionBlock:^(NSArray *toObjects) {
+                               objectTransitionBlock(toObjects, nil);
+                           } completion:updateCompletion];
+    }
 }
 
 - (void)reloadDataWithCompletion:(nullable IGListUpdaterCompletion)completion {
@@ -357,14 +447,26 @@
         return;
     }
 
+    const uint64_t objectsTrace = IGListTraceBegin();
     NSArray *newItems = [[dataSource objectsForListAdapter:self] copy];
+    IGListTraceEnd(objectsTrace, "objectsForListAdapter", newItems.count);
 
     __weak __typeof__(self) weakSelf = self;
     [self.updater reloadDataWithCollectionView:collectionView reloadUpdateBlock:^{
+        NSArray<IGListSectionController *> *sectionControllers = [weakSelf reuseCandidatesInSections:nil];
+
         // purge all section controllers from the item map so that they are regenerated
         [weakSelf.sectionMap reset];
         [weakSelf updateObjects:newItems dataSource:dataSource];
-    } completion:completion];
+
+        [weakSelf addDepartedSectionControllers:sectionControllers];
+    } completion:^(BOOL finished) {
+        [weakSelf recycleDepartedSectionControllers];
+
+        if (completion) {
+            completion(finished);
+        }
+    }];
 }
 
 - (void)reloadObjects:(NSArray *)objects {
@@ -403,8 +505,9 @@
 
 - (nullable IGListSectionController *)sectionControllerForSection:(NSInteger)section {
     IGAssertMainThread();
-    
-    return [self.sectionMap sectionControllerForSection:section];
+
+    IGListSectionController *sectionController = [self.sectionMap sectionControllerForSection:section];
+    return sectionController ?: [self createSectionControllerForPlaceholderAtSection:section];
 }
 
 - (NSInteger)sectionForSectionController:(IGListSectionController *)sectionController {
@@ -418,7 +521,8 @@
     IGAssertMainThread();
     IGParameterAssert(object != nil);
 
-    return [self.sectionMap sectionControllerForObject:object];
+    const NSInteger section = [self.sectionMap sectionForObject:object];
+    return section != NSNotFound ? [self sectionControllerForSection:section] : nil;
 }
 
 - (id)objectForSectionController:(IGListSectionController *)sectionController {
@@ -535,6 +639,8 @@
 - (void)updateObjects:(NSArray *)objects dataSource:(id<IGListAdapterDataSource>)dataSource {
     IGParameterAssert(dataSource != nil);
 
+    const uint64_t trace = IGListTraceBegin();
+
 #if DEBUG
     NSCountedSet *identifiersSet = [NSCountedSet new];
     for (id object in objects) {
@@ -544,24 +650,43 @@
     }
 #endif
 
-    NSMutableArray<IGListSectionController *> *sectionControllers = [NSMutableArray new];
+    // section controllers, or NSNull for sections whose section controller is created lazily
+    NSMutableArray *sectionControllers = [NSMutableArray new];
     NSMutableArray *validObjects = [NSMutableArray new];
 
     IGListSectionMap *map = self.sectionMap;
+    const BOOL createsSectionControllersLazily = self.createsSectionControllersLazily;
 
     // collect items that have changed since the last update
     NSMutableSet *updatedObjects = [NSMutableSet new];
 
-    // push the view controller and collection context into a local thread container so they are available on init
-    // for IGListSectionController subclasses after calling [super init]
-    IGListSectionControllerPushThread(self.viewController, self);
+    NSArray<IGListSectionController *> *previousSectionControllers = [self reuseCandidatesInSections:nil];
+    BOOL pushedThread = NO;
 
     for (id object in objects) {
         // infra checks to see if a controller exists
-        IGListSectionController *sectionController = [map sectionControllerForObject:object];
+        const NSInteger previousSection = [map sectionForObject:object];
+        IGListSectionController *sectionController = previousSection != NSNotFound
+        ? [map sectionControllerForSection:previousSection] : nil;
+
+        // placeholders stay placeholders, and new objects get one when section controllers are created lazily
+        if (sectionController == nil && (previousSection != NSNotFound || createsSectionControllersLazily)) {
+            [sectionControllers addObject:[NSNull null]];
+            [validObjects addObject:object];
+            continue;
+        }
 
-        // if not, query the data source for a new one
+        // if not, hand out one that left the list or query the data source for a new one
         if (sectionController == nil) {
+            sectionController = [self reusableSectionControllerForObject:object dataSource:dataSource];
+        }
+        if (sectionController == nil) {
+            // push the view controller and collection context into a local thread container so they are available on
+            // init for IGListSectionController subclasses after calling [super init]
+            if (!pushedThread) {
+                IGListSectionControllerPushThread(self.viewController, self);
+                pushedThread = YES;
+            }
             sectionController = [dataSource listAdapter:self sectionControllerForObject:object];
         }
 
@@ -576,8 +701,7 @@
         sectionController.viewController = self.viewController;
 
         // check if the item has changed instances or is new
-        const NSInteger oldSection = [map sectionForObject:object];
-        if (oldSection == NSNotFound || [map objectForSection:oldSection] != object) {
+        if ([map isObjectUpdated:object]) {
             [updatedObjects addObject:object];
         }
 
@@ -591,21 +715,229 @@
     }
 
     // clear the view controller and collection context
-    IGListSectionControllerPopThread();
+    if (pushedThread) {
+        IGListSectionControllerPopThread();
+    }
 
     [map updateWithObjects:validObjects sectionControllers:sectionControllers];
+    [self addDepartedSectionControllers:previousSectionControllers];
+    [self removeDepartedPlaceholderCountedObjects];
 
     // now that the maps have been created and contexts are assigned, we consider the section controller "fully loaded"
     for (id object in updatedObjects) {
         [[map sectionControllerForObject:object] didUpdateToObject:object];
     }
 
-    NSInteger itemCount = 0;
+    [self updateBackgroundViewShouldHide:![self itemCountIsZero]];
+
+    IGListTraceEnd(trace, "updateObjects", objects.count);
+}
+
+// transitions the "source of truth" like -updateObjects:dataSource:, but only inserted objects are given section
+// controllers and only sections from the first change on are remapped
+- (void)updateObjects:(NSArray *)objects delta:(IGListIndexSetResult *)delta dataSource:(id<IGListAdapterDataSource>)dataSource {
+    IGParameterAssert(delta != nil);
+    IGParameterAssert(dataSource != nil);
+
+    const uint64_t trace = IGListTraceBegin();
+
+    IGListSectionMap *map = self.sectionMap;
+
+    // the map can drift from the objects the updater diffed, e.g. when a data source skipped an object
+    NSString *failureReason = [map failureReasonForDelta:delta toObjects:objects];
+    if (failureReason != nil) {
+        IGLKLog(@"WARNING: %@ for delta %@, rebuilding the section map without it.", failureReason, delta);
+        [self updateObjects:objects dataSource:dataSource];
+        IGListTraceEnd(trace, "updateObjectsWithDelta", delta.changeCount);
+        return;
+    }
+
+#if DEBUG
+    NSCountedSet *identifiersSet = [NSCountedSet new];
+    for (id object in objects) {
+        [identifiersSet addObject:[object diffIdentifier]];
+        IGAssert([identifiersSet countForObject:[object diffIdentifier]] <= 1, @"Diff identifier %@ for object %@ occurs more than once. Identifiers must be unique!", [object diffIdentifier], object);
+    }
+#endif
+
+    // section controllers, or NSNull for sections whose section controller is created lazily
+    NSMutableArray *insertedSectionControllers = [NSMutableArray arrayWithCapacity:delta.inserts.count];
+    // inserted sections whose section controller is new or was handed a new instance of its object
+    NSMutableIndexSet *updatedSections = [NSMutableIndexSet new];
+    NSIndexSet *deletes = delta.deletes;
+    const BOOL createsSectionControllersLazily = self.createsSectionControllersLazily;
+    __block id missingObject = nil;
+    __block BOOL pushedThread = NO;
+
+    [delta.inserts enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        id object = objects[idx];
+
+        // move planning can turn a move into a delete and an insert of the same identifier, which keeps its controller
+        const NSInteger oldSection = [map sectionForObject:object];
+        const BOOL deletedObject = oldSection != NSNotFound && [deletes containsIndex:oldSection];
+        IGListSectionController *sectionController = deletedObject ? [map sectionControllerForSection:oldSection] : nil;
+
+        // and its placeholder, and new objects get one when section controllers are created lazily
+        if (sectionController == nil && (deletedObject || createsSectionControllersLazily)) {
+            [insertedSectionControllers addObject:[NSNull null]];
+            return;
+        }
+
+        if (sectionController == nil || [map isObjectUpdated:object]) {
+            [updatedSections addIndex:idx];
+        }
+        if (sectionController == nil) {
+            sectionController = [self reusableSectionControllerForObject:object dataSource:dataSource];
+        }
+        if (sectionController == nil) {
+            if (!pushedThread) {
+                IGListSectionControllerPushThread(self.viewController, self);
+                pushedThread = YES;
+            }
+            sectionController = [dataSource listAdapter:self sectionControllerForObject:object];
+        }
+        if (sectionController == nil) {
+            missingObject = object;
+            *stop = YES;
+            return;
+        }
+
+        // in case the section controller was created outside of -listAdapter:sectionControllerForObject:
+        sectionController.collectionContext = self;
+        sectionController.viewController = self.viewController;
+        [insertedSectionControllers addObject:sectionController];
+    }];
+
+    if (pushedThread) {
+        IGListSectionControllerPopThread();
+    }
+
+    // a delta cannot skip an object, so rebuild the map instead. the collection view will disagree with the section
+    // count, as it would if a data source returned different objects than it diffed
+    if (missingObject != nil) {
+        IGLKLog(@"WARNING: Nil section controller returned by data source %@ for inserted object %@, rebuilding without the delta.",
+                dataSource, missingObject);
+        [self updateObjects:objects dataSource:dataSource];
+        IGListTraceEnd(trace, "updateObjectsWithDelta", delta.changeCount);
+        return;
+    }
+
+    // where updated objects end up, looked up while the map still holds the objects the delta was diffed from
+    NSMutableIndexSet *updatedObjectSections = [NSMutableIndexSet new];
+    if (delta.hasIdentifiers) {
+        [delta.updates enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            id<IGListDiffable> object = [map objectForSection:idx];
+            const NSInteger section = object != nil
+            ? [delta newIndexForIdentifier:[object diffIdentifier]]
+            : NSNotFound;
+            if (section != NSNotFound) {
+                [updatedObjectSections addIndex:section];
+            }
+        }];
+    } else {
+        [delta enumerateNewIndexesForOldIndexes:delta.updates usingBlock:^(NSInteger oldIndex, NSInteger newIndex) {
+            if (newIndex != NSNotFound) {
+                [updatedObjectSections addIndex:newIndex];
+            }
+        }];
+    }
+
+    NSArray<IGListSectionController *> *deletedSectionControllers = [self reuseCandidatesInSections:deletes];
+    NSIndexSet *replacedSections = [map applyDelta:delta toObjects:objects insertedSectionControllers:insertedSectionControllers];
+    if (replacedSections == nil) {
+        IGLKLog(@"WARNING: The section map holds other objects than delta %@ was diffed from, rebuilding the section map without it.",
+                delta);
+        [self updateObjects:objects dataSource:dataSource];
+        IGListTraceEnd(trace, "updateObjectsWithDelta", delta.changeCount);
+        return;
+    }
+    [self addDepartedSectionControllers:deletedSectionControllers];
+    [self removeDepartedPlaceholderCountedObjects];
+    [updatedSections addIndexes:replacedSections];
+    [updatedSections addIndexes:updatedObjectSections];
+
+    // now that the maps have been patched, the new and updated section controllers are considered "fully loaded"
+    [updatedSections enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        [[map sectionControllerForSection:idx] didUpdateToObject:objects[idx]];
+    }];
+
+    [self updateBackgroundViewShouldHide:![self itemCountIsZero]];
+
+    IGListTraceEnd(trace, "updateObjectsWithDelta", delta.changeCount);
+}
+
+// the section controllers that may leave the map in the given sections, or in every section, if reuse is enabled
+- (nullable NSArray<IGListSectionController *> *)reuseCandidatesInSections:(nullable NSIndexSet *)sections {
+    if (!self.reusesSectionControllers) {
+        return nil;
+    }
+
+    IGListSectionMap *map = self.sectionMap;
+    NSMutableArray<IGListSectionController *> *sectionControllers = [NSMutableArray new];
+    if (sections == nil) {
+        for (NSInteger section = 0; section < map.count; section++) {
+            IGListSectionController *sectionController = [map sectionControllerForSection:section];
+            if (sectionController != nil) {
+                [sectionControllers addObject:sectionController];
+            }
+        }
+    } else {
+        [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+            IGListSectionController *sectionController = [map sectionControllerForSection:section];
+            if (sectionController != nil) {
+                [sectionControllers addObject:sectionController];
+            }
+        }];
+    }
+    return sectionControllers;
+}
+
+// keeps the section controllers that are no longer in the map until the update that removed them completes, since the
+// previous section map and the collection view's outgoing cells can still reach them
+- (void)addDepartedSectionControllers:(nullable NSArray<IGListSectionController *> *)sectionControllers {
     for (IGListSectionController *sectionController in sectionControllers) {
-        itemCount += [sectionController numberOfItems];
+        if (sectionController.section != NSNotFound) {
+            continue;
+        }
+        if (_departedSectionControllers == nil) {
+            _departedSectionControllers = [NSHashTable hashTableWithOptions:NSHashTableStrongMemory | NSHashTableObjectPointerPersonality];
+        }
+        [_departedSectionControllers addObject:sectionController];
     }
+}
 
-    [self updateBackgroundViewShouldHide:itemCount > 0];
+- (void)recycleDepartedSectionControllers {
+    if (_departedSectionControllers.count == 0) {
+        return;
+    }
+    if (_reusePool == nil) {
+        _reusePool = [[IGListSectionControllerReusePool alloc] initWithMaximumCountPerClass:kIGListReusableSectionControllersPerClass];
+    }
+
+    // -prepareForReuse runs client code, so take the section controllers out before enqueuing them
+    NSArray<IGListSectionController *> *sectionControllers = _departedSectionControllers.allObjects;
+    [_departedSectionControllers removeAllObjects];
+    for (IGListSectionController *sectionController in sectionControllers) {
+        // a later update may have put it back
+        if (sectionController.section == NSNotFound) {
+            [_reusePool enqueueSectionController:sectionController];
+        }
+    }
+}
+
+- (nullable IGListSectionController *)reusableSectionControllerForObject:(id)object
+                                                              dataSource:(id<IGListAdapterDataSource>)dataSource {
+    // only ask for the class when there is a section controller to hand out
+    if (_reusePool.count == 0 || ![dataSource respondsToSelector:@selector(listAdapter:sectionControllerClassForObject:)]) {
+        return nil;
+    }
+    Class sectionControllerClass = [dataSource listAdapter:self sectionControllerClassForObject:object];
+    return sectionControllerClass != nil ? [_reusePool dequeueSectionControllerOfClass:sectionControllerClass] : nil;
+}
+
+- (void)removeReusableSectionControllers {
+    [_reusePool removeAllSectionControllers];
+    [_departedSectionControllers removeAllObjects];
 }
 
 - (void)updateBackgroundViewShouldHide:(BOOL)shouldHide {
@@ -624,14 +956,137 @@
 }
 
 - (BOOL)itemCountIsZero {
-    __block BOOL isZero = YES;
-    [self.sectionMap enumerateUsingBlock:^(id  _Nonnull object, IGListSectionController * _Nonnull sectionController, NSInteger section, BOOL * _Nonnull stop) {
-        if (sectionController.numberOfItems > 0) {
-            isZero = NO;
-            *stop = YES;
+    const NSInteger count = self.sectionMap.count;
+    for (NSInteger section = 0; section < count; section++) {
+        if ([self numberOfItemsInSection:section] > 0) {
+            return NO;
         }
-    }];
-    return isZero;
+    }
+    return YES;
+}
+
+- (NSInteger)numberOfItemsInSection:(NSInteger)section {
+    IGListSectionMap *map = self.sectionMap;
+    IGListSectionController *sectionController = [map sectionControllerForSection:section];
+    if (sectionController != nil) {
+        return [sectionController numberOfItems];
+    }
+
+    // count a placeholder without creating its section controller when the data source can
+    id object = [map objectForSection:section];
+    id<IGListAdapterDataSource> dataSource = self.dataSource;
+    if (object != nil && [dataSource respondsToSelector:@selector(listAdapter:numberOfItemsForObject:)]) {
+        return [dataSource listAdapter:self numberOfItemsForObject:object];
+    }
+    if (object != nil && [dataSource respondsToSelector:@selector(listAdapter:sectionControllerClassForObject:)]) {
+        Class sectionControllerClass = [dataSource listAdapter:self sectionControllerClassForObject:object];
+        NSNumber *itemCount = sectionControllerClass != nil ? [_placeholderItemCounts objectForKey:sectionControllerClass] : nil;
+        if (itemCount != nil && itemCount.integerValue >= 0) {
+            if (_placeholderCountedObjects == nil) {
+                _placeholderCountedObjects = [[NSMapTable alloc] initWithKeyPointerFunctions:[self.updater objectLookupPointerFunctions]
+                                                                       valuePointerFunctions:[NSPointerFunctions pointerFunctionsWithOptions:NSPointerFunctionsStrongMemory]
+                                                                                    capacity:0];
+            }
+            [_placeholderCountedObjects setObject:itemCount forKey:object];
+            return itemCount.integerValue;
+        }
+    }
+    sectionController = [self sectionControllerForSection:section];
+    IGAssert(sectionController != nil, @"Nil section controller for section %zi for item %@. Check your -diffIdentifier and -isEqual: implementations.",
+             section, object);
+    return [sectionController numberOfItems];
+}
+
+- (nullable IGListSectionController *)createSectionControllerForPlaceholderAtSection:(NSInteger)section {
+    IGListSectionMap *map = self.sectionMap;
+    id object = [map objectForSection:section];
+    id<IGListAdapterDataSource> dataSource = self.dataSource;
+    if (object == nil || dataSource == nil) {
+        return nil;
+    }
+
+    const uint64_t trace = IGListTraceBegin();
+
+    IGListSectionController *sectionController = [self reusableSectionControllerForObject:object dataSource:dataSource];
+    if (sectionController == nil) {
+        IGListSectionControllerPushThread(self.viewController, self);
+        sectionController = [dataSource listAdapter:self sectionControllerForObject:object];
+        IGListSectionControllerPopThread();
+    }
+    if (sectionController == nil) {
+        IGLKLog(@"WARNING: Nil section controller returned by data source %@ for object %@ in section %zi.",
+                dataSource, object, section);
+        IGListTraceEnd(trace, "createSectionController", section);
+        return nil;
+    }
+
+    // in case the section controller was created outside of -listAdapter:sectionControllerForObject:
+    sectionController.collectionContext = self;
+    sectionController.viewController = self.viewController;
+
+    [map setSectionController:sectionController forSection:section];
+    [sectionController didUpdateToObject:object];
+    [self recordPlaceholderItemCountOfSectionController:sectionController object:object];
+
+    IGListTraceEnd(trace, "createSectionController", section);
+    return sectionController;
+}
+
+// learns how many items the first new section controller of each class starts with, so placeholders can be counted
+// without creating theirs. -1 marks a class whose section controllers started with different counts
+- (void)recordPlaceholderItemCountOfSectionController:(IGListSectionController *)sectionController object:(id)object {
+    id<IGListAdapterDataSource> dataSource = self.dataSource;
+    if ([dataSource respondsToSelector:@selector(listAdapter:numberOfItemsForObject:)]
+        || ![dataSource respondsToSelector:@selector(listAdapter:sectionControllerClassForObject:)]) {
+        return;
+    }
+
+    if (_placeholderItemCounts == nil) {
+        _placeholderItemCounts = [NSMapTable mapTableWithKeyOptions:NSMapTableObjectPointerPersonality | NSMapTableStrongMemory
+                                                       valueOptions:NSMapTableStrongMemory];
+    }
+
+    Class sectionControllerClass = [sectionController class];
+    const NSInteger itemCount = [sectionController numberOfItems];
+    NSNumber *previousItemCount = [_placeholderItemCounts objectForKey:sectionControllerClass];
+    if (previousItemCount == nil) {
+        [_placeholderItemCounts setObject:@(itemCount) forKey:sectionControllerClass];
+    } else if (previousItemCount.integerValue != itemCount) {
+        [_placeholderItemCounts setObject:@(-1) forKey:sectionControllerClass];
+    }
+
+    // the collection view may have counted the placeholder with another count, and rejects any batch update that starts
+    // from it. reload the section through the updater so the reload is part of whichever batch is applied next
+    NSNumber *countedItemCount = [_placeholderCountedObjects objectForKey:object];
+    if (countedItemCount == nil) {
+        return;
+    }
+    [_placeholderCountedObjects removeObjectForKey:object];
+    UICollectionView *collectionView = self.collectionView;
+    if (countedItemCount.integerValue != itemCount && collectionView != nil) {
+        __weak __typeof__(self) weakSelf = self;
+        [self.updater performUpdateWithCollectionView:collectionView animated:YES itemUpdates:^{
+            __typeof__(self) strongSelf = weakSelf;
+            // reloads are recorded with the sections the collection view is updating from
+            const BOOL wasInUpdateBlock = strongSelf.isInUpdateBlock;
+            strongSelf.isInUpdateBlock = YES;
+            [strongSelf reloadObjects:@[object]];
+            strongSelf.isInUpdateBlock = wasInUpdateBlock;
+        } completion:nil];
+    }
+}
+
+// forgets the counts of placeholders whose objects left the section map before their section controller was created
+- (void)removeDepartedPlaceholderCountedObjects {
+    if (_placeholderCountedObjects.count == 0) {
+        return;
+    }
+    IGListSectionMap *map = self.sectionMap;
+    for (id object in [[_placeholderCountedObjects keyEnumerator] allObjects]) {
+        if ([map sectionForObject:object] == NSNotFound) {
+            [_placeholderCountedObjects removeObjectForKey:object];
+        }
+    }
 }
 
 - (IGListSectionMap *)sectionMapUsingPreviousIfInUpdateBlock:(BOOL)usePreviousMapIfInUpdateBlock {
@@ -1073,15 +1528,24 @@
 
      IGListAdapter tracks the before/after mapping of section controllers to make precise NSIndexPath conversions.
      */
-    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
-        NSIndexPath *fromIndexPath = [self indexPathForSectionController:sectionController index:index usePreviousIfInUpdateBlock:YES];
-        NSIndexPath *toIndexPath = [self indexPathForSectionController:sectionController index:index usePreviousIfInUpdateBlock:NO];
-        // index paths could be nil if a section controller is prematurely reloading or a reload was batched with
-        // the section controller being deleted
-        if (fromIndexPath != nil && toIndexPath != nil) {
-            [self.updater reloadItemInCollectionView:collectionView fromIndexPath:fromIndexPath toIndexPath:toIndexPath];
-        }
-    }];
+    const NSInteger fromSection = [[self sectionMapUsingPreviousIfInUpdateBlock:YES] sectionForSectionController:sectionController];
+    const NSInteger toSection = [[self sectionMapUsingPreviousIfInUpdateBlock:NO] sectionForSectionController:sectionController];
+    // sections could be missing if a section controller is prematurely reloading or a reload was batched with the
+    // section controller being deleted
+    if (fromSection == NSNotFound || toSection == NSNotFound) {
+        return;
+    }
+
+    id<IGListUpdatingDelegate> updater = self.updater;
+    if ([updater respondsToSelector:@selector(reloadItemsInCollectionView:fromSection:toSection:indexes:)]) {
+        [updater reloadItemsInCollectionView:collectionView fromSection:fromSection toSection:toSection indexes:indexes];
+    } else {
+        [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            NSIndexPath *fromIndexPath = [NSIndexPath indexPathForItem:index inSection:fromSection];
+            NSIndexPath *toIndexPath = [NSIndexPath indexPathForItem:index inSection:toSection];
+            [updater reloadItemInCollectionView:collectionView fromIndexPath:fromIndexPath toIndexPath:toIndexPath];
+        }];
+    }
 }
 
 - (void)insertInSectionController:(IGListSectionController *)sectionController atIndexes:(NSIndexSet *)indexes {
@@ -61,6 +61,36 @@ NS_SWIFT_NAME(ListAdapterDataSource)
  */
 - (nullable UIView *)emptyViewForListAdapter:(IGListAdapter *)listAdapter;
 
+@optional
+
+/**
+ Asks the data source for the class of the section controller it would return for the specified object.
+
+ @param listAdapter The list adapter requesting this information.
+ @param object An object in the list.
+
+ @return The exact class `-listAdapter:sectionControllerForObject:` would return an instance of, or `nil` to always be
+ asked for a new section controller for this object.
+
+ @note When `-[IGListAdapter reusesSectionControllers]` is enabled, a section controller of this class that left the
+ list is handed to the object instead of asking for a new one. Implement this method to enable reuse.
+ */
+- (nullable Class)listAdapter:(IGListAdapter *)listAdapter sectionControllerClassForObject:(id)object;
+
+/**
+ Asks the data source for the number of items the section controller for the specified object will have.
+
+ @param listAdapter The list adapter requesting this information.
+ @param object An object in the list.
+
+ @return The number of items the section controller will report after `-didUpdateToObject:` is called with `object`.
+
+ @note Only sections whose section controller has not been created yet are counted with this method, see
+ `-[IGListAdapter createsSectionControllersLazily]`. It is called whenever the collection view counts items, so it
+ should be cheap.
+ */
+- (NSInteger)listAdapter:(IGListAdapter *)listAdapter numberOfItemsForObject:(id)object;
+
 @end
 
 NS_ASSUME_NONNULL_END
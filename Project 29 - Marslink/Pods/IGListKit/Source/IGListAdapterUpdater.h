@@ -12,6 +12,9 @@
 #import <IGListKit/IGListAdapterUpdaterDelegate.h>
 #import <IGListKit/IGListExperiments.h>
 #import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListMovePlanning.h>
+#import <IGListKit/IGListUpdateCostModel.h>
+#import <IGListKit/IGListUpdateScheduler.h>
 #import <IGListKit/IGListUpdatingDelegate.h>
 
 NS_ASSUME_NONNULL_BEGIN
@@ -49,11 +52,81 @@ NS_SWIFT_NAME(ListAdapterUpdater)
  */
 @property (nonatomic, assign) BOOL allowsBackgroundReloading;
 
+/**
+ A flag indicating whether updates to a collection view that is not in a window are held until it enters one, and then
+ applied together with a single `reloadData`. The default value is `NO`.
+
+ @note While held, the data source is not transitioned, no section controllers are created and completion blocks are
+ not called. Requires `allowsBackgroundReloading`.
+ */
+@property (nonatomic, assign) BOOL defersOffscreenUpdates;
+
 /**
  A bitmask of experiments to conduct on the updater.
  */
 @property (nonatomic, assign) IGListExperiment experiments;
 
+/**
+ The costs used to plan moves when the `IGListExperimentMovePlanning` experiment is enabled. The default value is
+ `IGListMoveCostModelDefault`.
+ */
+@property (nonatomic, assign) IGListMoveCostModel moveCostModel;
+
+/**
+ Analyze how the diffed objects distribute in the diffing symbol table once every `hashQualitySampleInterval` batch
+ updates, and report the result to the delegate. The default value is `0`, which disables sampling.
+
+ @note Use this to find models with poor `-hash` implementations on their `-diffIdentifier`. Analysis runs on the main
+ thread and costs more than the diff itself, so keep the interval large outside of debugging sessions.
+ */
+@property (nonatomic, assign) NSInteger hashQualitySampleInterval;
+
+/**
+ A flag indicating whether each batch update is checked against a model of the consistency rules `UICollectionView`
+ enforces before it is committed. The default value is `NO`.
+
+ @note A batch that would throw is replaced by deleting and inserting every section, and the delegate is notified with
+ `-listAdapterUpdater:didRejectBatchUpdates:reason:collectionView:`. Validation queries the data source for every
+ section's item count, so it costs O(sections) per update.
+ */
+@property (nonatomic, assign) BOOL validatesBatchUpdates;
+
+/**
+ A flag indicating whether diffs run on a dedicated background queue. The default value is `NO`.
+
+ @note Objects are diffed from an immutable snapshot taken when the update starts, so `-diffIdentifier` and
+ `-isEqualToDiffableObject:` are called off the main thread and must be safe to call there. Diffs run one at a time; if
+ newer objects are passed before a diff lands, that diff is dropped and the newest objects are diffed instead, so the
+ main thread only applies the result. Enabling `IGListExperimentBackgroundDiffing` has the same effect.
+ */
+@property (nonatomic, assign) BOOL diffsInBackground;
+
+/**
+ The measured cost of batch updating and reloading this updater's collection view. When the
+ `IGListExperimentReloadDataFallback` experiment is enabled, each update takes whichever path the model estimates to be
+ cheaper and its duration is recorded back into the model, as is the duration of every other reload.
+ */
+@property (nonatomic, strong, readonly) IGListUpdateCostModel *updateCostModel;
+
+/**
+ Decides when coalesced updates are performed. The default value is an `IGListMainQueueUpdateScheduler`.
+
+ @note Use an `IGListFrameUpdateScheduler` to perform at most one update per frame, and share it between adapters to
+ bound the update work done in a single frame. An update waiting on the previous scheduler is scheduled again on the new
+ one.
+ */
+@property (nonatomic, strong) id<IGListUpdateScheduler> scheduler;
+
+/**
+ The number of object updates that may arrive while a batch update is in flight before the next batch update is applied
+ without animation. The default value is `0`, which never disables animations.
+
+ @note Updates that arrive while a batch update animates are coalesced: only the latest `toObjects` are diffed once the
+ animation completes, and intermediate states are dropped. When updates arrive faster than animations complete, setting
+ this lets the list catch up instead of trailing one animation behind the data.
+ */
+@property (nonatomic, assign) NSInteger maximumAnimatedBacklog;
+
 @end
 
 NS_ASSUME_NONNULL_END
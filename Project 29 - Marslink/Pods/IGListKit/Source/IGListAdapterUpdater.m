@@ -13,12 +13,15 @@
 #import <IGListKit/IGListAssert.h>
 #import <IGListKit/IGListBatchUpdateData.h>
 #import <IGListKit/IGListDiff.h>
+#import <IGListKit/IGListHashQualityReport.h>
 
 #import "UICollectionView+IGListBatchUpdateData.h"
+#import "IGListBatchUpdateValidator.h"
+#import "IGListDiffExecutor.h"
+#import "IGListMainQueueUpdateScheduler.h"
+#import "IGListUpdateCoordinatorInternal.h"
 #import "IGListIndexSetResultInternal.h"
-#import "IGListMoveIndexPathInternal.h"
-#import "IGListReloadIndexPath.h"
-#import "IGListArrayUtilsInternal.h"
+#import "IGListTracing.h"
 
 @implementation IGListAdapterUpdater
 
@@ -31,6 +34,10 @@
         _completionBlocks = [NSMutableArray new];
         _batchUpdates = [IGListBatchUpdates new];
         _allowsBackgroundReloading = YES;
+        _moveCostModel = IGListMoveCostModelDefault;
+        _diffExecutor = [IGListDiffExecutor new];
+        _updateCostModel = [IGListUpdateCostModel new];
+        _scheduler = [IGListMainQueueUpdateScheduler new];
     }
     return self;
 }
@@ -52,11 +59,17 @@
         return;
     }
 
+    if ([self deferUpdatesIfOffscreenWithCollectionView:collectionView]) {
+        return;
+    }
+
     id<IGListAdapterUpdaterDelegate> delegate = self.delegate;
     void (^reloadUpdates)() = self.reloadUpdates;
     IGListBatchUpdates *batchUpdates = self.batchUpdates;
     NSMutableArray *completionBlocks = [self.completionBlocks mutableCopy];
 
+    // updates that piled up behind the previous batch are applied by this reload, so they do not count against the next
+    self.backlogCount = 0;
     [self cleanStateBeforeUpdates];
 
     // item updates must not send mutations to the collection view while we are reloading
@@ -81,15 +94,30 @@
 
     [self cleanStateAfterUpdates];
 
+    const BOOL measuresReload = IGListExperimentEnabled(self.experiments, IGListExperimentReloadDataFallback);
+    const NSInteger visibleCellCount = measuresReload ? collectionView.visibleCells.count : 0;
+
     [delegate listAdapterUpdater:self willReloadDataWithCollectionView:collectionView];
+    const CFTimeInterval start = CACurrentMediaTime();
+    const uint64_t reloadTrace = IGListTraceBegin();
     [collectionView reloadData];
     [collectionView.collectionViewLayout invalidateLayout];
+    IGListTraceEnd(reloadTrace, "reloadData", 0);
+    const uint64_t layoutTrace = IGListTraceBegin();
     [collectionView layoutIfNeeded];
+    IGListTraceEnd(layoutTrace, "layoutIfNeeded", 0);
+    const CFTimeInterval duration = CACurrentMediaTime() - start;
     [delegate listAdapterUpdater:self didReloadDataWithCollectionView:collectionView];
 
+    if (measuresReload) {
+        [self recordReloadDataDuration:duration visibleCellCount:visibleCellCount];
+    }
+
+    const uint64_t completionTrace = IGListTraceBegin();
     for (IGListUpdatingCompletion block in completionBlocks) {
         block(YES);
     }
+    IGListTraceEnd(completionTrace, "completionBlocks", completionBlocks.count);
 
     self.state = IGListBatchUpdateStateIdle;
 }
@@ -103,34 +131,61 @@
         return;
     }
 
+    if ([self deferUpdatesIfOffscreenWithCollectionView:collectionView]) {
+        return;
+    }
+
     // create local variables so we can immediately clean our state but pass these items into the batch update block
     id<IGListAdapterUpdaterDelegate> delegate = self.delegate;
+    const IGListExperiment experiments = self.experiments;
+    const IGListMoveCostModel moveCostModel = self.moveCostModel;
+    IGListUpdateCoordinator *coordinator = self.coordinator;
+    // a delta from the caller replaces the diff, and was validated against the objects when it was queued
+    IGListIndexSetResult *delta = self.delta;
+    const BOOL diffsInBackground = delta == nil
+    && (coordinator != nil
+        || self.diffsInBackground
+        || IGListExperimentEnabled(experiments, IGListExperimentBackgroundDiffing));
     NSArray *fromObjects = [self.fromObjects copy];
-    NSArray *toObjects = objectsWithDuplicateIdentifiersRemoved(self.toObjects);
+    // when diffing in the background, duplicates are removed on the diff queue and the result is assigned before the
+    // update is applied
+    __block NSArray *toObjects = diffsInBackground || delta != nil
+    ? [self.toObjects copy]
+    : IGListAdapterUpdaterObjectsWithDuplicateIdentifiersRemoved(self.toObjects);
     NSMutableArray *completionBlocks = [self.completionBlocks mutableCopy];
-    void (^objectTransitionBlock)(NSArray *) = [self.objectTransitionBlock copy];
-    const BOOL animated = self.queuedUpdateIsAnimated;
+    IGListObjectDeltaTransitionBlock objectTransitionBlock = [self.objectTransitionBlock copy];
+    const BOOL hadDeferredOffscreenUpdates = self.hasDeferredOffscreenUpdates;
     IGListBatchUpdates *batchUpdates = self.batchUpdates;
 
+    // updates that piled up behind the previous batch were coalesced into this one. if too many did, animating would
+    // only let the next backlog grow, so catch up without animation
+    const NSInteger maximumAnimatedBacklog = self.maximumAnimatedBacklog;
+    const BOOL animated = self.queuedUpdateIsAnimated
+    && (maximumAnimatedBacklog <= 0 || self.backlogCount <= maximumAnimatedBacklog);
+    self.backlogCount = 0;
+
     // clean up all state so that new updates can be coalesced while the current update is in flight
     [self cleanStateBeforeUpdates];
 
-    void (^executeUpdateBlocks)() = ^{
+    // the result is the delta or diff being applied, if known, and lets the adapter patch its section map
+    void (^executeUpdateBlocks)(IGListIndexSetResult *) = ^(IGListIndexSetResult *result) {
         self.state = IGListBatchUpdateStateExecutingBatchUpdateBlock;
 
         // run the update block so that the adapter can set its items. this makes sure that just before the update is
         // committed that the data source is updated to the /latest/ "toObjects". this makes the data source in sync
         // with the items that the updater is transitioning to
         if (objectTransitionBlock != nil) {
-            objectTransitionBlock(toObjects);
+            objectTransitionBlock(toObjects, result);
         }
 
         // execute each item update block which should make calls like insert, delete, and reload for index paths
         // we collect all mutations in corresponding sets on self, then filter based on UICollectionView shortcomings
         // call after the objectTransitionBlock so section level mutations happen before any items
+        const uint64_t itemUpdatesTrace = IGListTraceBegin();
         for (IGListItemUpdateBlock itemUpdateBlock in batchUpdates.itemUpdateBlocks) {
             itemUpdateBlock();
         }
+        IGListTraceEnd(itemUpdatesTrace, "itemUpdateBlocks", batchUpdates.itemUpdateBlocks.count);
 
         // add any completion blocks from item updates. added after item blocks are executed in order to capture any
         // re-entrant updates
@@ -143,46 +198,67 @@
         self.applyingUpdateData = nil;
         self.state = IGListBatchUpdateStateIdle;
 
+        const uint64_t trace = IGListTraceBegin();
         for (IGListUpdatingCompletion block in completionBlocks) {
             block(finished);
         }
+        IGListTraceEnd(trace, "completionBlocks", completionBlocks.count);
     };
 
-    void (^reloadDataFallback)() = ^{
-        executeUpdateBlocks();
+    // returns the time spent transitioning the data source and reloading, which is what a batch update is weighed against
+    CFTimeInterval (^reloadDataFallback)(IGListIndexSetResult *) = ^(IGListIndexSetResult *result) {
+        const CFTimeInterval start = CACurrentMediaTime();
+        executeUpdateBlocks(result);
         [self cleanStateAfterUpdates];
         [self performBatchUpdatesItemBlockApplied];
+        const uint64_t reloadTrace = IGListTraceBegin();
         [collectionView reloadData];
+        IGListTraceEnd(reloadTrace, "reloadData", toObjects.count);
+        const uint64_t layoutTrace = IGListTraceBegin();
         [collectionView layoutIfNeeded];
+        IGListTraceEnd(layoutTrace, "layoutIfNeeded", toObjects.count);
+        const CFTimeInterval duration = CACurrentMediaTime() - start;
         executeCompletionBlocks(YES);
+        return duration;
     };
 
     // if the collection view isn't in a visible window, skip diffing and batch updating. execute all transition blocks,
-    // reload data, execute completion blocks, and get outta here
+    // reload data, execute completion blocks, and get outta here. updates held while offscreen are applied the same way
+    // once the collection view is back in a window
     const BOOL iOS83OrLater = (NSFoundationVersionNumber >= NSFoundationVersionNumber_iOS_8_3);
-    if (iOS83OrLater && self.allowsBackgroundReloading && collectionView.window == nil) {
+    if ((iOS83OrLater && self.allowsBackgroundReloading && collectionView.window == nil) || hadDeferredOffscreenUpdates) {
+        if (diffsInBackground) {
+            toObjects = IGListAdapterUpdaterObjectsWithDuplicateIdentifiersRemoved(toObjects);
+        }
         [self beginPerformBatchUpdatesToObjects:toObjects];
-        reloadDataFallback();
+        const BOOL measuresReload = IGListExperimentEnabled(experiments, IGListExperimentReloadDataFallback);
+        const NSInteger visibleCellCount = measuresReload ? collectionView.visibleCells.count : 0;
+        const CFTimeInterval duration = reloadDataFallback(delta);
+        if (measuresReload) {
+            [self recordReloadDataDuration:duration visibleCellCount:visibleCellCount];
+        }
         return;
     }
 
     // disables multiple performBatchUpdates: from happening at the same time
     [self beginPerformBatchUpdatesToObjects:toObjects];
 
-    const IGListExperiment experiments = self.experiments;
-
-    IGListIndexSetResult *(^performDiff)() = ^{
-        return IGListDiffExperiment(fromObjects, toObjects, IGListDiffEquality, experiments);
-    };
+    if (delta == nil) {
+        [self sampleHashQualityFromObjects:fromObjects toObjects:toObjects];
+    }
 
     // block executed in the first param block of -[UICollectionView performBatchUpdates:completion:]
-    void (^batchUpdatesBlock)(IGListIndexSetResult *result) = ^(IGListIndexSetResult *result){
-        executeUpdateBlocks();
+    void (^batchUpdatesBlock)(IGListIndexSetResult *, IGListBatchUpdateValidator *) = ^(IGListIndexSetResult *result,
+                                                                                         IGListBatchUpdateValidator *validator){
+        executeUpdateBlocks(result);
 
+        const uint64_t flushTrace = IGListTraceBegin();
         self.applyingUpdateData = [self flushCollectionView:collectionView
                                              withDiffResult:result
                                                batchUpdates:self.batchUpdates
-                                                fromObjects:fromObjects];
+                                                fromObjects:fromObjects
+                                                  validator:validator];
+        IGListTraceEnd(flushTrace, "flushCollectionView", result.changeCount);
 
         [self cleanStateAfterUpdates];
         [self performBatchUpdatesItemBlockApplied];
@@ -203,22 +279,46 @@
     void (^performUpdate)(IGListIndexSetResult *) = ^(IGListIndexSetResult *result){
         @try {
             [delegate listAdapterUpdater:self willPerformBatchUpdatesWithCollectionView:collectionView];
-            if (result.changeCount > 100 && IGListExperimentEnabled(experiments, IGListExperimentReloadDataFallback)) {
-                reloadDataFallback();
-            } else if (animated) {
+
+            // pick whichever of reloading and batch updating has been measured to be cheaper for updates of this size
+            IGListUpdateCostModel *costModel = IGListExperimentEnabled(experiments, IGListExperimentReloadDataFallback)
+            ? self.updateCostModel
+            : nil;
+            const NSInteger changeCount = result.changeCount;
+            const NSInteger visibleCellCount = costModel != nil ? collectionView.visibleCells.count : 0;
+            if ([costModel shouldReloadDataForChangeCount:changeCount visibleCellCount:visibleCellCount]) {
+                const CFTimeInterval duration = reloadDataFallback(result);
+                [self recordReloadDataDuration:duration visibleCellCount:visibleCellCount];
+                return;
+            }
+
+            // capture the displayed counts before the data source transitions inside the update block
+            IGListBatchUpdateValidator *validator = self.validatesBatchUpdates
+            ? [[IGListBatchUpdateValidator alloc] initWithCollectionView:collectionView]
+            : nil;
+
+            const CFTimeInterval start = CACurrentMediaTime();
+            const uint64_t batchUpdatesTrace = IGListTraceBegin();
+            if (animated) {
                 [collectionView performBatchUpdates:^{
-                    batchUpdatesBlock(result);
+                    batchUpdatesBlock(result, validator);
                 } completion:batchUpdatesCompletionBlock];
             } else {
                 [CATransaction begin];
                 [CATransaction setDisableActions:YES];
                 [collectionView performBatchUpdates:^{
-                    batchUpdatesBlock(result);
+                    batchUpdatesBlock(result, validator);
                 } completion:^(BOOL finished) {
                     [CATransaction commit];
                     batchUpdatesCompletionBlock(finished);
                 }];
             }
+            IGListTraceEnd(batchUpdatesTrace, "performBatchUpdates", changeCount);
+            if (costModel != nil) {
+                const CFTimeInterval duration = CACurrentMediaTime() - start;
+                [costModel recordBatchUpdateDuration:duration changeCount:changeCount visibleCellCount:visibleCellCount];
+                [self notifyDelegateOfUpdateDuration:duration reloadedData:NO costModel:costModel];
+            }
         } @catch (NSException *exception) {
             [delegate listAdapterUpdater:self
                   willCrashWithException:exception
@@ -229,32 +329,173 @@
         }
     };
 
-    // temporary test to try out background diffing
-    if (IGListExperimentEnabled(experiments, IGListExperimentBackgroundDiffing)) {
-        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-            IGListIndexSetResult *result = performDiff();
-            dispatch_async(dispatch_get_main_queue(), ^{
-                performUpdate(result);
-            });
-        });
+    if (delta != nil) {
+        performUpdate(delta);
+    } else if (coordinator != nil) {
+        IGListDiffSnapshot *snapshot = [[IGListDiffSnapshot alloc] initWithFromObjects:fromObjects
+                                                                             toObjects:toObjects
+                                                                           experiments:experiments
+                                                                         moveCostModel:moveCostModel];
+
+        // diffed alongside every other coordinated update of this frame and applied with them in one pass
+        [coordinator diffSnapshot:snapshot completion:^(NSArray *uniqueToObjects, IGListIndexSetResult *result) {
+            toObjects = uniqueToObjects;
+            self.pendingTransitionToObjects = uniqueToObjects;
+            performUpdate(result);
+        }];
+    } else if (diffsInBackground) {
+        IGListDiffSnapshot *snapshot = [[IGListDiffSnapshot alloc] initWithFromObjects:fromObjects
+                                                                             toObjects:toObjects
+                                                                           experiments:experiments
+                                                                         moveCostModel:moveCostModel];
+
+        // keep what is needed to fold this update back into the queue if newer objects arrive before the diff lands
+        self.diffingFromObjects = fromObjects;
+        self.diffingCompletionBlocks = completionBlocks;
+        self.diffingAnimated = animated;
+
+        [self.diffExecutor diffSnapshot:snapshot completion:^(NSArray *uniqueToObjects, IGListIndexSetResult *result) {
+            self.diffingFromObjects = nil;
+            self.diffingCompletionBlocks = nil;
+
+            toObjects = uniqueToObjects;
+            self.pendingTransitionToObjects = uniqueToObjects;
+            performUpdate(result);
+        }];
     } else {
-        IGListIndexSetResult *result = performDiff();
+        IGListIndexSetResult *result = IGListAdapterUpdaterDiff(fromObjects, toObjects, experiments, moveCostModel);
         performUpdate(result);
     }
 }
 
-void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
-                                 NSMutableIndexSet *deletes,
-                                 NSMutableIndexSet *inserts,
+- (BOOL)deferUpdatesIfOffscreenWithCollectionView:(UICollectionView *)collectionView {
+    const BOOL iOS83OrLater = (NSFoundationVersionNumber >= NSFoundationVersionNumber_iOS_8_3);
+    if (!iOS83OrLater || !self.defersOffscreenUpdates || !self.allowsBackgroundReloading || collectionView.window != nil) {
+        return NO;
+    }
+
+    // nothing is cleaned up, so later updates keep coalescing onto the held ones for free
+    self.hasDeferredOffscreenUpdates = YES;
+    if (self.windowObserverView.superview == collectionView) {
+        return YES;
+    }
+
+    [self.windowObserverView removeFromSuperview];
+    IGListWindowObserverView *windowObserverView = [[IGListWindowObserverView alloc] initWithFrame:CGRectZero];
+    __weak __typeof__(self) weakSelf = self;
+    __weak __typeof__(collectionView) weakCollectionView = collectionView;
+    windowObserverView.didMoveToWindowBlock = ^(UIWindow *window) {
+        if (window == nil) {
+            return;
+        }
+        [weakSelf performDeferredOffscreenUpdatesWithCollectionView:weakCollectionView];
+    };
+    [collectionView addSubview:windowObserverView];
+    self.windowObserverView = windowObserverView;
+    return YES;
+}
+
+- (void)performDeferredOffscreenUpdatesWithCollectionView:(UICollectionView *)collectionView {
+    IGAssertMainThread();
+
+    [self.windowObserverView removeFromSuperview];
+    self.windowObserverView = nil;
+
+    // apply before the collection view is first laid out in the window so stale content is never displayed
+    if (collectionView == nil || self.state != IGListBatchUpdateStateIdle || ![self hasChanges]) {
+        return;
+    }
+    if (self.hasQueuedReloadData) {
+        [self performReloadDataWithCollectionView:collectionView];
+    } else {
+        [self performBatchUpdatesWithCollectionView:collectionView];
+    }
+}
+
+- (void)reclaimDiffingUpdate {
+    IGAssertMainThread();
+    IGAssert(self.state == IGListBatchUpdateStateQueuedBatchUpdate, @"Can only reclaim an update whose diff has not been applied");
+
+    [self.diffExecutor cancel];
+
+    // the data source never transitioned to the superseded objects, so diff from where it actually is
+    self.fromObjects = self.fromObjects ?: self.diffingFromObjects;
+    self.pendingTransitionToObjects = nil;
+
+    // completion blocks of the superseded update run first, as they would have if it had been applied
+    NSArray<IGListUpdatingCompletion> *completionBlocks = self.diffingCompletionBlocks ?: @[];
+    [self.completionBlocks insertObjects:completionBlocks
+                               atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, completionBlocks.count)]];
+    self.queuedUpdateIsAnimated = self.queuedUpdateIsAnimated && self.diffingAnimated;
+
+    self.diffingFromObjects = nil;
+    self.diffingCompletionBlocks = nil;
+    self.state = IGListBatchUpdateStateIdle;
+}
+
+// every reload is a sample of what reloading costs, whether the cost model chose it or the update had to reload
+- (void)recordReloadDataDuration:(CFTimeInterval)duration visibleCellCount:(NSInteger)visibleCellCount {
+    IGListUpdateCostModel *costModel = self.updateCostModel;
+    [costModel recordReloadDataDuration:duration visibleCellCount:visibleCellCount];
+    [self notifyDelegateOfUpdateDuration:duration reloadedData:YES costModel:costModel];
+}
+
+- (void)notifyDelegateOfUpdateDuration:(CFTimeInterval)duration
+                          reloadedData:(BOOL)reloadedData
+                             costModel:(IGListUpdateCostModel *)costModel {
+    id<IGListAdapterUpdaterDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(listAdapterUpdater:didMeasureUpdateDuration:reloadedData:costModel:)]) {
+        [delegate listAdapterUpdater:self didMeasureUpdateDuration:duration reloadedData:reloadedData costModel:costModel];
+    }
+}
+
+- (void)sampleHashQualityFromObjects:(NSArray *)fromObjects toObjects:(NSArray *)toObjects {
+    const NSInteger interval = self.hashQualitySampleInterval;
+    id<IGListAdapterUpdaterDelegate> delegate = self.delegate;
+    if (interval <= 0 || ![delegate respondsToSelector:@selector(listAdapterUpdater:didAnalyzeHashQuality:fromObjects:toObjects:)]) {
+        return;
+    }
+
+    self.hashQualitySampleCounter = (self.hashQualitySampleCounter + 1) % interval;
+    if (self.hashQualitySampleCounter != 0) {
+        return;
+    }
+
+    // the diff puts old and new identifiers in the same table, so analyze them together
+    NSArray *objects = [fromObjects ?: @[] arrayByAddingObjectsFromArray:toObjects ?: @[]];
+    IGListHashQualityReport *report = IGListHashQualityAnalyze(objects);
+    [delegate listAdapterUpdater:self didAnalyzeHashQuality:report fromObjects:fromObjects toObjects:toObjects];
+}
+
+void convertReloadToDeleteInsert(IGListRunIndexSet *reloads,
+                                 IGListRunIndexSet *deletes,
+                                 IGListRunIndexSet *inserts,
                                  IGListIndexSetResult *result,
                                  NSArray<id<IGListDiffable>> *fromObjects) {
     // reloadSections: is unsafe to use within performBatchUpdates:, so instead convert all reloads into deletes+inserts
     const BOOL hasObjects = [fromObjects count] > 0;
+    const BOOL hasIdentifiers = result.hasIdentifiers;
+
+    // a delta from the caller maps indexes directly, all of them in one pass over its changes
+    NSMutableDictionary<NSNumber *, NSNumber *> *deltaNewIndexes = nil;
+    if (hasObjects && !hasIdentifiers) {
+        deltaNewIndexes = [NSMutableDictionary dictionaryWithCapacity:reloads.count];
+        [result enumerateNewIndexesForOldIndexes:reloads.indexSet usingBlock:^(NSInteger oldIndex, NSInteger newIndex) {
+            deltaNewIndexes[@(oldIndex)] = @(newIndex);
+        }];
+    }
+
     [[reloads copy] enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
         // if a diff was not performed, there are no changes. instead use the same index that was originally queued
-        id<NSObject> diffIdentifier = hasObjects ? [fromObjects[idx] diffIdentifier] : nil;
-        const NSInteger from = hasObjects ? [result oldIndexForIdentifier:diffIdentifier] : idx;
-        const NSInteger to = hasObjects ? [result newIndexForIdentifier:diffIdentifier] : idx;
+        NSInteger from = idx;
+        NSInteger to = idx;
+        if (hasObjects && hasIdentifiers) {
+            id<NSObject> diffIdentifier = [fromObjects[idx] diffIdentifier];
+            from = [result oldIndexForIdentifier:diffIdentifier];
+            to = [result newIndexForIdentifier:diffIdentifier];
+        } else if (hasObjects) {
+            to = [deltaNewIndexes[@(idx)] integerValue];
+        }
         [reloads removeIndex:from];
 
         // if a reload is queued outside the diff and the object was inserted or deleted it cannot be
@@ -272,15 +513,17 @@ void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
 - (IGListBatchUpdateData *)flushCollectionView:(UICollectionView *)collectionView
                                 withDiffResult:(IGListIndexSetResult *)diffResult
                                   batchUpdates:(IGListBatchUpdates *)batchUpdates
-                                   fromObjects:(NSArray <id<IGListDiffable>> *)fromObjects {
+                                   fromObjects:(NSArray <id<IGListDiffable>> *)fromObjects
+                                     validator:(IGListBatchUpdateValidator *)validator {
     NSSet *moves = [[NSSet alloc] initWithArray:diffResult.moves];
 
-    // combine section reloads from the diff and manual reloads via reloadItems:
-    NSMutableIndexSet *reloads = [diffResult.updates mutableCopy];
-    [reloads addIndexes:batchUpdates.sectionReloads];
+    // combine section reloads from the diff and manual reloads via reloadItems:. section indexes travel as runs from
+    // here on and are only bridged back to NSIndexSet when applied to the collection view
+    IGListRunIndexSet *reloads = [IGListRunIndexSet indexSetWithIndexSet:diffResult.updates];
+    [reloads unionIndexSet:batchUpdates.sectionReloads];
 
-    NSMutableIndexSet *inserts = [diffResult.inserts mutableCopy];
-    NSMutableIndexSet *deletes = [diffResult.deletes mutableCopy];
+    IGListRunIndexSet *inserts = [IGListRunIndexSet indexSetWithIndexSet:diffResult.inserts];
+    IGListRunIndexSet *deletes = [IGListRunIndexSet indexSetWithIndexSet:diffResult.deletes];
     if (self.movesAsDeletesInserts) {
         for (IGListMoveIndex *move in moves) {
             [deletes addIndex:move.from];
@@ -293,29 +536,23 @@ void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
     // reloadSections: is unsafe to use within performBatchUpdates:, so instead convert all reloads into deletes+inserts
     convertReloadToDeleteInsert(reloads, deletes, inserts, diffResult, fromObjects);
 
-    NSMutableArray<NSIndexPath *> *itemInserts = batchUpdates.itemInserts;
-    NSMutableArray<NSIndexPath *> *itemDeletes = batchUpdates.itemDeletes;
-    NSMutableArray<IGListMoveIndexPath *> *itemMoves = batchUpdates.itemMoves;
-
-    NSSet<NSIndexPath *> *uniqueDeletes = [NSSet setWithArray:itemDeletes];
-    NSMutableSet<NSIndexPath *> *reloadDeletePaths = [NSMutableSet new];
-    NSMutableSet<NSIndexPath *> *reloadInsertPaths = [NSMutableSet new];
-    for (IGListReloadIndexPath *reload in batchUpdates.itemReloads) {
-        if (![uniqueDeletes containsObject:reload.fromIndexPath]) {
-            [reloadDeletePaths addObject:reload.fromIndexPath];
-            [reloadInsertPaths addObject:reload.toIndexPath];
+    IGListBatchUpdateData *updateData = [batchUpdates updateDataWithInsertSections:inserts
+                                                                    deleteSections:deletes
+                                                                      moveSections:moves];
+
+    // recover from an inconsistent batch by reloading every section rather than throwing
+    NSString *failureReason = [validator failureReasonForUpdateData:updateData collectionView:collectionView];
+    if (failureReason != nil) {
+        id<IGListAdapterUpdaterDelegate> delegate = self.delegate;
+        if ([delegate respondsToSelector:@selector(listAdapterUpdater:didRejectBatchUpdates:reason:collectionView:)]) {
+            [delegate listAdapterUpdater:self didRejectBatchUpdates:updateData reason:failureReason collectionView:collectionView];
         }
+        updateData = [validator reloadingUpdateDataForCollectionView:collectionView];
     }
-    [itemDeletes addObjectsFromArray:[reloadDeletePaths allObjects]];
-    [itemInserts addObjectsFromArray:[reloadInsertPaths allObjects]];
 
-    IGListBatchUpdateData *updateData = [[IGListBatchUpdateData alloc] initWithInsertSections:inserts
-                                                                               deleteSections:deletes
-                                                                                 moveSections:moves
-                                                                             insertIndexPaths:itemInserts
-                                                                             deleteIndexPaths:itemDeletes
-                                                                               moveIndexPaths:itemMoves];
+    const uint64_t trace = IGListTraceBegin();
     [collectionView ig_applyBatchUpdateData:updateData];
+    IGListTraceEnd(trace, "applyBatchUpdateData", diffResult.changeCount);
     return updateData;
 }
 
@@ -338,9 +575,11 @@ void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
     // destroy reloadData state
     self.reloadUpdates = nil;
     self.queuedReloadData = NO;
+    self.hasDeferredOffscreenUpdates = NO;
 
     // remove indexpath/item changes
     self.objectTransitionBlock = nil;
+    self.delta = nil;
 
     // removes all object completion blocks. done before updates to start collecting completion blocks for coalesced
     // or re-entrant object updates
@@ -348,7 +587,8 @@ void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
 }
 
 - (void)cleanStateAfterUpdates {
-    self.batchUpdates = [IGListBatchUpdates new];
+    // the recorder keeps its storage, so batches of a similar size stop allocating
+    [self.batchUpdates reset];
 }
 
 - (void)queueUpdateWithCollectionView:(UICollectionView *)collectionView {
@@ -359,14 +599,24 @@ void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
         return;
     }
 
+    // the scheduled update re-checks the state when it runs, so one pending update covers every call until then
+    if (self.updateScheduled) {
+        return;
+    }
+    self.updateScheduled = YES;
+    self.scheduledCollectionView = collectionView;
+
     __weak __typeof__(self) weakSelf = self;
     __weak __typeof__(collectionView) weakCollectionView = collectionView;
 
-    // dispatch_async to give the main queue time to collect more batch updates so that a minimum amount of work
-    // (diffing, etc) is done on main. dispatch_async does not garauntee a full runloop turn will pass though.
+    // defer to the scheduler to give the main queue time to collect more batch updates so that a minimum amount of work
+    // (diffing, etc) is done on main. the default scheduler dispatch_asyncs, which does not guarantee a full runloop
+    // turn will pass; IGListFrameUpdateScheduler waits for the next frame.
     // see -performUpdateWithCollectionView:fromObjects:toObjects:animated:]objectTransitionBlock:completion: for more
     // details on how coalescence is done.
-    dispatch_async(dispatch_get_main_queue(), ^{
+    void (^update)(void) = ^{
+        weakSelf.updateScheduled = NO;
+        weakSelf.scheduledCollectionView = nil;
         if (weakSelf.state != IGListBatchUpdateStateIdle
             || ![weakSelf hasChanges]) {
             return;
@@ -377,7 +627,35 @@ void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
         } else {
             [weakSelf performBatchUpdatesWithCollectionView:weakCollectionView];
         }
-    });
+    };
+
+    IGListUpdateCoordinator *coordinator = self.coordinator;
+    if (coordinator != nil) {
+        [coordinator scheduleUpdateForUpdater:self collectionView:collectionView block:update];
+    } else {
+        [self.scheduler scheduleUpdate:update];
+    }
+}
+
+// the pending update may never run once its scheduler or coordinator is replaced, so queue it again on the current one.
+// if the previous one still runs it, the update finds nothing left to do
+- (void)rescheduleUpdate {
+    IGAssertMainThread();
+    if (!self.updateScheduled) {
+        return;
+    }
+    self.updateScheduled = NO;
+    [self queueUpdateWithCollectionView:self.scheduledCollectionView];
+}
+
+- (void)setScheduler:(id<IGListUpdateScheduler>)scheduler {
+    IGAssertMainThread();
+    IGParameterAssert(scheduler != nil);
+    if (_scheduler == scheduler) {
+        return;
+    }
+    _scheduler = scheduler;
+    [self rescheduleUpdate];
 }
 
 
@@ -408,18 +686,83 @@ static NSUInteger IGListIdentifierHash(const void *item, NSUInteger (*size)(cons
                                animated:(BOOL)animated
                   objectTransitionBlock:(void (^)(NSArray *))objectTransitionBlock
                              completion:(nullable void (^)(BOOL))completion {
+    IGParameterAssert(objectTransitionBlock != nil);
+    [self queueObjectUpdateWithCollectionView:collectionView
+                                  fromObjects:fromObjects
+                                    toObjects:toObjects
+                                        delta:nil
+                                     animated:animated
+                        objectTransitionBlock:^(NSArray *transitionToObjects, IGListIndexSetResult *delta) {
+                            objectTransitionBlock(transitionToObjects);
+                        }
+                                   completion:completion];
+}
+
+- (void)performUpdateWithCollectionView:(UICollectionView *)collectionView
+                            fromObjects:(nullable NSArray *)fromObjects
+                              toObjects:(NSArray *)toObjects
+                                  delta:(nullable IGListIndexSetResult *)delta
+                               animated:(BOOL)animated
+                  objectTransitionBlock:(IGListObjectDeltaTransitionBlock)objectTransitionBlock
+                             completion:(nullable IGListUpdatingCompletion)completion {
+    IGParameterAssert(toObjects != nil);
+    [self queueObjectUpdateWithCollectionView:collectionView
+                                  fromObjects:fromObjects
+                                    toObjects:toObjects
+                                        delta:delta
+                                     animated:animated
+                        objectTransitionBlock:objectTransitionBlock
+                                   completion:completion];
+}
+
+- (void)queueObjectUpdateWithCollectionView:(UICollectionView *)collectionView
+                                fromObjects:(nullable NSArray *)fromObjects
+                                  toObjects:(nullable NSArray *)toObjects
+                                      delta:(nullable IGListIndexSetResult *)delta
+                                   animated:(BOOL)animated
+                      objectTransitionBlock:(IGListObjectDeltaTransitionBlock)objectTransitionBlock
+                                 completion:(nullable IGListUpdatingCompletion)completion {
     IGAssertMainThread();
     IGParameterAssert(collectionView != nil);
     IGParameterAssert(objectTransitionBlock != nil);
 
+    // newer objects arrived while the last update was still diffing. drop that diff and diff once to the newest objects
+    if (self.diffExecutor.isDiffing) {
+        [self reclaimDiffingUpdate];
+    }
+
+    // while a batch is in flight only the latest toObjects are kept, so intermediate states are never diffed
+    if (self.state != IGListBatchUpdateStateIdle) {
+        self.backlogCount++;
+    }
+
     // only update the items that we are coming from if it has not been set
     // this allows multiple updates to be called while an update is already in progress, and the transition from > to
     // will be done on the first "fromObjects" received and the last "toObjects"
     // if performBatchUpdates: hasn't applied the update block, then data source hasn't transitioned its state. if an
     // update is queued in between then we must use the pending toObjects
+    const BOOL coalesces = self.fromObjects != nil || self.toObjects != nil;
+    NSArray *queuedToObjects = self.toObjects;
     self.fromObjects = self.fromObjects ?: self.pendingTransitionToObjects ?: fromObjects;
     self.toObjects = toObjects;
 
+    // a delta only describes the transition from the objects the data source has when the update is applied. once
+    // another object update is merged in, the deltas are composed if both come from a diff, otherwise the merged update
+    // is diffed instead
+    if (coalesces) {
+        IGListIndexSetResult *queuedDelta = self.delta;
+        const BOOL composes = queuedDelta.hasIdentifiers
+        && delta.hasIdentifiers
+        && [delta failureReasonForDeltaFromCount:queuedToObjects.count toCount:toObjects.count] == nil;
+        self.delta = composes ? [queuedDelta resultByComposingResult:delta] : nil;
+    } else {
+        NSString *deltaFailureReason = delta != nil
+        ? [delta failureReasonForDeltaFromCount:self.fromObjects.count toCount:toObjects.count]
+        : nil;
+        IGAssert(deltaFailureReason == nil, @"Delta cannot be applied: %@", deltaFailureReason);
+        self.delta = deltaFailureReason != nil ? nil : delta;
+    }
+
     // disabled animations will always take priority
     // reset to YES in -cleanupState
     self.queuedUpdateIsAnimated = self.queuedUpdateIsAnimated && animated;
@@ -477,7 +820,7 @@ static NSUInteger IGListIdentifierHash(const void *item, NSUInteger (*size)(cons
     IGParameterAssert(collectionView != nil);
     IGParameterAssert(indexPaths != nil);
     if (self.state == IGListBatchUpdateStateExecutingBatchUpdateBlock) {
-        [self.batchUpdates.itemInserts addObjectsFromArray:indexPaths];
+        [self.batchUpdates recordItemInserts:indexPaths];
     } else {
         [self.delegate listAdapterUpdater:self willInsertIndexPaths:indexPaths collectionView:collectionView];
         [collectionView insertItemsAtIndexPaths:indexPaths];
@@ -489,7 +832,7 @@ static NSUInteger IGListIdentifierHash(const void *item, NSUInteger (*size)(cons
     IGParameterAssert(collectionView != nil);
     IGParameterAssert(indexPaths != nil);
     if (self.state == IGListBatchUpdateStateExecutingBatchUpdateBlock) {
-        [self.batchUpdates.itemDeletes addObjectsFromArray:indexPaths];
+        [self.batchUpdates recordItemDeletes:indexPaths];
     } else {
         [self.delegate listAdapterUpdater:self willDeleteIndexPaths:indexPaths collectionView:collectionView];
         [collectionView deleteItemsAtIndexPaths:indexPaths];
@@ -500,8 +843,7 @@ static NSUInteger IGListIdentifierHash(const void *item, NSUInteger (*size)(cons
                    fromIndexPath:(NSIndexPath *)fromIndexPath
                      toIndexPath:(NSIndexPath *)toIndexPath {
     if (self.state == IGListBatchUpdateStateExecutingBatchUpdateBlock) {
-        IGListMoveIndexPath *move = [[IGListMoveIndexPath alloc] initWithFrom:fromIndexPath to:toIndexPath];
-        [self.batchUpdates.itemMoves addObject:move];
+        [self.batchUpdates recordItemMoveFromIndexPath:fromIndexPath toIndexPath:toIndexPath];
     } else {
         [self.delegate listAdapterUpdater:self willMoveFromIndexPath:fromIndexPath toIndexPath:toIndexPath collectionView:collectionView];
         [collectionView moveItemAtIndexPath:fromIndexPath toIndexPath:toIndexPath];
@@ -512,13 +854,27 @@ static NSUInteger IGListIdentifierHash(const void *item, NSUInteger (*size)(cons
                      fromIndexPath:(NSIndexPath *)fromIndexPath
                        toIndexPath:(NSIndexPath *)toIndexPath {
     if (self.state == IGListBatchUpdateStateExecutingBatchUpdateBlock) {
-        IGListReloadIndexPath *reload = [[IGListReloadIndexPath alloc] initWithFromIndexPath:fromIndexPath toIndexPath:toIndexPath];
-        [self.batchUpdates.itemReloads addObject:reload];
+        [self.batchUpdates recordItemReloadFromIndexPath:fromIndexPath toIndexPath:toIndexPath];
     } else {
         [collectionView reloadItemsAtIndexPaths:@[fromIndexPath]];
     }
 }
 
+- (void)reloadItemsInCollectionView:(UICollectionView *)collectionView
+                        fromSection:(NSInteger)fromSection
+                          toSection:(NSInteger)toSection
+                            indexes:(NSIndexSet *)indexes {
+    if (self.state == IGListBatchUpdateStateExecutingBatchUpdateBlock) {
+        [self.batchUpdates recordItemReloadsFromSection:fromSection toSection:toSection indexes:indexes];
+    } else {
+        NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+        [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            [indexPaths addObject:[NSIndexPath indexPathForItem:index inSection:fromSection]];
+        }];
+        [collectionView reloadItemsAtIndexPaths:indexPaths];
+    }
+}
+
 - (void)reloadDataWithCollectionView:(UICollectionView *)collectionView
                    reloadUpdateBlock:(IGListReloadUpdateBlock)reloadUpdateBlock
                           completion:(nullable IGListUpdatingCompletion)completion {
@@ -541,7 +897,7 @@ static NSUInteger IGListIdentifierHash(const void *item, NSUInteger (*size)(cons
     IGParameterAssert(collectionView != nil);
     IGParameterAssert(sections != nil);
     if (self.state == IGListBatchUpdateStateExecutingBatchUpdateBlock) {
-        [self.batchUpdates.sectionReloads addIndexes:sections];
+        [self.batchUpdates.sectionReloads unionIndexSet:[IGListRunIndexSet indexSetWithIndexSet:sections]];
     } else {
         [self.delegate listAdapterUpdater:self willReloadSections:sections collectionView:collectionView];
         [collectionView reloadSections:sections];
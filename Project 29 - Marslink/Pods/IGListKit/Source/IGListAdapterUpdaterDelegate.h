@@ -10,8 +10,10 @@
 #import <UIKit/UIKit.h>
 
 #import <IGListKit/IGListBatchUpdateData.h>
+#import <IGListKit/IGListHashQualityReport.h>
 
 @class IGListAdapterUpdater;
+@class IGListUpdateCostModel;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -140,6 +142,54 @@ NS_SWIFT_NAME(ListAdapterUpdaterDelegate)
                  toObjects:(nullable NSArray *)toObjects
                    updates:(IGListBatchUpdateData *)updates;
 
+@optional
+
+/**
+ Notifies the delegate that the updater sampled the hash quality of the objects it is about to diff.
+
+ @param listAdapterUpdater The adapter updater owning the transition.
+ @param report The distribution of the objects' identifiers in the diffing symbol table.
+ @param fromObjects The items transitioned from in the diff, if any.
+ @param toObjects The items transitioned to in the diff, if any.
+
+ @note This event is only sent when `-[IGListAdapterUpdater hashQualitySampleInterval]` is greater than zero. Check
+ `report.isPathological` and `report.offendingClasses` to find models whose identifiers need a better `-hash`.
+ */
+- (void)listAdapterUpdater:(IGListAdapterUpdater *)listAdapterUpdater
+     didAnalyzeHashQuality:(IGListHashQualityReport *)report
+               fromObjects:(nullable NSArray *)fromObjects
+                 toObjects:(nullable NSArray *)toObjects;
+
+/**
+ Notifies the delegate that a batch update failed validation and every section will be reloaded instead.
+
+ @param listAdapterUpdater The adapter updater owning the transition.
+ @param updates The batch updates that would have thrown.
+ @param reason A description of the consistency rule the updates violate.
+ @param collectionView The collection view being updated.
+
+ @note This event is only sent when `-[IGListAdapterUpdater validatesBatchUpdates]` is enabled.
+ */
+- (void)listAdapterUpdater:(IGListAdapterUpdater *)listAdapterUpdater
+     didRejectBatchUpdates:(IGListBatchUpdateData *)updates
+                    reason:(NSString *)reason
+            collectionView:(UICollectionView *)collectionView;
+
+/**
+ Notifies the delegate that the updater measured how long applying an update took.
+
+ @param listAdapterUpdater The adapter updater owning the transition.
+ @param duration The time spent on the main thread applying the update, in seconds.
+ @param reloadedData `YES` if the update reloaded data, `NO` if it performed batch updates.
+ @param costModel The model the duration was recorded into.
+
+ @note This event is only sent when the `IGListExperimentReloadDataFallback` experiment is enabled.
+ */
+- (void)listAdapterUpdater:(IGListAdapterUpdater *)listAdapterUpdater
+  didMeasureUpdateDuration:(NSTimeInterval)duration
+              reloadedData:(BOOL)reloadedData
+                 costModel:(IGListUpdateCostModel *)costModel;
+
 @end
 
 NS_ASSUME_NONNULL_END
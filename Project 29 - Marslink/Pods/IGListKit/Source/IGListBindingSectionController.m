@@ -123,6 +123,16 @@ typedef NS_ENUM(NSInteger, IGListDiffingSectionState) {
     }
 }
 
+- (void)prepareForReuse {
+    [super prepareForReuse];
+
+    // the next object must load its view models instead of diffing against the previous object's, and an update still
+    // queued for the previous object is skipped
+    self.object = nil;
+    self.viewModels = nil;
+    self.state = IGListDiffingSectionStateIdle;
+}
+
 - (void)didSelectItemAtIndex:(NSInteger)index {
     [self.selectionDelegate sectionController:self didSelectItemAtIndex:index viewModel:self.viewModels[index]];
 }
@@ -14,6 +14,8 @@
 
 #import <IGListKit/IGListAssert.h>
 
+#import "IGListTracing.h"
+
 static CGFloat UIEdgeInsetsLeadingInsetInDirection(UIEdgeInsets insets, UICollectionViewScrollDirection direction) {
     switch (direction) {
         case UICollectionViewScrollDirectionVertical: return insets.top;
@@ -366,7 +368,9 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
 
 - (void)prepareLayout {
     if (_cachedLayoutInvalid) {
+        const uint64_t trace = IGListTraceBegin();
         [self cacheLayout];
+        IGListTraceEnd(trace, "cacheLayout", _sectionData.size());
     }
 }
 
@@ -0,0 +1,26 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdateClock.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A clock driven by a `CADisplayLink` on the main run loop. The display link only runs while a frame handler is set.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListDisplayLinkClock)
+@interface IGListDisplayLinkClock : NSObject <IGListUpdateClock>
+
+@end
+
+NS_ASSUME_NONNULL_END
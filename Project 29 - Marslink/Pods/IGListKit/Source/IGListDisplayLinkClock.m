@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListDisplayLinkClock.h"
+
+#import <IGListKit/IGListAssert.h>
+
+// CADisplayLink retains its target, so it targets this instead of the clock to let the clock deallocate
+@interface IGListDisplayLinkTarget : NSObject
+
+@property (nonatomic, copy) void (^frameHandler)(CFTimeInterval timestamp);
+
+@end
+
+@implementation IGListDisplayLinkTarget
+
+- (void)onFrame:(CADisplayLink *)displayLink {
+    if (self.frameHandler != nil) {
+        self.frameHandler(displayLink.timestamp);
+    }
+}
+
+@end
+
+@implementation IGListDisplayLinkClock {
+    IGListDisplayLinkTarget *_target;
+    CADisplayLink *_displayLink;
+}
+
+- (void)dealloc {
+    [_displayLink invalidate];
+}
+
+- (CFTimeInterval)currentTime {
+    return CACurrentMediaTime();
+}
+
+- (void)setFrameHandler:(void (^)(CFTimeInterval))frameHandler {
+    IGAssertMainThread();
+
+    if (frameHandler == nil) {
+        [_displayLink invalidate];
+        _displayLink = nil;
+        _target = nil;
+        return;
+    }
+
+    if (_displayLink == nil) {
+        _target = [IGListDisplayLinkTarget new];
+        _displayLink = [CADisplayLink displayLinkWithTarget:_target selector:@selector(onFrame:)];
+        [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    _target.frameHandler = frameHandler;
+}
+
+@end
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <QuartzCore/QuartzCore.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdateClock.h>
+#import <IGListKit/IGListUpdateScheduler.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Runs queued updates at the start of the next frame, so a data source that changes many times per frame produces at
+ most one diff and one apply per updater per frame.
+
+ Updates run in the order they were scheduled. Once the updates run in a frame have used up `frameBudget`, the rest wait
+ for the next frame. At least one update runs every frame, so an update that exceeds the budget on its own still makes
+ progress. Updates scheduled while a frame is running wait for the next frame.
+
+ Share one scheduler between adapters to enforce the budget across all of them.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListFrameUpdateScheduler)
+@interface IGListFrameUpdateScheduler : NSObject <IGListUpdateScheduler>
+
+/**
+ The clock providing frames and measuring time.
+ */
+@property (nonatomic, strong, readonly) id<IGListUpdateClock> clock;
+
+/**
+ The time updates may use per frame before the remaining updates are deferred, in seconds.
+ */
+@property (nonatomic, assign) CFTimeInterval frameBudget;
+
+/**
+ The number of updates waiting for a frame.
+ */
+@property (nonatomic, assign, readonly) NSInteger pendingUpdateCount;
+
+/**
+ The number of times an update was deferred to a later frame because the budget was used up.
+ */
+@property (nonatomic, assign, readonly) NSInteger deferredUpdateCount;
+
+/**
+ Creates a scheduler.
+
+ @param clock The clock providing frames and measuring time.
+ @param frameBudget The time updates may use per frame, in seconds.
+
+ @return A new scheduler.
+ */
+- (instancetype)initWithClock:(id<IGListUpdateClock>)clock frameBudget:(CFTimeInterval)frameBudget NS_DESIGNATED_INITIALIZER;
+
+/**
+ Creates a scheduler driven by an `IGListDisplayLinkClock` with a budget of half a 60Hz frame.
+ */
+- (instancetype)init;
+
+@end
+
+NS_ASSUME_NONNULL_END
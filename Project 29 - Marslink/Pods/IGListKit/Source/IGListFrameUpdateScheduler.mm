@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListFrameUpdateScheduler.h"
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListDisplayLinkClock.h>
+
+#import "IGListFrameSchedule.h"
+
+using namespace IGListKit;
+
+@implementation IGListFrameUpdateScheduler {
+    IGListFrameQueue<void (^)(void)> _pendingUpdates;
+    BOOL _waitingForFrame;
+}
+
+- (instancetype)initWithClock:(id<IGListUpdateClock>)clock frameBudget:(CFTimeInterval)frameBudget {
+    IGParameterAssert(clock != nil);
+    if (self = [super init]) {
+        _clock = clock;
+        _frameBudget = frameBudget;
+    }
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithClock:[IGListDisplayLinkClock new] frameBudget:1.0 / 120.0];
+}
+
+- (void)dealloc {
+    [_clock setFrameHandler:nil];
+}
+
+- (NSInteger)pendingUpdateCount {
+    return _pendingUpdates.size();
+}
+
+- (NSInteger)deferredUpdateCount {
+    return _pendingUpdates.deferredCount();
+}
+
+- (void)scheduleUpdate:(void (^)(void))update {
+    IGAssertMainThread();
+    IGParameterAssert(update != nil);
+
+    _pendingUpdates.push([update copy]);
+    if (!_waitingForFrame) {
+        _waitingForFrame = YES;
+        __weak __typeof__(self) weakSelf = self;
+        [self.clock setFrameHandler:^(CFTimeInterval timestamp) {
+            [weakSelf runFrame];
+        }];
+    }
+}
+
+- (void)runFrame {
+    IGAssertMainThread();
+
+    id<IGListUpdateClock> clock = self.clock;
+    _pendingUpdates.runFrame(self.frameBudget, [clock]() {
+        return [clock currentTime];
+    }, [](void (^update)(void)) {
+        update();
+    });
+
+    // stop frame callbacks while idle
+    if (_pendingUpdates.empty()) {
+        _waitingForFrame = NO;
+        [clock setFrameHandler:nil];
+    }
+}
+
+@end
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdatingDelegate.h>
+
+@class IGListUpdateJournal;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An updater that records every call it receives into a journal before forwarding it to another updater. Calls made
+ inside an item update block are recorded as part of that block, so a replay runs them when the replayed updater runs
+ the block.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListJournalingUpdater)
+@interface IGListJournalingUpdater : NSObject <IGListUpdatingDelegate>
+
+/**
+ The updater that calls are forwarded to.
+ */
+@property (nonatomic, strong, readonly) id<IGListUpdatingDelegate> updater;
+
+/**
+ The journal that calls are recorded into.
+ */
+@property (nonatomic, strong, readonly) IGListUpdateJournal *journal;
+
+/**
+ Creates a new journaling updater.
+
+ @param updater The updater to forward calls to.
+ @param journal The journal to record calls into.
+
+ @return A new journaling updater.
+ */
+- (instancetype)initWithUpdater:(id<IGListUpdatingDelegate>)updater
+                        journal:(IGListUpdateJournal *)journal NS_DESIGNATED_INITIALIZER;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
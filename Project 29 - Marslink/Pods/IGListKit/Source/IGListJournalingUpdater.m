@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListJournalingUpdater.h"
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListUpdateJournal.h>
+
+#import "IGListUpdateJournalInternal.h"
+
+@implementation IGListJournalingUpdater
+
+- (instancetype)initWithUpdater:(id<IGListUpdatingDelegate>)updater journal:(IGListUpdateJournal *)journal {
+    IGParameterAssert(updater != nil);
+    IGParameterAssert(journal != nil);
+    if (self = [super init]) {
+        _updater = updater;
+        _journal = journal;
+    }
+    return self;
+}
+
+#pragma mark - NSObject
+
+- (BOOL)respondsToSelector:(SEL)aSelector {
+    // only claim the optional methods the wrapped updater implements, so callers fall back the same way
+    if (aSelector == @selector(performUpdateWithCollectionView:fromObjects:toObjects:delta:animated:objectTransitionBlock:completion:)
+        || aSelector == @selector(reloadItemsInCollectionView:fromSection:toSection:indexes:)) {
+        return [self.updater respondsToSelector:aSelector];
+    }
+    return [super respondsToSelector:aSelector];
+}
+
+#pragma mark - IGListUpdatingDelegate
+
+- (NSPointerFunctions *)objectLookupPointerFunctions {
+    return [self.updater objectLookupPointerFunctions];
+}
+
+- (void)performUpdateWithCollectionView:(UICollectionView *)collectionView
+                            fromObjects:(NSArray<id<IGListDiffable>> *)fromObjects
+                              toObjects:(NSArray<id<IGListDiffable>> *)toObjects
+                               animated:(BOOL)animated
+                  objectTransitionBlock:(IGListObjectTransitionBlock)objectTransitionBlock
+                             completion:(IGListUpdatingCompletion)completion {
+    [self.journal recordUpdateFromObjects:fromObjects toObjects:toObjects delta:nil animated:animated];
+    [self.updater performUpdateWithCollectionView:collectionView
+                                      fromObjects:fromObjects
+                                        toObjects:toObjects
+                                         animated:animated
+                            objectTransitionBlock:objectTransitionBlock
+                                       completion:completion];
+}
+
+- (void)performUpdateWithCollectionView:(UICollectionView *)collectionView
+                            fromObjects:(NSArray<id<IGListDiffable>> *)fromObjects
+                              toObjects:(NSArray<id<IGListDiffable>> *)toObjects
+                                  delta:(IGListIndexSetResult *)delta
+                               animated:(BOOL)animated
+                  objectTransitionBlock:(IGListObjectDeltaTransitionBlock)objectTransitionBlock
+                             completion:(IGListUpdatingCompletion)completion {
+    [self.journal recordUpdateFromObjects:fromObjects toObjects:toObjects delta:delta animated:animated];
+    [self.updater performUpdateWithCollectionView:collectionView
+                                      fromObjects:fromObjects
+                                        toObjects:toObjects
+                                            delta:delta
+                                         animated:animated
+                            objectTransitionBlock:objectTransitionBlock
+                                       completion:completion];
+}
+
+- (void)insertItemsIntoCollectionView:(UICollectionView *)collectionView indexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    [self.journal recordInsertItemsAtIndexPaths:indexPaths];
+    [self.updater insertItemsIntoCollectionView:collectionView indexPaths:indexPaths];
+}
+
+- (void)deleteItemsFromCollectionView:(UICollectionView *)collectionView indexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    [self.journal recordDeleteItemsAtIndexPaths:indexPaths];
+    [self.updater deleteItemsFromCollectionView:collectionView indexPaths:indexPaths];
+}
+
+- (void)moveItemInCollectionView:(UICollectionView *)collectionView
+                   fromIndexPath:(NSIndexPath *)fromIndexPath
+                     toIndexPath:(NSIndexPath *)toIndexPath {
+    [self.journal recordMoveItemFromIndexPath:fromIndexPath toIndexPath:toIndexPath];
+    [self.updater moveItemInCollectionView:collectionView fromIndexPath:fromIndexPath toIndexPath:toIndexPath];
+}
+
+- (void)reloadItemInCollectionView:(UICollectionView *)collectionView
+                     fromIndexPath:(NSIndexPath *)fromIndexPath
+                       toIndexPath:(NSIndexPath *)toIndexPath {
+    [self.journal recordReloadItemFromIndexPath:fromIndexPath toIndexPath:toIndexPath];
+    [self.updater reloadItemInCollectionView:collectionView fromIndexPath:fromIndexPath toIndexPath:toIndexPath];
+}
+
+- (void)reloadItemsInCollectionView:(UICollectionView *)collectionView
+                        fromSection:(NSInteger)fromSection
+                          toSection:(NSInteger)toSection
+                            indexes:(NSIndexSet *)indexes {
+    [self.journal recordReloadItemsFromSection:fromSection toSection:toSection indexes:indexes];
+    [self.updater reloadItemsInCollectionView:collectionView fromSection:fromSection toSection:toSection indexes:indexes];
+}
+
+- (void)reloadDataWithCollectionView:(UICollectionView *)collectionView
+                   reloadUpdateBlock:(IGListReloadUpdateBlock)reloadUpdateBlock
+                          completion:(IGListUpdatingCompletion)completion {
+    [self.journal recordReloadData];
+    [self.updater reloadDataWithCollectionView:collectionView reloadUpdateBlock:reloadUpdateBlock completion:completion];
+}
+
+- (void)reloadCollectionView:(UICollectionView *)collectionView sections:(NSIndexSet *)sections {
+    [self.journal recordReloadSections:sections];
+    [self.updater reloadCollectionView:collectionView sections:sections];
+}
+
+- (void)performUpdateWithCollectionView:(UICollectionView *)collectionView
+                               animated:(BOOL)animated
+                            itemUpdates:(IGListItemUpdateBlock)itemUpdates
+                             completion:(IGListUpdatingCompletion)completion {
+    IGListUpdateJournal *journal = self.journal;
+    const uint64_t blockID = [journal recordItemUpdatesAnimated:animated];
+    [self.updater performUpdateWithCollectionView:collectionView
+                                         animated:animated
+                                      itemUpdates:^{
+                                          [journal beginItemUpdateBlock:blockID];
+                                          itemUpdates();
+                                          [journal endItemUpdateBlock];
+                                      }
+                                       completion:completion];
+}
+
+@end
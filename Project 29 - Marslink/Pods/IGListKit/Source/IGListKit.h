@@ -36,14 +36,26 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import <IGListKit/IGListBindable.h>
 #import <IGListKit/IGListCollectionContext.h>
 #import <IGListKit/IGListDisplayDelegate.h>
+#import <IGListKit/IGListDisplayLinkClock.h>
 #import <IGListKit/IGListExperiments.h>
+#import <IGListKit/IGListFrameUpdateScheduler.h>
 #import <IGListKit/IGListGenericSectionController.h>
+#import <IGListKit/IGListJournalingUpdater.h>
+#import <IGListKit/IGListMainQueueUpdateScheduler.h>
 #import <IGListKit/IGListSectionController.h>
 #import <IGListKit/IGListReloadDataUpdater.h>
 #import <IGListKit/IGListScrollDelegate.h>
+#import <IGListKit/IGListSimulatedCollectionView.h>
 #import <IGListKit/IGListSingleSectionController.h>
 #import <IGListKit/IGListStackedSectionController.h>
 #import <IGListKit/IGListSupplementaryViewSource.h>
+#import <IGListKit/IGListTracer.h>
+#import <IGListKit/IGListUpdateClock.h>
+#import <IGListKit/IGListUpdateCoordinator.h>
+#import <IGListKit/IGListUpdateCostModel.h>
+#import <IGListKit/IGListUpdateJournal.h>
+#import <IGListKit/IGListUpdateJournalReplayer.h>
+#import <IGListKit/IGListUpdateScheduler.h>
 #import <IGListKit/IGListUpdatingDelegate.h>
 #import <IGListKit/IGListCollectionViewLayout.h>
 #import <IGListKit/IGListWorkingRangeDelegate.h>
@@ -56,10 +68,13 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import <IGListKit/IGListBatchUpdateData.h>
 #import <IGListKit/IGListDiff.h>
 #import <IGListKit/IGListDiffable.h>
+#import <IGListKit/IGListDiffKeys.h>
 #import <IGListKit/IGListExperiments.h>
+#import <IGListKit/IGListHashQualityReport.h>
 #import <IGListKit/IGListIndexPathResult.h>
 #import <IGListKit/IGListIndexSetResult.h>
 #import <IGListKit/IGListMoveIndex.h>
 #import <IGListKit/IGListMoveIndexPath.h>
+#import <IGListKit/IGListMovePlanning.h>
 #import <IGListKit/NSNumber+IGListDiffable.h>
 #import <IGListKit/NSString+IGListDiffable.h>
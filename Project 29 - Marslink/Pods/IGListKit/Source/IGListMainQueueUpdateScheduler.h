@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdateScheduler.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Runs each update in its own `dispatch_async` to the main queue. Updates queued in the same turn of the main queue are
+ coalesced, but nothing guarantees a full run loop turn or a frame passes before the update runs.
+
+ This is the default scheduler of `IGListAdapterUpdater`.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListMainQueueUpdateScheduler)
+@interface IGListMainQueueUpdateScheduler : NSObject <IGListUpdateScheduler>
+
+@end
+
+NS_ASSUME_NONNULL_END
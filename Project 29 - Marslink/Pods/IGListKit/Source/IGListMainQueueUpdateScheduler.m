@@ -0,0 +1,21 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListMainQueueUpdateScheduler.h"
+
+#import <IGListKit/IGListAssert.h>
+
+@implementation IGListMainQueueUpdateScheduler
+
+- (void)scheduleUpdate:(void (^)(void))update {
+    IGParameterAssert(update != nil);
+    dispatch_async(dispatch_get_main_queue(), update);
+}
+
+@end
@@ -10,6 +10,7 @@
 #import <UIKit/UIKit.h>
 
 #import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdateScheduler.h>
 #import <IGListKit/IGListUpdatingDelegate.h>
 
 NS_ASSUME_NONNULL_BEGIN
@@ -18,12 +19,30 @@ NS_ASSUME_NONNULL_BEGIN
  An `IGListReloadDataUpdater` is a concrete type that conforms to `IGListUpdatingDelegate`.
  It is an out-of-box updater for `IGListAdapter` objects to use.
 
- @note This updater performs simple, synchronous updates using `-[UICollectionView reloadData]`.
+ @note This updater performs simple, synchronous updates using `-[UICollectionView reloadData]`, or coalesced ones if
+ `coalescesReloads` is set.
  */
 IGLK_SUBCLASSING_RESTRICTED
 NS_SWIFT_NAME(ListReloadDataUpdater)
 @interface IGListReloadDataUpdater : NSObject <IGListUpdatingDelegate>
 
+/**
+ A flag indicating whether calls are coalesced into a single reload. The default value is `NO`, which reloads the
+ collection view synchronously for every call.
+
+ @note While coalescing, object transitions, item updates and completion blocks wait for the scheduler. Every call made
+ before it runs is applied at once. If the number of sections and items is unchanged, only the visible cells of the
+ sections that were touched are reloaded, without animation. Otherwise, and after any object transition or call to
+ reload data, the whole collection view is reloaded.
+ */
+@property (nonatomic, assign) BOOL coalescesReloads;
+
+/**
+ Decides when coalesced reloads are applied. The default value is an `IGListFrameUpdateScheduler`, which applies them at
+ the start of the next frame.
+ */
+@property (nonatomic, strong) id<IGListUpdateScheduler> scheduler;
+
 @end
 
 NS_ASSUME_NONNULL_END
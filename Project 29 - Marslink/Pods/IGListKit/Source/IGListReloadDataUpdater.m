@@ -9,7 +9,52 @@
 
 #import <IGListKit/IGListReloadDataUpdater.h>
 
-@implementation IGListReloadDataUpdater
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListFrameUpdateScheduler.h>
+
+static BOOL IGListCollectionViewCountsMatchDataSource(UICollectionView *collectionView) {
+    id<UICollectionViewDataSource> dataSource = collectionView.dataSource;
+    const NSInteger sectionCount = [dataSource respondsToSelector:@selector(numberOfSectionsInCollectionView:)]
+    ? [dataSource numberOfSectionsInCollectionView:collectionView]
+    : 1;
+    // the collection view still reports the counts it last loaded until it is reloaded or batch updated
+    if (sectionCount != [collectionView numberOfSections]) {
+        return NO;
+    }
+    for (NSInteger section = 0; section < sectionCount; section++) {
+        if ([dataSource collectionView:collectionView numberOfItemsInSection:section]
+            != [collectionView numberOfItemsInSection:section]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+@implementation IGListReloadDataUpdater {
+    // calls waiting for the next coalesced reload
+    IGListReloadUpdateBlock _pendingReloadUpdateBlock;
+    IGListObjectTransitionBlock _pendingObjectTransitionBlock;
+    NSArray *_pendingToObjects;
+    NSMutableArray<IGListItemUpdateBlock> *_pendingItemUpdateBlocks;
+    NSMutableArray<IGListUpdatingCompletion> *_pendingCompletionBlocks;
+    // sections with inserted, deleted, moved or reloaded items
+    NSMutableIndexSet *_touchedItemSections;
+    // sections reloaded as a whole
+    NSMutableIndexSet *_reloadedSections;
+    BOOL _reloadScheduled;
+    BOOL _applyingReload;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _scheduler = [IGListFrameUpdateScheduler new];
+        _pendingItemUpdateBlocks = [NSMutableArray new];
+        _pendingCompletionBlocks = [NSMutableArray new];
+        _touchedItemSections = [NSMutableIndexSet new];
+        _reloadedSections = [NSMutableIndexSet new];
+    }
+    return self;
+}
 
 #pragma mark - IGListUpdatingDelegate
 
@@ -23,6 +68,15 @@
                                animated:(BOOL)animated
                   objectTransitionBlock:(IGListObjectTransitionBlock)objectTransitionBlock
                              completion:(IGListUpdatingCompletion)completion {
+    if (self.coalescesReloads) {
+        // only the newest objects are transitioned to
+        _pendingToObjects = toObjects;
+        _pendingObjectTransitionBlock = [objectTransitionBlock copy];
+        [self queueCompletion:completion];
+        [self scheduleReloadWithCollectionView:collectionView];
+        return;
+    }
+
     objectTransitionBlock(toObjects);
     [self synchronousReloadDataWithCollectionView:collectionView];
     if (completion) {
@@ -34,6 +88,13 @@
                                animated:(BOOL)animated
                             itemUpdates:(IGListItemUpdateBlock)itemUpdates
                              completion:(IGListUpdatingCompletion)completion {
+    if (self.coalescesReloads) {
+        [_pendingItemUpdateBlocks addObject:[itemUpdates copy]];
+        [self queueCompletion:completion];
+        [self scheduleReloadWithCollectionView:collectionView];
+        return;
+    }
+
     itemUpdates();
     [self synchronousReloadDataWithCollectionView:collectionView];
     if (completion) {
@@ -42,26 +103,48 @@
 }
 
 - (void)insertItemsIntoCollectionView:(UICollectionView *)collectionView indexPaths:(NSArray<NSIndexPath *> *)indexPaths {
-    [self synchronousReloadDataWithCollectionView:collectionView];
+    [self reloadItemSectionsOfIndexPaths:indexPaths collectionView:collectionView];
 }
 
 - (void)deleteItemsFromCollectionView:(UICollectionView *)collectionView indexPaths:(NSArray<NSIndexPath *> *)indexPaths {
-    [self synchronousReloadDataWithCollectionView:collectionView];
+    [self reloadItemSectionsOfIndexPaths:indexPaths collectionView:collectionView];
 }
 
 - (void)moveItemInCollectionView:(UICollectionView *)collectionView fromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
-    [self synchronousReloadDataWithCollectionView:collectionView];
+    [self reloadItemSectionsOfIndexPaths:@[fromIndexPath, toIndexPath] collectionView:collectionView];
 }
 
 - (void)reloadItemInCollectionView:(UICollectionView *)collectionView fromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    [self reloadItemSectionsOfIndexPaths:@[toIndexPath] collectionView:collectionView];
+}
+
+- (void)reloadItemsInCollectionView:(UICollectionView *)collectionView
+                        fromSection:(NSInteger)fromSection
+                          toSection:(NSInteger)toSection
+                            indexes:(NSIndexSet *)indexes {
+    if (self.coalescesReloads) {
+        [_touchedItemSections addIndex:toSection];
+        [self scheduleReloadWithCollectionView:collectionView];
+        return;
+    }
     [self synchronousReloadDataWithCollectionView:collectionView];
 }
 
 - (void)reloadItemsInCollectionView:(UICollectionView *)collectionView indexPaths:(NSArray<NSIndexPath *> *)indexPaths {
-    [self synchronousReloadDataWithCollectionView:collectionView];
+    [self reloadItemSectionsOfIndexPaths:indexPaths collectionView:collectionView];
 }
 
 - (void)reloadDataWithCollectionView:(UICollectionView *)collectionView reloadUpdateBlock:(IGListReloadUpdateBlock)reloadUpdateBlock completion:(IGListUpdatingCompletion)completion {
+    if (self.coalescesReloads) {
+        // the reload rebuilds everything from objects newer than any transition queued before it
+        _pendingReloadUpdateBlock = [reloadUpdateBlock copy];
+        _pendingObjectTransitionBlock = nil;
+        _pendingToObjects = nil;
+        [self queueCompletion:completion];
+        [self scheduleReloadWithCollectionView:collectionView];
+        return;
+    }
+
     reloadUpdateBlock();
     [self synchronousReloadDataWithCollectionView:collectionView];
     if (completion) {
@@ -70,12 +153,150 @@
 }
 
 - (void)reloadCollectionView:(UICollectionView *)collectionView sections:(NSIndexSet *)sections {
+    if (self.coalescesReloads) {
+        [_reloadedSections addIndexes:sections];
+        [self scheduleReloadWithCollectionView:collectionView];
+        return;
+    }
     [self synchronousReloadDataWithCollectionView:collectionView];
 }
 
+#pragma mark - Private API
+
 - (void)synchronousReloadDataWithCollectionView:(UICollectionView *)collectionView {
     [collectionView reloadData];
     [collectionView layoutIfNeeded];
 }
 
+- (void)reloadItemSectionsOfIndexPaths:(NSArray<NSIndexPath *> *)indexPaths collectionView:(UICollectionView *)collectionView {
+    if (!self.coalescesReloads) {
+        [self synchronousReloadDataWithCollectionView:collectionView];
+        return;
+    }
+    for (NSIndexPath *indexPath in indexPaths) {
+        [_touchedItemSections addIndex:indexPath.section];
+    }
+    [self scheduleReloadWithCollectionView:collectionView];
+}
+
+- (void)queueCompletion:(IGListUpdatingCompletion)completion {
+    if (completion != nil) {
+        [_pendingCompletionBlocks addObject:[completion copy]];
+    }
+}
+
+- (BOOL)hasPendingReload {
+    return _pendingReloadUpdateBlock != nil
+    || _pendingObjectTransitionBlock != nil
+    || _pendingItemUpdateBlocks.count > 0
+    || _pendingCompletionBlocks.count > 0
+    || _touchedItemSections.count > 0
+    || _reloadedSections.count > 0;
+}
+
+- (void)scheduleReloadWithCollectionView:(UICollectionView *)collectionView {
+    IGAssertMainThread();
+
+    // calls made while a reload is applied are picked up by it, or rescheduled once it finishes
+    if (_reloadScheduled || _applyingReload) {
+        return;
+    }
+    _reloadScheduled = YES;
+
+    __weak __typeof__(self) weakSelf = self;
+    __weak __typeof__(collectionView) weakCollectionView = collectionView;
+    [self.scheduler scheduleUpdate:^{
+        __typeof__(self) strongSelf = weakSelf;
+        if (strongSelf == nil) {
+            return;
+        }
+        strongSelf->_reloadScheduled = NO;
+        [strongSelf applyPendingReloadWithCollectionView:weakCollectionView];
+    }];
+}
+
+- (void)applyPendingReloadWithCollectionView:(UICollectionView *)collectionView {
+    IGAssertMainThread();
+
+    // bail early if the collection view has been deallocated in the time since the reload was scheduled
+    if (collectionView == nil) {
+        return;
+    }
+
+    IGListReloadUpdateBlock reloadUpdateBlock = _pendingReloadUpdateBlock;
+    IGListObjectTransitionBlock objectTransitionBlock = _pendingObjectTransitionBlock;
+    NSArray *toObjects = _pendingToObjects;
+    NSArray<IGListItemUpdateBlock> *itemUpdateBlocks = [_pendingItemUpdateBlocks copy];
+    NSArray<IGListUpdatingCompletion> *completionBlocks = [_pendingCompletionBlocks copy];
+    _pendingReloadUpdateBlock = nil;
+    _pendingObjectTransitionBlock = nil;
+    _pendingToObjects = nil;
+    [_pendingItemUpdateBlocks removeAllObjects];
+    [_pendingCompletionBlocks removeAllObjects];
+
+    _applyingReload = YES;
+    if (reloadUpdateBlock != nil) {
+        reloadUpdateBlock();
+    }
+    if (objectTransitionBlock != nil) {
+        objectTransitionBlock(toObjects);
+    }
+    for (IGListItemUpdateBlock itemUpdateBlock in itemUpdateBlocks) {
+        itemUpdateBlock();
+    }
+
+    // read after the item update blocks, which is where sections are usually touched
+    NSIndexSet *itemSections = [_touchedItemSections copy];
+    NSIndexSet *reloadedSections = [_reloadedSections copy];
+    [_touchedItemSections removeAllIndexes];
+    [_reloadedSections removeAllIndexes];
+
+    if (reloadUpdateBlock != nil
+        || objectTransitionBlock != nil
+        || collectionView.window == nil
+        || !IGListCollectionViewCountsMatchDataSource(collectionView)) {
+        [self synchronousReloadDataWithCollectionView:collectionView];
+    } else {
+        [self reloadVisibleItemsInSections:itemSections reloadedSections:reloadedSections collectionView:collectionView];
+    }
+    _applyingReload = NO;
+
+    for (IGListUpdatingCompletion completion in completionBlocks) {
+        completion(YES);
+    }
+
+    if ([self hasPendingReload]) {
+        [self scheduleReloadWithCollectionView:collectionView];
+    }
+}
+
+- (void)reloadVisibleItemsInSections:(NSIndexSet *)itemSections
+                    reloadedSections:(NSIndexSet *)reloadedSections
+                      collectionView:(UICollectionView *)collectionView {
+    NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray new];
+    if (itemSections.count > 0) {
+        for (NSIndexPath *indexPath in collectionView.indexPathsForVisibleItems) {
+            // items cannot be reloaded in a batch that also reloads their section
+            if ([itemSections containsIndex:indexPath.section] && ![reloadedSections containsIndex:indexPath.section]) {
+                [indexPaths addObject:indexPath];
+            }
+        }
+    }
+    if (indexPaths.count == 0 && reloadedSections.count == 0) {
+        return;
+    }
+
+    // counts are unchanged, so reloads are safe in a batch and only the visible cells are dequeued again
+    [UIView performWithoutAnimation:^{
+        [collectionView performBatchUpdates:^{
+            if (reloadedSections.count > 0) {
+                [collectionView reloadSections:reloadedSections];
+            }
+            if (indexPaths.count > 0) {
+                [collectionView reloadItemsAtIndexPaths:indexPaths];
+            }
+        } completion:nil];
+    }];
+}
+
 @end
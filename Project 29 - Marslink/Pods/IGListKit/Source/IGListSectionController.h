@@ -72,6 +72,15 @@ NS_SWIFT_NAME(ListSectionController)
  */
 - (void)didUpdateToObject:(id)object;
 
+/**
+ Tells the section controller that it left the list and may be handed out for a different object.
+
+ @note This method is only called when `-[IGListAdapter reusesSectionControllers]` is enabled. Reset any state derived
+ from the previous object here, the next object is delivered through `-didUpdateToObject:`. The view controller,
+ collection context and delegates are kept. The default implementation does nothing. **Calling super is not required.**
+ */
+- (void)prepareForReuse;
+
 /**
  Tells the section controller that the cell at the specified index path was selected.
 
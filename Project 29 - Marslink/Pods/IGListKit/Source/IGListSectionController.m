@@ -82,6 +82,8 @@ void IGListSectionControllerPopThread(void) {
 
 - (void)didUpdateToObject:(id)object {}
 
+- (void)prepareForReuse {}
+
 - (void)didSelectItemAtIndex:(NSInteger)index {}
 
 - (void)didDeselectItemAtIndex:(NSInteger)index {}
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListMacros.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A collection view that counts the updates applied to it instead of performing them, for driving an updater without
+ laying out or animating cells.
+
+ Batch updates run their update block immediately and complete on the next turn of the main queue. Item and section
+ counts are not modeled, so leave batch update validation off while using it.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListSimulatedCollectionView)
+@interface IGListSimulatedCollectionView : UICollectionView
+
+/**
+ A flag indicating whether the collection view reports itself as being in a window, so updaters take their onscreen
+ paths. The default value is `YES`.
+ */
+@property (nonatomic, assign) BOOL simulatesWindow;
+
+/**
+ The number of calls to `-performBatchUpdates:completion:`.
+ */
+@property (nonatomic, assign, readonly) NSInteger batchUpdateCount;
+
+/**
+ The number of calls to `-reloadData`.
+ */
+@property (nonatomic, assign, readonly) NSInteger reloadDataCount;
+
+/**
+ The number of sections inserted, deleted, moved and reloaded.
+ */
+@property (nonatomic, assign, readonly) NSInteger sectionUpdateCount;
+
+/**
+ The number of items inserted, deleted, moved and reloaded.
+ */
+@property (nonatomic, assign, readonly) NSInteger itemUpdateCount;
+
+/**
+ Creates a new simulated collection view with a flow layout.
+
+ @return A new simulated collection view.
+ */
+- (instancetype)init;
+
+/**
+ Sets every count back to zero.
+ */
+- (void)resetCounts;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListSimulatedCollectionView.h"
+
+static UIWindow *IGListSimulatedWindow() {
+    static UIWindow *window;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        window = [[UIWindow alloc] initWithFrame:CGRectMake(0, 0, 320, 568)];
+        window.hidden = YES;
+    });
+    return window;
+}
+
+@implementation IGListSimulatedCollectionView
+
+- (instancetype)init {
+    return [self initWithFrame:CGRectMake(0, 0, 320, 568) collectionViewLayout:[UICollectionViewFlowLayout new]];
+}
+
+- (instancetype)initWithFrame:(CGRect)frame collectionViewLayout:(UICollectionViewLayout *)layout {
+    if (self = [super initWithFrame:frame collectionViewLayout:layout]) {
+        _simulatesWindow = YES;
+    }
+    return self;
+}
+
+- (void)resetCounts {
+    _batchUpdateCount = 0;
+    _reloadDataCount = 0;
+    _sectionUpdateCount = 0;
+    _itemUpdateCount = 0;
+}
+
+#pragma mark - UIView
+
+- (UIWindow *)window {
+    return self.simulatesWindow ? IGListSimulatedWindow() : [super window];
+}
+
+- (void)layoutIfNeeded {}
+
+#pragma mark - UICollectionView
+
+- (NSArray<UICollectionViewCell *> *)visibleCells {
+    return @[];
+}
+
+- (NSArray<NSIndexPath *> *)indexPathsForVisibleItems {
+    return @[];
+}
+
+- (void)reloadData {
+    _reloadDataCount++;
+}
+
+- (void)performBatchUpdates:(void (^)(void))updates completion:(void (^)(BOOL))completion {
+    _batchUpdateCount++;
+    if (updates) {
+        updates();
+    }
+    if (completion) {
+        // UIKit completes after the update animations, never within the call
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(YES);
+        });
+    }
+}
+
+- (void)insertSections:(NSIndexSet *)sections {
+    _sectionUpdateCount += sections.count;
+}
+
+- (void)deleteSections:(NSIndexSet *)sections {
+    _sectionUpdateCount += sections.count;
+}
+
+- (void)reloadSections:(NSIndexSet *)sections {
+    _sectionUpdateCount += sections.count;
+}
+
+- (void)moveSection:(NSInteger)section toSection:(NSInteger)newSection {
+    _sectionUpdateCount++;
+}
+
+- (void)insertItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    _itemUpdateCount += indexPaths.count;
+}
+
+- (void)deleteItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    _itemUpdateCount += indexPaths.count;
+}
+
+- (void)reloadItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    _itemUpdateCount += indexPaths.count;
+}
+
+- (void)moveItemAtIndexPath:(NSIndexPath *)indexPath toIndexPath:(NSIndexPath *)newIndexPath {
+    _itemUpdateCount++;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ %p; batchUpdates: %zi; reloads: %zi; sectionUpdates: %zi; itemUpdates: %zi>",
+            NSStringFromClass(self.class), self, self.batchUpdateCount, self.reloadDataCount,
+            self.sectionUpdateCount, self.itemUpdateCount];
+}
+
+@end
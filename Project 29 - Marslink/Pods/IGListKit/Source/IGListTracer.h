@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Records how long each step of an update takes: fetching objects from the data source, removing duplicate identifiers,
+ diffing, transitioning section controllers, flushing and applying batch updates, reloading, layout and completion
+ blocks.
+
+ Spans are kept in a fixed size ring buffer, so tracing can stay on in long sessions. Export them as Chrome trace-event
+ JSON and open the file in chrome://tracing or Perfetto, or summarize it with `scripts/trace_summary.py`.
+ */
+NS_SWIFT_NAME(ListTracer)
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListTracer : NSObject
+
+/**
+ The tracer that IGListKit records into.
+ */
++ (IGListTracer *)sharedTracer;
+
+/**
+ A flag indicating whether spans are recorded. While disabled, each traced step costs a single branch. The default value
+ is `NO`.
+ */
+@property (nonatomic, assign, getter=isEnabled) BOOL enabled;
+
+/**
+ The number of spans kept before the oldest are overwritten.
+ */
+@property (nonatomic, assign, readonly) NSInteger capacity;
+
+/**
+ The number of spans overwritten since the tracer was last cleared.
+ */
+@property (nonatomic, assign, readonly) NSInteger droppedSpanCount;
+
+/**
+ Exports the kept spans, oldest first, as Chrome trace-event JSON.
+
+ @return UTF-8 encoded JSON. Each span's `count` argument is the number of objects, changes or blocks it covered.
+ */
+- (NSData *)chromeTraceData;
+
+/**
+ Writes the kept spans as Chrome trace-event JSON.
+
+ @param url The file URL to write to.
+ @param error The error if writing fails.
+
+ @return `YES` if the file was written.
+ */
+- (BOOL)writeChromeTraceToURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ Discards every kept span.
+ */
+- (void)clear;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
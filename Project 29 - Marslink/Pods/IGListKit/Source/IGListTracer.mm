@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListTracer.h"
+
+#import <pthread.h>
+
+#import "IGListTraceBuffer.h"
+#import "IGListTracing.h"
+
+// roughly 160KB of spans, about a minute of continuous updates
+static const size_t kIGListTracerCapacity = 4096;
+
+BOOL IGListTracingEnabled = NO;
+
+static IGListKit::IGListTraceBuffer &IGListSharedTraceBuffer() {
+    // never destroyed, spans may still be recorded while the process exits
+    static IGListKit::IGListTraceBuffer *buffer = new IGListKit::IGListTraceBuffer(kIGListTracerCapacity);
+    return *buffer;
+}
+
+static uint64_t IGListTraceMainThread = 0;
+
+void IGListTraceRecordSpan(const char *name, uint64_t start, uint64_t end, NSInteger count) {
+    const uint64_t thread = pthread_mach_thread_np(pthread_self());
+    if (pthread_main_np()) {
+        IGListTraceMainThread = thread;
+    }
+    IGListSharedTraceBuffer().record({name, start, end, thread, count});
+}
+
+@implementation IGListTracer
+
++ (IGListTracer *)sharedTracer {
+    static IGListTracer *tracer = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        tracer = [[IGListTracer alloc] initPrivate];
+    });
+    return tracer;
+}
+
+- (instancetype)initPrivate {
+    return [super init];
+}
+
+- (BOOL)isEnabled {
+    return IGListTracingEnabled;
+}
+
+- (void)setEnabled:(BOOL)enabled {
+    IGListTracingEnabled = enabled;
+}
+
+- (NSInteger)capacity {
+    return IGListSharedTraceBuffer().capacity();
+}
+
+- (NSInteger)droppedSpanCount {
+    return (NSInteger)IGListSharedTraceBuffer().droppedCount();
+}
+
+- (NSData *)chromeTraceData {
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    const double microsecondsPerTick = (double)timebase.numer / timebase.denom / 1000.0;
+
+    const std::string json = IGListKit::IGListTraceChromeJSON(IGListSharedTraceBuffer().spans(),
+                                                              microsecondsPerTick,
+                                                              IGListTraceMainThread);
+    return [NSData dataWithBytes:json.data() length:json.size()];
+}
+
+- (BOOL)writeChromeTraceToURL:(NSURL *)url error:(NSError **)error {
+    return [[self chromeTraceData] writeToURL:url options:NSDataWritingAtomic error:error];
+}
+
+- (void)clear {
+    IGListSharedTraceBuffer().clear();
+}
+
+@end
@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <QuartzCore/QuartzCore.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A source of time and frame callbacks for `IGListFrameUpdateScheduler`.
+ */
+NS_SWIFT_NAME(ListUpdateClock)
+@protocol IGListUpdateClock <NSObject>
+
+/**
+ The current time, in seconds, on the same time base as frame timestamps.
+ */
+- (CFTimeInterval)currentTime;
+
+/**
+ Sets the block called on the main thread at the start of every frame, with the frame's timestamp. Setting a block
+ starts frame callbacks and setting `nil` stops them.
+ */
+- (void)setFrameHandler:(nullable void (^)(CFTimeInterval timestamp))frameHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdateClock.h>
+
+@class IGListAdapterUpdater;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Coordinates the updates of many `IGListAdapterUpdater`s, such as one per horizontally scrolling row embedded in a feed.
+
+ Registered updaters stop scheduling updates on their own. Instead, every update they queue within a frame is collected,
+ and at the start of the next frame:
+
+ 1. Each updater prepares its update, parents before the collection views nested inside them.
+ 2. The diffs of all prepared updates run concurrently off the main thread.
+ 3. Once every diff has finished, the updates are applied on the main thread in one pass, parents first.
+
+ A model change that touches dozens of nested lists then costs one frame of coordinated work instead of dozens of
+ independent diff and apply cycles.
+
+ @note Diffs run off the main thread, so the diffed objects must be safe to read there. See
+ `-[IGListAdapterUpdater diffsInBackground]`.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListUpdateCoordinator)
+@interface IGListUpdateCoordinator : NSObject
+
+/**
+ The clock providing frames.
+ */
+@property (nonatomic, strong, readonly) id<IGListUpdateClock> clock;
+
+/**
+ The number of updaters waiting for the next frame.
+ */
+@property (nonatomic, assign, readonly) NSInteger pendingUpdateCount;
+
+/**
+ Creates a coordinator.
+
+ @param clock The clock providing frames.
+
+ @return A new coordinator.
+ */
+- (instancetype)initWithClock:(id<IGListUpdateClock>)clock NS_DESIGNATED_INITIALIZER;
+
+/**
+ Creates a coordinator driven by an `IGListDisplayLinkClock`.
+ */
+- (instancetype)init;
+
+/**
+ Routes an updater's updates through the coordinator. An updater belongs to at most one coordinator; registering it
+ again moves it, along with any update collected by the previous coordinator. The coordinator does not retain the
+ updater.
+
+ @param updater The updater to coordinate.
+ */
+- (void)registerUpdater:(IGListAdapterUpdater *)updater;
+
+/**
+ Returns an updater to scheduling its own updates. An update already collected for the next frame moves to the
+ updater's scheduler, as do the collected updates of every updater when the coordinator is deallocated.
+
+ @param updater The updater to stop coordinating.
+ */
+- (void)unregisterUpdater:(IGListAdapterUpdater *)updater;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListUpdateCoordinator.h"
+#import "IGListUpdateCoordinatorInternal.h"
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListDisplayLinkClock.h>
+
+#import "IGListAdapterUpdaterInternal.h"
+
+@interface IGListCoordinatedUpdate : NSObject
+
+@property (nonatomic, weak) IGListAdapterUpdater *updater;
+@property (nonatomic, weak) UICollectionView *collectionView;
+@property (nonatomic, copy) void (^block)(void);
+@property (nonatomic, assign) NSInteger depth;
+
+@end
+
+@implementation IGListCoordinatedUpdate
+
+@end
+
+@interface IGListCoordinatedDiff : NSObject
+
+@property (nonatomic, strong) IGListDiffSnapshot *snapshot;
+@property (nonatomic, copy) IGListDiffExecutorCompletion completion;
+@property (nonatomic, copy) NSArray *toObjects;
+@property (nonatomic, strong) IGListIndexSetResult *result;
+
+@end
+
+@implementation IGListCoordinatedDiff
+
+@end
+
+static NSInteger IGListViewDepth(UIView *view) {
+    NSInteger depth = 0;
+    for (UIView *superview = view.superview; superview != nil; superview = superview.superview) {
+        depth++;
+    }
+    return depth;
+}
+
+@implementation IGListUpdateCoordinator {
+    NSMutableArray<IGListCoordinatedUpdate *> *_pendingUpdates;
+    // non-nil while the updates of a frame are being prepared
+    NSMutableArray<IGListCoordinatedDiff *> *_frameDiffs;
+    BOOL _waitingForFrame;
+}
+
+- (instancetype)initWithClock:(id<IGListUpdateClock>)clock {
+    IGParameterAssert(clock != nil);
+    if (self = [super init]) {
+        _clock = clock;
+        _pendingUpdates = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithClock:[IGListDisplayLinkClock new]];
+}
+
+- (void)dealloc {
+    [_clock setFrameHandler:nil];
+
+    // weak references to the coordinator already read nil, so the collected updates go back to their own schedulers
+    for (IGListCoordinatedUpdate *update in _pendingUpdates) {
+        [update.updater rescheduleUpdate];
+    }
+}
+
+- (NSInteger)pendingUpdateCount {
+    return _pendingUpdates.count;
+}
+
+- (void)registerUpdater:(IGListAdapterUpdater *)updater {
+    IGAssertMainThread();
+    IGParameterAssert(updater != nil);
+    IGListUpdateCoordinator *previousCoordinator = updater.coordinator;
+    updater.coordinator = self;
+    // an update waiting on the updater's own scheduler still runs, and diffs through this coordinator
+    if (previousCoordinator != self) {
+        [previousCoordinator reschedulePendingUpdatesOfUpdater:updater];
+    }
+}
+
+- (void)unregisterUpdater:(IGListAdapterUpdater *)updater {
+    IGAssertMainThread();
+    IGParameterAssert(updater != nil);
+    if (updater.coordinator == self) {
+        updater.coordinator = nil;
+        [self reschedulePendingUpdatesOfUpdater:updater];
+    }
+}
+
+// hands an updater's collected update to wherever the updater now schedules its updates
+- (void)reschedulePendingUpdatesOfUpdater:(IGListAdapterUpdater *)updater {
+    NSIndexSet *indexes = [_pendingUpdates indexesOfObjectsPassingTest:^BOOL(IGListCoordinatedUpdate *update,
+                                                                             NSUInteger idx,
+                                                                             BOOL *stop) {
+        return update.updater == updater;
+    }];
+    if (indexes.count == 0) {
+        return;
+    }
+    [_pendingUpdates removeObjectsAtIndexes:indexes];
+    [updater rescheduleUpdate];
+}
+
+- (void)scheduleUpdateForUpdater:(IGListAdapterUpdater *)updater
+                  collectionView:(UICollectionView *)collectionView
+                           block:(void (^)(void))update {
+    IGAssertMainThread();
+    IGParameterAssert(updater != nil);
+    IGParameterAssert(update != nil);
+
+    IGListCoordinatedUpdate *coordinatedUpdate = [IGListCoordinatedUpdate new];
+    coordinatedUpdate.updater = updater;
+    coordinatedUpdate.collectionView = collectionView;
+    coordinatedUpdate.block = update;
+    [_pendingUpdates addObject:coordinatedUpdate];
+
+    if (!_waitingForFrame) {
+        _waitingForFrame = YES;
+        __weak __typeof__(self) weakSelf = self;
+        [self.clock setFrameHandler:^(CFTimeInterval timestamp) {
+            [weakSelf runFrame];
+        }];
+    }
+}
+
+- (void)diffSnapshot:(IGListDiffSnapshot *)snapshot completion:(IGListDiffExecutorCompletion)completion {
+    IGAssertMainThread();
+    IGParameterAssert(snapshot != nil);
+    IGParameterAssert(completion != nil);
+
+    IGListCoordinatedDiff *diff = [IGListCoordinatedDiff new];
+    diff.snapshot = snapshot;
+    diff.completion = completion;
+
+    if (_frameDiffs != nil) {
+        [_frameDiffs addObject:diff];
+    } else {
+        // prepared outside of a coordinated frame, e.g. by an updater that was registered mid-update
+        [self performDiffs:@[diff]];
+    }
+}
+
+- (void)runFrame {
+    IGAssertMainThread();
+
+    // parents first. the depth is read now since cells may have been reused into another part of the hierarchy
+    NSArray<IGListCoordinatedUpdate *> *updates = [_pendingUpdates copy];
+    [_pendingUpdates removeAllObjects];
+    for (IGListCoordinatedUpdate *update in updates) {
+        UICollectionView *collectionView = update.collectionView;
+        update.depth = collectionView != nil ? IGListViewDepth(collectionView) : 0;
+    }
+    updates = [updates sortedArrayWithOptions:NSSortStable
+                              usingComparator:^NSComparisonResult(IGListCoordinatedUpdate *a, IGListCoordinatedUpdate *b) {
+        return a.depth < b.depth ? NSOrderedAscending : a.depth > b.depth ? NSOrderedDescending : NSOrderedSame;
+    }];
+
+    // updates that need a diff submit it with -diffSnapshot:completion:, which collects it for this frame
+    _frameDiffs = [NSMutableArray new];
+    for (IGListCoordinatedUpdate *update in updates) {
+        update.block();
+    }
+    NSArray<IGListCoordinatedDiff *> *diffs = [_frameDiffs copy];
+    _frameDiffs = nil;
+
+    if (diffs.count > 0) {
+        [self performDiffs:diffs];
+    }
+
+    // stop frame callbacks while idle
+    if (_pendingUpdates.count == 0) {
+        _waitingForFrame = NO;
+        [self.clock setFrameHandler:nil];
+    }
+}
+
+- (void)performDiffs:(NSArray<IGListCoordinatedDiff *> *)diffs {
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+    for (IGListCoordinatedDiff *diff in diffs) {
+        dispatch_group_async(group, queue, ^{
+            IGListDiffSnapshot *snapshot = diff.snapshot;
+            NSArray *toObjects = IGListAdapterUpdaterObjectsWithDuplicateIdentifiersRemoved(snapshot.toObjects);
+            diff.result = IGListAdapterUpdaterDiff(snapshot.fromObjects,
+                                                   toObjects,
+                                                   snapshot.experiments,
+                                                   snapshot.moveCostModel);
+            diff.toObjects = toObjects;
+        });
+    }
+
+    // apply every update of the frame in one pass, in the order they were prepared
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        for (IGListCoordinatedDiff *diff in diffs) {
+            diff.completion(diff.toObjects, diff.result);
+        }
+    });
+}
+
+@end
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Learns how long `-[UICollectionView performBatchUpdates:completion:]` and `-[UICollectionView reloadData]` take on one
+ collection view, and picks the cheaper one for each update.
+
+ Samples are grouped by the number of visible cells, in power-of-two buckets. Within a bucket, batch update cost is fit
+ as a line in the number of changes and reload cost is averaged. Older samples decay so the model follows changes in cell
+ complexity.
+ */
+NS_SWIFT_NAME(ListUpdateCostModel)
+@interface IGListUpdateCostModel : NSObject
+
+/**
+ How much cheaper the other path must be estimated to be before the model switches to it, as a fraction of the cost of
+ the path it is on. The default value is `0.25`.
+ */
+@property (nonatomic, assign) double hysteresis;
+
+/**
+ The number of batch update samples a bucket needs before its estimates are used. The default value is `3`.
+ */
+@property (nonatomic, assign) NSInteger minimumSampleCount;
+
+/**
+ The change count above which `reloadData` is used while a bucket does not have enough samples. The default value is
+ `100`.
+ */
+@property (nonatomic, assign) NSInteger fallbackChangeCount;
+
+/**
+ Records the measured duration of a batch update.
+
+ @param duration The time spent in `-performBatchUpdates:completion:`, in seconds.
+ @param changeCount The number of changes in the update.
+ @param visibleCellCount The number of cells visible when the update started.
+ */
+- (void)recordBatchUpdateDuration:(NSTimeInterval)duration
+                      changeCount:(NSInteger)changeCount
+                 visibleCellCount:(NSInteger)visibleCellCount;
+
+/**
+ Records the measured duration of a reload.
+
+ @param duration The time spent reloading and laying out the collection view, in seconds.
+ @param visibleCellCount The number of cells visible when the update started.
+ */
+- (void)recordReloadDataDuration:(NSTimeInterval)duration visibleCellCount:(NSInteger)visibleCellCount;
+
+/**
+ The estimated duration of a batch update, or a negative value if there are not enough samples.
+ */
+- (NSTimeInterval)estimatedBatchUpdateDurationForChangeCount:(NSInteger)changeCount
+                                            visibleCellCount:(NSInteger)visibleCellCount;
+
+/**
+ The estimated duration of a reload, or a negative value if there are no samples.
+ */
+- (NSTimeInterval)estimatedReloadDataDurationForVisibleCellCount:(NSInteger)visibleCellCount;
+
+/**
+ Decides whether an update should reload data instead of performing batch updates.
+
+ @param changeCount The number of changes in the update.
+ @param visibleCellCount The number of visible cells.
+
+ @return `YES` if reloading is estimated to be cheaper, applying `hysteresis` against the previous decision for the
+ same bucket. Falls back to comparing `changeCount` with `fallbackChangeCount` until both paths have been measured.
+ */
+- (BOOL)shouldReloadDataForChangeCount:(NSInteger)changeCount visibleCellCount:(NSInteger)visibleCellCount;
+
+/**
+ Discards every sample and decision.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListUpdateCostModel.h"
+
+// visible cell counts up to 2^15 get their own bucket, anything larger shares the last one
+#define IGLIST_COST_BUCKET_COUNT 16
+
+// weight kept by existing samples each time a new one is recorded
+static const double kIGListCostDecay = 0.9;
+
+// decayed sums for a least squares fit of duration against change count
+typedef struct {
+    double weight;
+    double sumX;
+    double sumY;
+    double sumXY;
+    double sumXX;
+    NSInteger count;
+} IGListBatchUpdateSamples;
+
+typedef struct {
+    double mean;
+    NSInteger count;
+} IGListReloadDataSamples;
+
+static NSInteger IGListCostBucket(NSInteger visibleCellCount) {
+    NSInteger bucket = 0;
+    for (NSUInteger count = MAX(visibleCellCount, 0) + 1; count > 1 && bucket < IGLIST_COST_BUCKET_COUNT - 1; count >>= 1) {
+        bucket++;
+    }
+    return bucket;
+}
+
+@implementation IGListUpdateCostModel {
+    IGListBatchUpdateSamples _batchUpdates[IGLIST_COST_BUCKET_COUNT];
+    IGListReloadDataSamples _reloads[IGLIST_COST_BUCKET_COUNT];
+    BOOL _prefersReloadData[IGLIST_COST_BUCKET_COUNT];
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _hysteresis = 0.25;
+        _minimumSampleCount = 3;
+        _fallbackChangeCount = 100;
+    }
+    return self;
+}
+
+- (void)recordBatchUpdateDuration:(NSTimeInterval)duration
+                      changeCount:(NSInteger)changeCount
+                 visibleCellCount:(NSInteger)visibleCellCount {
+    IGListBatchUpdateSamples *samples = &_batchUpdates[IGListCostBucket(visibleCellCount)];
+    const double x = MAX(changeCount, 0);
+    samples->weight = samples->weight * kIGListCostDecay + 1;
+    samples->sumX = samples->sumX * kIGListCostDecay + x;
+    samples->sumY = samples->sumY * kIGListCostDecay + duration;
+    samples->sumXY = samples->sumXY * kIGListCostDecay + x * duration;
+    samples->sumXX = samples->sumXX * kIGListCostDecay + x * x;
+    samples->count++;
+}
+
+- (void)recordReloadDataDuration:(NSTimeInterval)duration visibleCellCount:(NSInteger)visibleCellCount {
+    IGListReloadDataSamples *samples = &_reloads[IGListCostBucket(visibleCellCount)];
+    samples->mean = samples->count == 0 ? duration : samples->mean * kIGListCostDecay + duration * (1 - kIGListCostDecay);
+    samples->count++;
+}
+
+- (NSTimeInterval)estimatedBatchUpdateDurationForChangeCount:(NSInteger)changeCount
+                                            visibleCellCount:(NSInteger)visibleCellCount {
+    const IGListBatchUpdateSamples samples = _batchUpdates[IGListCostBucket(visibleCellCount)];
+    if (samples.count < MAX(self.minimumSampleCount, 1)) {
+        return -1;
+    }
+
+    const double x = MAX(changeCount, 0);
+    const double meanX = samples.sumX / samples.weight;
+    const double meanY = samples.sumY / samples.weight;
+    const double varianceX = samples.sumXX / samples.weight - meanX * meanX;
+    if (varianceX < 1) {
+        // every sample had about the same change count, so scale the mean by the change count instead of fitting
+        return meanY * (x + 1) / (meanX + 1);
+    }
+
+    // more changes never make an update cheaper
+    const double slope = MAX((samples.sumXY / samples.weight - meanX * meanY) / varianceX, 0);
+    return MAX(meanY + slope * (x - meanX), 0);
+}
+
+- (NSTimeInterval)estimatedReloadDataDurationForVisibleCellCount:(NSInteger)visibleCellCount {
+    const IGListReloadDataSamples samples = _reloads[IGListCostBucket(visibleCellCount)];
+    return samples.count == 0 ? -1 : samples.mean;
+}
+
+- (BOOL)shouldReloadDataForChangeCount:(NSInteger)changeCount visibleCellCount:(NSInteger)visibleCellCount {
+    const NSInteger bucket = IGListCostBucket(visibleCellCount);
+    const NSTimeInterval batchUpdate = [self estimatedBatchUpdateDurationForChangeCount:changeCount
+                                                                       visibleCellCount:visibleCellCount];
+    const NSTimeInterval reload = [self estimatedReloadDataDurationForVisibleCellCount:visibleCellCount];
+
+    BOOL reloadData;
+    if (batchUpdate < 0 || reload < 0) {
+        reloadData = changeCount > self.fallbackChangeCount;
+    } else if (_prefersReloadData[bucket]) {
+        reloadData = batchUpdate * (1 + self.hysteresis) >= reload;
+    } else {
+        reloadData = reload * (1 + self.hysteresis) < batchUpdate;
+    }
+    _prefersReloadData[bucket] = reloadData;
+    return reloadData;
+}
+
+- (void)reset {
+    memset(_batchUpdates, 0, sizeof(_batchUpdates));
+    memset(_reloads, 0, sizeof(_reloads));
+    memset(_prefersReloadData, 0, sizeof(_prefersReloadData));
+}
+
+- (NSString *)description {
+    NSMutableString *buckets = [NSMutableString new];
+    for (NSInteger i = 0; i < IGLIST_COST_BUCKET_COUNT; i++) {
+        if (_batchUpdates[i].count == 0 && _reloads[i].count == 0) {
+            continue;
+        }
+        [buckets appendFormat:@" [%zi: batchUpdates: %zi, reloads: %zi, mean reload: %.2fms]",
+         i, _batchUpdates[i].count, _reloads[i].count, _reloads[i].mean * 1000];
+    }
+    return [NSString stringWithFormat:@"<%@ %p; hysteresis: %.2f;%@>",
+            NSStringFromClass(self.class), self, self.hysteresis, buckets];
+}
+
+@end
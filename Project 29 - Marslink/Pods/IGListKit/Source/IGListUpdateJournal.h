@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A compact binary record of the calls an adapter makes into its updater. Record a session by wrapping the adapter's
+ updater in an IGListJournalingUpdater, then reproduce it offline with IGListUpdateJournalReplayer.
+
+ Objects are recorded as the hash of their diff identifier and their `-diffVersion`. Objects that do not implement
+ `-diffVersion` are versioned by a hash of their address, so replacing one with an equal copy replays as an update. No
+ other model data is kept. Each record is timestamped to the microsecond. Inspect a journal with
+ `scripts/journal_dump.py`.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListUpdateJournal)
+@interface IGListUpdateJournal : NSObject
+
+/**
+ The number of calls recorded since the journal was created or last cleared.
+ */
+@property (nonatomic, assign, readonly) NSInteger recordCount;
+
+/**
+ The encoded journal.
+ */
+- (NSData *)data;
+
+/**
+ Writes the encoded journal to a file.
+
+ @param url The file URL to write to.
+ @param error The error if writing fails.
+
+ @return `YES` if the file was written.
+ */
+- (BOOL)writeToURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ Discards every record. Timestamps of later records are relative to the clear.
+ */
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListUpdateJournal.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#import <vector>
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListDiffable.h>
+#import <IGListKit/IGListIndexSetResult.h>
+#import <IGListKit/IGListMoveIndex.h>
+
+#import "IGListJournalCoding.h"
+#import "IGListUpdateJournalInternal.h"
+
+using namespace IGListKit;
+
+static std::vector<IGListJournalObject> IGListJournalObjectsFromArray(NSArray *objects) {
+    std::vector<IGListJournalObject> journalObjects;
+    journalObjects.reserve(objects.count);
+    for (id<IGListDiffable> object in objects) {
+        uint64_t version;
+        if ([(id)object respondsToSelector:@selector(diffVersion)]) {
+            version = [object diffVersion];
+        } else {
+            // mixed so that the journal does not carry raw addresses
+            version = (uint64_t)(uintptr_t)object * 0x9E3779B97F4A7C15ull;
+        }
+        journalObjects.push_back({(uint64_t)[[object diffIdentifier] hash], version});
+    }
+    return journalObjects;
+}
+
+static IGListJournalRanges IGListJournalRangesFromIndexSet(NSIndexSet *indexes) {
+    __block IGListJournalRanges ranges;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        ranges.push_back({range.location, range.length});
+    }];
+    return ranges;
+}
+
+static std::vector<std::pair<uint64_t, uint64_t>> IGListJournalPairsFromIndexPaths(NSArray<NSIndexPath *> *indexPaths) {
+    std::vector<std::pair<uint64_t, uint64_t>> pairs;
+    pairs.reserve(indexPaths.count);
+    for (NSIndexPath *indexPath in indexPaths) {
+        pairs.push_back({(uint64_t)indexPath.section, (uint64_t)indexPath.item});
+    }
+    return pairs;
+}
+
+// a record made inside the innermost running item update block, if any
+static IGListJournalRecord IGListJournalRecordMake(IGListJournalRecordType type,
+                                                   const std::vector<uint64_t> &blockIDs) {
+    IGListJournalRecord record;
+    record.type = type;
+    record.parentBlockID = blockIDs.empty() ? 0 : blockIDs.back();
+    return record;
+}
+
+@implementation IGListUpdateJournal {
+    IGListJournalWriter _writer;
+    CFTimeInterval _startTime;
+    uint64_t _lastRecordTime;
+    // the to objects of the last update, which are usually the from objects of the next
+    std::vector<IGListJournalObject> _previousToObjects;
+    // item update blocks that are running, innermost last
+    std::vector<uint64_t> _blockIDs;
+    uint64_t _lastBlockID;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _startTime = CACurrentMediaTime();
+    }
+    return self;
+}
+
+#pragma mark - Public API
+
+- (NSInteger)recordCount {
+    return _writer.recordCount();
+}
+
+- (NSData *)data {
+    const std::vector<uint8_t> &bytes = _writer.bytes();
+    return [NSData dataWithBytes:bytes.data() length:bytes.size()];
+}
+
+- (BOOL)writeToURL:(NSURL *)url error:(NSError **)error {
+    IGParameterAssert(url != nil);
+    return [[self data] writeToURL:url options:NSDataWritingAtomic error:error];
+}
+
+- (void)clear {
+    IGAssertMainThread();
+    _writer = IGListJournalWriter();
+    _startTime = CACurrentMediaTime();
+    _lastRecordTime = 0;
+    _previousToObjects.clear();
+    // blocks that are still running keep their IDs, their records replay as top level records
+}
+
+#pragma mark - Recording
+
+- (void)appendRecord:(const IGListJournalRecord &)record {
+    IGAssertMainThread();
+    // timestamps are kept relative to the start so rounding does not accumulate across records
+    const uint64_t time = (uint64_t)MAX((CACurrentMediaTime() - _startTime) * 1e6, 0);
+    const uint64_t elapsed = time > _lastRecordTime ? time - _lastRecordTime : 0;
+    _lastRecordTime = MAX(time, _lastRecordTime);
+    _writer.writeRecord(record, elapsed);
+}
+
+- (void)recordUpdateFromObjects:(NSArray *)fromObjects
+                      toObjects:(NSArray *)toObjects
+                          delta:(IGListIndexSetResult *)delta
+                       animated:(BOOL)animated {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::performUpdate, _blockIDs);
+    record.fromObjects = IGListJournalObjectsFromArray(fromObjects);
+    record.toObjects = IGListJournalObjectsFromArray(toObjects);
+
+    record.flags = animated ? IGListJournalUpdateAnimated : 0;
+    if (fromObjects != nil) {
+        record.flags |= IGListJournalUpdateHasFromObjects;
+        if (record.fromObjects == _previousToObjects) {
+            record.flags |= IGListJournalUpdateFromPreviousObjects;
+        }
+    }
+    if (toObjects != nil) {
+        record.flags |= IGListJournalUpdateHasToObjects;
+    }
+    if (delta != nil) {
+        record.flags |= IGListJournalUpdateHasDelta;
+        record.inserts = IGListJournalRangesFromIndexSet(delta.inserts);
+        record.deletes = IGListJournalRangesFromIndexSet(delta.deletes);
+        record.updates = IGListJournalRangesFromIndexSet(delta.updates);
+        record.moves.reserve(delta.moves.count);
+        for (IGListMoveIndex *move in delta.moves) {
+            record.moves.push_back({(uint64_t)move.from, (uint64_t)move.to});
+        }
+    }
+
+    [self appendRecord:record];
+    _previousToObjects = std::move(record.toObjects);
+}
+
+- (uint64_t)recordItemUpdatesAnimated:(BOOL)animated {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::itemUpdates, _blockIDs);
+    record.flags = animated ? 1 : 0;
+    record.blockID = ++_lastBlockID;
+    [self appendRecord:record];
+    return record.blockID;
+}
+
+- (void)beginItemUpdateBlock:(uint64_t)blockID {
+    IGAssertMainThread();
+    _blockIDs.push_back(blockID);
+}
+
+- (void)endItemUpdateBlock {
+    IGAssertMainThread();
+    IGAssert(!_blockIDs.empty(), @"Ending an item update block that was not begun");
+    if (!_blockIDs.empty()) {
+        _blockIDs.pop_back();
+    }
+}
+
+- (void)recordInsertItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::insertItems, _blockIDs);
+    record.indexPaths = IGListJournalPairsFromIndexPaths(indexPaths);
+    [self appendRecord:record];
+}
+
+- (void)recordDeleteItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::deleteItems, _blockIDs);
+    record.indexPaths = IGListJournalPairsFromIndexPaths(indexPaths);
+    [self appendRecord:record];
+}
+
+- (void)recordMoveItemFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::moveItem, _blockIDs);
+    record.indexPaths = IGListJournalPairsFromIndexPaths(@[fromIndexPath, toIndexPath]);
+    [self appendRecord:record];
+}
+
+- (void)recordReloadItemFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::reloadItem, _blockIDs);
+    record.indexPaths = IGListJournalPairsFromIndexPaths(@[fromIndexPath, toIndexPath]);
+    [self appendRecord:record];
+}
+
+- (void)recordReloadItemsFromSection:(NSInteger)fromSection toSection:(NSInteger)toSection indexes:(NSIndexSet *)indexes {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::reloadItems, _blockIDs);
+    record.fromSection = fromSection;
+    record.toSection = toSection;
+    record.indexes = IGListJournalRangesFromIndexSet(indexes);
+    [self appendRecord:record];
+}
+
+- (void)recordReloadSections:(NSIndexSet *)sections {
+    IGListJournalRecord record = IGListJournalRecordMake(IGListJournalRecordType::reloadSections, _blockIDs);
+    record.indexes = IGListJournalRangesFromIndexSet(sections);
+    [self appendRecord:record];
+}
+
+- (void)recordReloadData {
+    [self appendRecord:IGListJournalRecordMake(IGListJournalRecordType::reloadData, _blockIDs)];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ %p; recordCount: %zi; byteCount: %zu>",
+            NSStringFromClass(self.class), self, self.recordCount, _writer.bytes().size()];
+}
+
+@end
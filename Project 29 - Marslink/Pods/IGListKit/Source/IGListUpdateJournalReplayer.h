@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdatingDelegate.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Replays a recorded IGListUpdateJournal against an updater, so its coalescing and batching can be reproduced and
+ benchmarked without the app that recorded it.
+
+ Objects are replaced by stand-ins with the recorded identifier hashes and versions. Calls recorded inside an item update
+ block are made when the replayed updater runs the block. Pair the updater with an IGListSimulatedCollectionView to
+ measure the updater without the cost of cells, or with a real collection view to include it.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListUpdateJournalReplayer)
+@interface IGListUpdateJournalReplayer : NSObject
+
+/**
+ The number of records in the journal.
+ */
+@property (nonatomic, assign, readonly) NSInteger recordCount;
+
+/**
+ The time between the first and last record, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval recordedDuration;
+
+/**
+ The factor applied to the recorded time between calls. `1` replays at the recorded pace, `0` makes each call on the
+ next turn of the main queue. The default value is `1`.
+ */
+@property (nonatomic, assign) double timeScale;
+
+/**
+ A flag indicating whether a replay is in progress.
+ */
+@property (nonatomic, assign, readonly, getter=isReplaying) BOOL replaying;
+
+/**
+ Decodes a journal.
+
+ @param data Data from `-[IGListUpdateJournal data]`.
+ @param error The error if the data is not a journal or is corrupt.
+
+ @return A new replayer, or `nil` if the journal could not be decoded.
+ */
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+
+/**
+ Makes every recorded call on an updater, on the main queue.
+
+ @param updater The updater to replay into.
+ @param collectionView The collection view to pass to the updater.
+ @param completion A block called once every call has been made and every update the updater was asked for has
+ completed, with the time the replay took in seconds.
+ */
+- (void)replayWithUpdater:(id<IGListUpdatingDelegate>)updater
+           collectionView:(UICollectionView *)collectionView
+               completion:(nullable void (^)(NSTimeInterval duration))completion;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
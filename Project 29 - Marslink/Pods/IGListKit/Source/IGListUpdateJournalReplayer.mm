@@ -0,0 +1,350 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListUpdateJournalReplayer.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#import <unordered_map>
+#import <unordered_set>
+#import <vector>
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListDiffable.h>
+#import <IGListKit/IGListIndexSetResult.h>
+
+#import "IGListJournalCoding.h"
+#import "IGListMoveIndexInternal.h"
+
+using namespace IGListKit;
+
+/**
+ Stands in for a recorded object, diffing by the recorded identifier hash and version.
+ */
+@interface IGListJournalReplayObject : NSObject <IGListDiffable>
+
+- (instancetype)initWithIdentifier:(uint64_t)identifier version:(uint64_t)version;
+
+@end
+
+@implementation IGListJournalReplayObject {
+    NSNumber *_identifier;
+    uint64_t _version;
+}
+
+- (instancetype)initWithIdentifier:(uint64_t)identifier version:(uint64_t)version {
+    if (self = [super init]) {
+        _identifier = @(identifier);
+        _version = version;
+    }
+    return self;
+}
+
+- (id<NSObject>)diffIdentifier {
+    return _identifier;
+}
+
+- (BOOL)isEqualToDiffableObject:(id<IGListDiffable>)object {
+    if (object == self) {
+        return YES;
+    }
+    return [(id)object isKindOfClass:[IGListJournalReplayObject class]]
+    && ((IGListJournalReplayObject *)object)->_version == _version;
+}
+
+- (uint64_t)diffVersion {
+    return _version;
+}
+
+@end
+
+static NSArray *IGListJournalReplayObjects(const std::vector<IGListJournalObject> &objects) {
+    NSMutableArray *replayObjects = [NSMutableArray arrayWithCapacity:objects.size()];
+    for (const auto &object : objects) {
+        [replayObjects addObject:[[IGListJournalReplayObject alloc] initWithIdentifier:object.identifier
+                                                                               version:object.version]];
+    }
+    return replayObjects;
+}
+
+static NSIndexSet *IGListJournalReplayIndexSet(const IGListJournalRanges &ranges) {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet new];
+    for (const auto &range : ranges) {
+        [indexes addIndexesInRange:NSMakeRange((NSUInteger)range.first, (NSUInteger)range.second)];
+    }
+    return indexes;
+}
+
+static NSIndexPath *IGListJournalReplayIndexPath(const std::pair<uint64_t, uint64_t> &pair) {
+    return [NSIndexPath indexPathForItem:(NSInteger)pair.second inSection:(NSInteger)pair.first];
+}
+
+@implementation IGListUpdateJournalReplayer {
+    std::vector<IGListJournalRecord> _records;
+    // indexes of the records made outside of any recorded item update block
+    std::vector<size_t> _topLevelRecords;
+    // indexes of the records made inside each item update block
+    std::unordered_map<uint64_t, std::vector<size_t>> _blockRecords;
+
+    // replay state
+    id<IGListUpdatingDelegate> _updater;
+    UICollectionView *_collectionView;
+    void (^_completion)(NSTimeInterval);
+    NSArray *_previousToObjects;
+    NSInteger _pendingUpdateCount;
+    BOOL _madeEveryCall;
+    CFTimeInterval _startTime;
+}
+
+- (instancetype)initWithData:(NSData *)data error:(NSError **)error {
+    IGParameterAssert(data != nil);
+    std::vector<IGListJournalRecord> records;
+    if (!IGListJournalDecode((const uint8_t *)data.bytes, data.length, records)) {
+        if (error != NULL) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                         code:NSFileReadCorruptFileError
+                                     userInfo:@{NSLocalizedDescriptionKey: @"The data is not a valid update journal"}];
+        }
+        return nil;
+    }
+
+    if (self = [super init]) {
+        _records = std::move(records);
+        _timeScale = 1;
+
+        std::unordered_set<uint64_t> blockIDs;
+        for (const auto &record : _records) {
+            if (record.type == IGListJournalRecordType::itemUpdates) {
+                blockIDs.insert(record.blockID);
+            }
+        }
+        for (size_t i = 0; i < _records.size(); i++) {
+            const uint64_t parent = _records[i].parentBlockID;
+            // a block recorded before the journal was cleared is gone, so its records replay on their own
+            if (parent != 0 && blockIDs.count(parent) > 0) {
+                _blockRecords[parent].push_back(i);
+            } else {
+                _topLevelRecords.push_back(i);
+            }
+        }
+    }
+    return self;
+}
+
+#pragma mark - Public API
+
+- (NSInteger)recordCount {
+    return _records.size();
+}
+
+- (NSTimeInterval)recordedDuration {
+    return _records.empty() ? 0 : (_records.back().time - _records.front().time) / 1e6;
+}
+
+- (void)replayWithUpdater:(id<IGListUpdatingDelegate>)updater
+           collectionView:(UICollectionView *)collectionView
+               completion:(void (^)(NSTimeInterval))completion {
+    IGAssertMainThread();
+    IGParameterAssert(updater != nil);
+    IGParameterAssert(collectionView != nil);
+    IGAssert(!self.replaying, @"Cannot start a replay while another is in progress");
+    if (self.replaying) {
+        return;
+    }
+
+    _replaying = YES;
+    _updater = updater;
+    _collectionView = collectionView;
+    _completion = [completion copy];
+    _previousToObjects = @[];
+    _pendingUpdateCount = 0;
+    _madeEveryCall = NO;
+    _startTime = CACurrentMediaTime();
+    [self replayTopLevelRecordAtIndex:0];
+}
+
+#pragma mark - Private API
+
+- (void)replayTopLevelRecordAtIndex:(size_t)index {
+    if (index >= _topLevelRecords.size()) {
+        _madeEveryCall = YES;
+        [self finishIfNeeded];
+        return;
+    }
+
+    [self replayRecordAtIndex:_topLevelRecords[index]];
+
+    // each call is scheduled from the previous one so replayed calls keep their order at any time scale
+    double delay = 0;
+    if (index + 1 < _topLevelRecords.size()) {
+        const uint64_t time = _records[_topLevelRecords[index]].time;
+        const uint64_t nextTime = _records[_topLevelRecords[index + 1]].time;
+        delay = (nextTime - time) / 1e6 * MAX(self.timeScale, 0);
+    }
+    dispatch_block_t next = ^{
+        [self replayTopLevelRecordAtIndex:index + 1];
+    };
+    if (delay > 0) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), next);
+    } else {
+        dispatch_async(dispatch_get_main_queue(), next);
+    }
+}
+
+- (void)replayRecordAtIndex:(size_t)index {
+    const IGListJournalRecord &record = _records[index];
+    id<IGListUpdatingDelegate> updater = _updater;
+    UICollectionView *collectionView = _collectionView;
+
+    switch (record.type) {
+        case IGListJournalRecordType::performUpdate: {
+            NSArray *fromObjects = nil;
+            if (record.flags & IGListJournalUpdateHasFromObjects) {
+                fromObjects = (record.flags & IGListJournalUpdateFromPreviousObjects)
+                ? _previousToObjects
+                : IGListJournalReplayObjects(record.fromObjects);
+            }
+            NSArray *toObjects = (record.flags & IGListJournalUpdateHasToObjects)
+            ? IGListJournalReplayObjects(record.toObjects)
+            : nil;
+            _previousToObjects = toObjects ?: @[];
+
+            const BOOL animated = (record.flags & IGListJournalUpdateAnimated) != 0;
+            IGListUpdatingCompletion completion = [self beginPendingUpdate];
+            const SEL deltaSelector = @selector(performUpdateWithCollectionView:fromObjects:toObjects:delta:animated:objectTransitionBlock:completion:);
+            if ((record.flags & IGListJournalUpdateHasDelta) && toObjects != nil
+                && [updater respondsToSelector:deltaSelector]) {
+                NSMutableArray<IGListMoveIndex *> *moves = [NSMutableArray arrayWithCapacity:record.moves.size()];
+                for (const auto &move : record.moves) {
+                    [moves addObject:[[IGListMoveIndex alloc] initWithFrom:(NSInteger)move.first to:(NSInteger)move.second]];
+                }
+                IGListIndexSetResult *delta = [[IGListIndexSetResult alloc] initWithInserts:IGListJournalReplayIndexSet(record.inserts)
+                                                                                    deletes:IGListJournalReplayIndexSet(record.deletes)
+                                                                                    updates:IGListJournalReplayIndexSet(record.updates)
+                                                                                      moves:moves];
+                [updater performUpdateWithCollectionView:collectionView
+                                             fromObjects:fromObjects
+                                               toObjects:toObjects
+                                                   delta:delta
+                                                animated:animated
+                                   objectTransitionBlock:^(NSArray *objects, IGListIndexSetResult *appliedDelta) {}
+                                              completion:completion];
+            } else {
+                [updater performUpdateWithCollectionView:collectionView
+                                             fromObjects:fromObjects
+                                               toObjects:toObjects
+                                                animated:animated
+                                   objectTransitionBlock:^(NSArray *objects) {}
+                                              completion:completion];
+            }
+            break;
+        }
+        case IGListJournalRecordType::itemUpdates: {
+            const uint64_t blockID = record.blockID;
+            [updater performUpdateWithCollectionView:collectionView
+                                            animated:(record.flags & IGListJournalUpdateAnimated) != 0
+                                         itemUpdates:^{
+                                             [self replayRecordsOfItemUpdateBlock:blockID];
+                                         }
+                                          completion:[self beginPendingUpdate]];
+            break;
+        }
+        case IGListJournalRecordType::insertItems:
+        case IGListJournalRecordType::deleteItems: {
+            NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray arrayWithCapacity:record.indexPaths.size()];
+            for (const auto &pair : record.indexPaths) {
+                [indexPaths addObject:IGListJournalReplayIndexPath(pair)];
+            }
+            if (record.type == IGListJournalRecordType::insertItems) {
+                [updater insertItemsIntoCollectionView:collectionView indexPaths:indexPaths];
+            } else {
+                [updater deleteItemsFromCollectionView:collectionView indexPaths:indexPaths];
+            }
+            break;
+        }
+        case IGListJournalRecordType::moveItem:
+            [updater moveItemInCollectionView:collectionView
+                                fromIndexPath:IGListJournalReplayIndexPath(record.indexPaths[0])
+                                  toIndexPath:IGListJournalReplayIndexPath(record.indexPaths[1])];
+            break;
+        case IGListJournalRecordType::reloadItem:
+            [updater reloadItemInCollectionView:collectionView
+                                  fromIndexPath:IGListJournalReplayIndexPath(record.indexPaths[0])
+                                    toIndexPath:IGListJournalReplayIndexPath(record.indexPaths[1])];
+            break;
+        case IGListJournalRecordType::reloadItems: {
+            NSIndexSet *indexes = IGListJournalReplayIndexSet(record.indexes);
+            const NSInteger fromSection = (NSInteger)record.fromSection;
+            const NSInteger toSection = (NSInteger)record.toSection;
+            if ([updater respondsToSelector:@selector(reloadItemsInCollectionView:fromSection:toSection:indexes:)]) {
+                [updater reloadItemsInCollectionView:collectionView fromSection:fromSection toSection:toSection indexes:indexes];
+            } else {
+                [indexes enumerateIndexesUsingBlock:^(NSUInteger item, BOOL *stop) {
+                    [updater reloadItemInCollectionView:collectionView
+                                          fromIndexPath:[NSIndexPath indexPathForItem:item inSection:fromSection]
+                                            toIndexPath:[NSIndexPath indexPathForItem:item inSection:toSection]];
+                }];
+            }
+            break;
+        }
+        case IGListJournalRecordType::reloadSections:
+            [updater reloadCollectionView:collectionView sections:IGListJournalReplayIndexSet(record.indexes)];
+            break;
+        case IGListJournalRecordType::reloadData:
+            [updater reloadDataWithCollectionView:collectionView
+                                reloadUpdateBlock:^{}
+                                       completion:[self beginPendingUpdate]];
+            break;
+    }
+}
+
+- (void)replayRecordsOfItemUpdateBlock:(uint64_t)blockID {
+    const auto it = _blockRecords.find(blockID);
+    if (it == _blockRecords.end()) {
+        return;
+    }
+    for (const size_t index : it->second) {
+        [self replayRecordAtIndex:index];
+    }
+}
+
+- (IGListUpdatingCompletion)beginPendingUpdate {
+    _pendingUpdateCount++;
+    return ^(BOOL finished) {
+        self->_pendingUpdateCount--;
+        [self finishIfNeeded];
+    };
+}
+
+- (void)finishIfNeeded {
+    if (!_replaying || !_madeEveryCall || _pendingUpdateCount > 0) {
+        return;
+    }
+
+    void (^completion)(NSTimeInterval) = _completion;
+    const NSTimeInterval duration = CACurrentMediaTime() - _startTime;
+    _replaying = NO;
+    _updater = nil;
+    _collectionView = nil;
+    _completion = nil;
+    _previousToObjects = nil;
+    if (completion != nil) {
+        completion(duration);
+    }
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ %p; recordCount: %zi; recordedDuration: %.3fs; timeScale: %.2f; replaying: %@>",
+            NSStringFromClass(self.class), self, self.recordCount, self.recordedDuration, self.timeScale,
+            self.replaying ? @"YES" : @"NO"];
+}
+
+@end
@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Implement this protocol to decide when queued updates run. `IGListAdapterUpdater` hands its scheduler a block every
+ time it has coalesced work to perform, and performs the work when the block is called.
+ */
+NS_SWIFT_NAME(ListUpdateScheduler)
+@protocol IGListUpdateScheduler <NSObject>
+
+/**
+ Schedules an update to run on the main thread.
+
+ @param update The block to call. It must be called exactly once, on the main thread and never synchronously from this
+ method.
+
+ @note An updater schedules at most one update at a time, so a scheduler shared by several updaters never holds more
+ than one update per updater.
+ */
+- (void)scheduleUpdate:(void (^)(void))update;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -11,6 +11,8 @@
 
 @protocol IGListDiffable;
 
+@class IGListIndexSetResult;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -29,6 +31,16 @@ typedef void (^IGListUpdatingCompletion)(BOOL finished);
 NS_SWIFT_NAME(ListObjectTransitionBlock)
 typedef void (^IGListObjectTransitionBlock)(NSArray *toObjects);
 
+/**
+ A block to be called when the adapter applies changes described by a delta to the collection view.
+
+ @param toObjects The new objects in the collection.
+ @param delta The changes from the previous objects to `toObjects`, or `nil` if the delta was merged with updates it could
+ not be composed with and the objects must be transitioned as if they had been diffed.
+ */
+NS_SWIFT_NAME(ListObjectDeltaTransitionBlock)
+typedef void (^IGListObjectDeltaTransitionBlock)(NSArray *toObjects, IGListIndexSetResult *_Nullable delta);
+
 /// A block that contains all of the updates.
 NS_SWIFT_NAME(ListItemUpdateBlock)
 typedef void (^IGListItemUpdateBlock)();
@@ -156,6 +168,49 @@ NS_SWIFT_NAME(ListUpdatingDelegate)
                             itemUpdates:(IGListItemUpdateBlock)itemUpdates
                              completion:(nullable IGListUpdatingCompletion)completion;
 
+@optional
+
+/**
+ Tells the delegate to perform a section transition, reporting the changes it applies back to the adapter.
+
+ @param collectionView The collection view to perform the transition on.
+ @param fromObjects The previous objects in the collection view. Objects must conform to `IGListDiffable`.
+ @param toObjects The new objects in collection view. Objects must conform to `IGListDiffable`.
+ @param delta The changes from the objects of the last transition to `toObjects` if they are already known, which skips
+ diffing, or `nil` to have the delegate find them.
+ @param animated A flag indicating if the transition should be animated.
+ @param objectTransitionBlock A block that must be called when the adapter applies changes to the collection view.
+ @param completion A completion block to execute when the update is finished.
+
+ @note The `objectTransitionBlock` receives the changes from the objects of the last transition to the objects it is
+ passed, either the delta or the diff that replaced it, so the adapter can patch its section map instead of rebuilding
+ it. It receives `nil` if the changes are not known. If this method is not implemented,
+ -performUpdateWithCollectionView:fromObjects:toObjects:animated:objectTransitionBlock:completion: is called instead.
+ */
+- (void)performUpdateWithCollectionView:(UICollectionView *)collectionView
+                            fromObjects:(nullable NSArray<id <IGListDiffable>> *)fromObjects
+                              toObjects:(NSArray<id <IGListDiffable>> *)toObjects
+                                  delta:(nullable IGListIndexSetResult *)delta
+                               animated:(BOOL)animated
+                  objectTransitionBlock:(IGListObjectDeltaTransitionBlock)objectTransitionBlock
+                             completion:(nullable IGListUpdatingCompletion)completion;
+
+/**
+ Tells the delegate to reload several items of a single section controller.
+
+ @param collectionView The collection view on which to perform the transition.
+ @param fromSection The section of the items before the transition.
+ @param toSection The section of the items after the transition.
+ @param indexes The indexes of the items to reload.
+
+ @note Implement this to record reloads without an index path per item. If it is not implemented,
+ -reloadItemInCollectionView:fromIndexPath:toIndexPath: is called once for every index.
+ */
+- (void)reloadItemsInCollectionView:(UICollectionView *)collectionView
+                        fromSection:(NSInteger)fromSection
+                          toSection:(NSInteger)toSection
+                            indexes:(NSIndexSet *)indexes;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -18,15 +18,14 @@
 #pragma mark - UICollectionViewDataSource
 
 - (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView {
-    return self.sectionMap.objects.count;
+    return self.sectionMap.count;
 }
 
 - (NSInteger)collectionView:(UICollectionView *)collectionView numberOfItemsInSection:(NSInteger)section {
-    IGListSectionController * sectionController = [self sectionControllerForSection:section];
-    IGAssert(sectionController != nil, @"Nil section controller for section %zi for item %@. Check your -diffIdentifier and -isEqual: implementations.",
-            section, [self.sectionMap objectForSection:section]);
-    const NSInteger numberOfItems = [sectionController numberOfItems];
-    IGAssert(numberOfItems >= 0, @"Cannot return negative number of items %zi for section controller %@.", numberOfItems, sectionController);
+    // placeholders are counted without creating their section controllers when possible
+    const NSInteger numberOfItems = [self numberOfItemsInSection:section];
+    IGAssert(numberOfItems >= 0, @"Cannot return negative number of items %zi for section controller %@.",
+             numberOfItems, [self.sectionMap sectionControllerForSection:section]);
     return numberOfItems;
 }
 
@@ -130,7 +129,7 @@
     // if the section controller relationship was destroyed, reconnect it
     // this happens with iOS 10 UICollectionView display range changes
     if (sectionController == nil) {
-        sectionController = [self.sectionMap sectionControllerForSection:indexPath.section];
+        sectionController = [self sectionControllerForSection:indexPath.section];
         [self mapView:view toSectionController:sectionController];
     }
 
@@ -67,6 +67,12 @@ IGListBatchContext
 - (nullable IGListSectionController *)sectionControllerForView:(__kindof UIView *)view;
 - (void)removeMapForView:(__kindof UIView *)view;
 
+/**
+ The number of items in a section, counting a section whose section controller has not been created without creating it
+ when the data source allows.
+ */
+- (NSInteger)numberOfItemsInSection:(NSInteger)section;
+
 - (NSArray *)indexPathsFromSectionController:(IGListSectionController *)sectionController
                                      indexes:(NSIndexSet *)indexes
                   usePreviousIfInUpdateBlock:(BOOL)usePreviousIfInUpdateBlock;
@@ -31,6 +31,8 @@ static NSMutableArray *linesFromObjects(NSArray *objects) {
 #if IGLK_DEBUG_DESCRIPTION_ENABLED
     [debug addObject:[NSString stringWithFormat:@"Moves as deletes+inserts: %@", IGListDebugBOOL(self.movesAsDeletesInserts)]];
     [debug addObject:[NSString stringWithFormat:@"Allows background reloading: %@", IGListDebugBOOL(self.allowsBackgroundReloading)]];
+    [debug addObject:[NSString stringWithFormat:@"Defers offscreen updates: %@", IGListDebugBOOL(self.defersOffscreenUpdates)]];
+    [debug addObject:[NSString stringWithFormat:@"Has deferred offscreen updates: %@", IGListDebugBOOL(self.hasDeferredOffscreenUpdates)]];
     [debug addObject:[NSString stringWithFormat:@"Has queued reload data: %@", IGListDebugBOOL(self.hasQueuedReloadData)]];
     [debug addObject:[NSString stringWithFormat:@"Queued update is animated: %@", IGListDebugBOOL(self.queuedUpdateIsAnimated)]];
 
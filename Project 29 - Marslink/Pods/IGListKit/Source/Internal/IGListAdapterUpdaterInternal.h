@@ -15,12 +15,17 @@
 #import "IGListAdapterUpdater.h"
 #import "IGListBatchUpdateState.h"
 #import "IGListBatchUpdates.h"
+#import "IGListDiffExecutor.h"
+#import "IGListRunIndexSet.h"
+#import "IGListWindowObserverView.h"
+
+@class IGListUpdateCoordinator;
 
 NS_ASSUME_NONNULL_BEGIN
 
-FOUNDATION_EXTERN void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
-                                                   NSMutableIndexSet *deletes,
-                                                   NSMutableIndexSet *inserts,
+FOUNDATION_EXTERN void convertReloadToDeleteInsert(IGListRunIndexSet *reloads,
+                                                   IGListRunIndexSet *deletes,
+                                                   IGListRunIndexSet *inserts,
                                                    IGListIndexSetResult *result,
                                                    NSArray<id<IGListDiffable>> *fromObjects);
 
@@ -35,7 +40,10 @@ FOUNDATION_EXTERN void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
 
 @property (nonatomic, strong) IGListBatchUpdates *batchUpdates;
 
-@property (nonatomic, copy, nullable) IGListObjectTransitionBlock objectTransitionBlock;
+@property (nonatomic, copy, nullable) IGListObjectDeltaTransitionBlock objectTransitionBlock;
+
+// the caller's changes for the queued object update. dropped when other object updates coalesce with it
+@property (nonatomic, strong, nullable) IGListIndexSetResult *delta;
 
 @property (nonatomic, copy, nullable) IGListReloadUpdateBlock reloadUpdates;
 @property (nonatomic, assign, getter=hasQueuedReloadData) BOOL queuedReloadData;
@@ -43,10 +51,37 @@ FOUNDATION_EXTERN void convertReloadToDeleteInsert(NSMutableIndexSet *reloads,
 @property (nonatomic, assign) IGListBatchUpdateState state;
 @property (nonatomic, strong, nullable) IGListBatchUpdateData *applyingUpdateData;
 
+@property (nonatomic, assign) NSInteger hashQualitySampleCounter;
+
+// set while an update is waiting on the scheduler or coordinator, which may drop it if it goes away before running it
+@property (nonatomic, assign) BOOL updateScheduled;
+@property (nonatomic, weak, nullable) UICollectionView *scheduledCollectionView;
+
+// set by -[IGListUpdateCoordinator registerUpdater:]. takes over scheduling and diffing from this updater
+@property (nonatomic, weak, nullable) IGListUpdateCoordinator *coordinator;
+
+// set while updates are held for a collection view outside of a window. the held updates are applied with a reload
+@property (nonatomic, assign) BOOL hasDeferredOffscreenUpdates;
+@property (nonatomic, weak, nullable) IGListWindowObserverView *windowObserverView;
+
+// object updates coalesced while the current batch was in flight
+@property (nonatomic, assign) NSInteger backlogCount;
+
+@property (nonatomic, strong, readonly) IGListDiffExecutor *diffExecutor;
+
+// the update whose diff is in flight on the diff executor, reclaimed if newer objects arrive before it is applied
+@property (nonatomic, copy, nullable) NSArray *diffingFromObjects;
+@property (nonatomic, strong, nullable) NSMutableArray<IGListUpdatingCompletion> *diffingCompletionBlocks;
+@property (nonatomic, assign) BOOL diffingAnimated;
+
 - (void)performReloadDataWithCollectionView:(UICollectionView *)collectionView;
 - (void)performBatchUpdatesWithCollectionView:(UICollectionView *)collectionView;
 - (void)cleanStateBeforeUpdates;
+- (void)reclaimDiffingUpdate;
+- (BOOL)deferUpdatesIfOffscreenWithCollectionView:(UICollectionView *)collectionView;
 - (BOOL)hasChanges;
+- (void)queueUpdateWithCollectionView:(UICollectionView *)collectionView;
+- (void)rescheduleUpdate;
 
 @end
 
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListMacros.h>
+
+@class IGListBatchUpdateData;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Checks batch updates against a headless model of `UICollectionView` before they are committed, so inconsistent updates
+ can be recovered from instead of throwing inside `-[UICollectionView performBatchUpdates:completion:]`.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListBatchUpdateValidator : NSObject
+
+/**
+ Creates a validator with the section and item counts the collection view currently displays. Must be created before
+ the data source transitions to its new state.
+
+ @param collectionView The collection view about to be updated.
+
+ @return A new validator.
+ */
+- (instancetype)initWithCollectionView:(UICollectionView *)collectionView NS_DESIGNATED_INITIALIZER;
+
+/**
+ Validates update data against the counts the data source reports now.
+
+ @param updateData The update data about to be applied.
+ @param collectionView The collection view being updated.
+
+ @return `nil` if the collection view would accept the updates, otherwise a description of the first violated rule.
+ */
+- (nullable NSString *)failureReasonForUpdateData:(IGListBatchUpdateData *)updateData
+                                   collectionView:(UICollectionView *)collectionView;
+
+/**
+ Update data that deletes every section displayed before the update and inserts every section reported by the data
+ source. The collection view always accepts it.
+
+ @param collectionView The collection view being updated.
+
+ @return Update data reloading every section.
+ */
+- (IGListBatchUpdateData *)reloadingUpdateDataForCollectionView:(UICollectionView *)collectionView;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
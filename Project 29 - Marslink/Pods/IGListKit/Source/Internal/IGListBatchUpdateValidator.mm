@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListBatchUpdateValidator.h"
+
+#import <string>
+#import <vector>
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListBatchUpdateData.h>
+
+#import "IGListBatchUpdateDataInternal.h"
+#import "IGListCollectionModel.h"
+#import "IGListRunIndexSet.h"
+
+using namespace IGListKit;
+
+static IGListItemPath IGListItemPathFromIndexPath(NSIndexPath *indexPath) {
+    return {indexPath.section, indexPath.item};
+}
+
+static std::vector<int64_t> IGListDataSourceItemCounts(UICollectionView *collectionView) {
+    id<UICollectionViewDataSource> dataSource = collectionView.dataSource;
+    const NSInteger sectionCount = [dataSource respondsToSelector:@selector(numberOfSectionsInCollectionView:)]
+    ? [dataSource numberOfSectionsInCollectionView:collectionView]
+    : 1;
+    std::vector<int64_t> counts(sectionCount);
+    for (NSInteger section = 0; section < sectionCount; section++) {
+        counts[section] = [dataSource collectionView:collectionView numberOfItemsInSection:section];
+    }
+    return counts;
+}
+
+@implementation IGListBatchUpdateValidator {
+    IGListCollectionModel _model;
+}
+
+- (instancetype)initWithCollectionView:(UICollectionView *)collectionView {
+    IGParameterAssert(collectionView != nil);
+    if (self = [super init]) {
+        // the collection view's own counts, not the data source's, are what the batch is checked against
+        const NSInteger sectionCount = [collectionView numberOfSections];
+        std::vector<int64_t> counts(sectionCount);
+        for (NSInteger section = 0; section < sectionCount; section++) {
+            counts[section] = [collectionView numberOfItemsInSection:section];
+        }
+        _model = IGListCollectionModel(std::move(counts));
+    }
+    return self;
+}
+
+- (NSString *)failureReasonForUpdateData:(IGListBatchUpdateData *)updateData
+                          collectionView:(UICollectionView *)collectionView {
+    IGParameterAssert(updateData != nil);
+    IGParameterAssert(collectionView != nil);
+
+    IGListCollectionBatch batch;
+    for (const auto &run : [updateData.deleteSectionRuns runs].runs()) {
+        for (NSUInteger index = run.location; index < run.location + run.length; index++) {
+            batch.deleteSections.push_back(index);
+        }
+    }
+    for (const auto &run : [updateData.insertSectionRuns runs].runs()) {
+        for (NSUInteger index = run.location; index < run.location + run.length; index++) {
+            batch.insertSections.push_back(index);
+        }
+    }
+    for (IGListMoveIndex *move in updateData.moveSections) {
+        batch.moveSections.push_back({move.from, move.to});
+    }
+    for (NSIndexPath *path in updateData.deleteIndexPaths) {
+        batch.deleteItems.push_back(IGListItemPathFromIndexPath(path));
+    }
+    for (NSIndexPath *path in updateData.insertIndexPaths) {
+        batch.insertItems.push_back(IGListItemPathFromIndexPath(path));
+    }
+    for (IGListMoveIndexPath *move in updateData.moveIndexPaths) {
+        batch.moveItems.push_back({IGListItemPathFromIndexPath(move.from), IGListItemPathFromIndexPath(move.to)});
+    }
+
+    std::string reason;
+    if (IGListValidateCollectionBatch(_model, batch, IGListDataSourceItemCounts(collectionView), &reason)) {
+        return nil;
+    }
+    return [NSString stringWithUTF8String:reason.c_str()];
+}
+
+- (IGListBatchUpdateData *)reloadingUpdateDataForCollectionView:(UICollectionView *)collectionView {
+    id<UICollectionViewDataSource> dataSource = collectionView.dataSource;
+    const NSInteger sectionCount = [dataSource respondsToSelector:@selector(numberOfSectionsInCollectionView:)]
+    ? [dataSource numberOfSectionsInCollectionView:collectionView]
+    : 1;
+    IGListRunIndexSet *deletes = [IGListRunIndexSet new];
+    [deletes addIndexesInRange:NSMakeRange(0, (NSUInteger)_model.sectionCount())];
+    IGListRunIndexSet *inserts = [IGListRunIndexSet new];
+    [inserts addIndexesInRange:NSMakeRange(0, sectionCount)];
+    return [[IGListBatchUpdateData alloc] initWithInsertSectionRuns:inserts
+                                                  deleteSectionRuns:deletes
+                                                       moveSections:[NSSet new]
+                                                   insertIndexPaths:@[]
+                                                   deleteIndexPaths:@[]
+                                                     moveIndexPaths:@[]];
+}
+
+@end
@@ -11,21 +11,61 @@
 
 #import <IGListKit/IGListMacros.h>
 
-@class IGListMoveIndexPath;
-@class IGListReloadIndexPath;
+#ifdef __cplusplus
+#import "IGListItemUpdateRecorder.h"
+#endif
+
+@class IGListBatchUpdateData;
+@class IGListMoveIndex;
+@class IGListRunIndexSet;
+
+NS_ASSUME_NONNULL_BEGIN
 
 IGLK_SUBCLASSING_RESTRICTED
 @interface IGListBatchUpdates : NSObject
 
-@property (nonatomic, strong, readonly) NSMutableIndexSet *sectionReloads;
-@property (nonatomic, strong, readonly) NSMutableArray<NSIndexPath *> *itemInserts;
-@property (nonatomic, strong, readonly) NSMutableArray<NSIndexPath *> *itemDeletes;
-@property (nonatomic, strong, readonly) NSMutableArray<IGListReloadIndexPath *> *itemReloads;
-@property (nonatomic, strong, readonly) NSMutableArray<IGListMoveIndexPath *> *itemMoves;
+@property (nonatomic, strong, readonly) IGListRunIndexSet *sectionReloads;
 
 @property (nonatomic, strong, readonly) NSMutableArray<void (^)()> *itemUpdateBlocks;
 @property (nonatomic, strong, readonly) NSMutableArray<void (^)(BOOL)> *itemCompletionBlocks;
 
+/**
+ Item operations are recorded as packed (section, item) pairs rather than index path objects. Index paths are only
+ created for the operations that survive -updateDataWithInsertSections:deleteSections:moveSections:.
+ */
+- (void)recordItemInserts:(NSArray<NSIndexPath *> *)indexPaths;
+- (void)recordItemDeletes:(NSArray<NSIndexPath *> *)indexPaths;
+- (void)recordItemMoveFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+- (void)recordItemReloadFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+/**
+ Records a reload of every item at `indexes` in a section that may have moved, without creating any objects.
+
+ @param fromSection The section before the update.
+ @param toSection The section after the update.
+ @param indexes The item indexes to reload.
+ */
+- (void)recordItemReloadsFromSection:(NSInteger)fromSection toSection:(NSInteger)toSection indexes:(NSIndexSet *)indexes;
+
 - (BOOL)hasChanges;
 
+/**
+ Removes every recorded operation and block, keeping the storage for the next batch.
+ */
+- (void)reset;
+
+/**
+ Builds the update data for the given section changes and the recorded item operations. Item reloads are converted to a
+ delete plus an insert.
+ */
+- (IGListBatchUpdateData *)updateDataWithInsertSections:(IGListRunIndexSet *)insertSections
+                                         deleteSections:(IGListRunIndexSet *)deleteSections
+                                           moveSections:(NSSet<IGListMoveIndex *> *)moveSections;
+
+#ifdef __cplusplus
+- (const IGListKit::IGListItemUpdateRecorder &)itemUpdates;
+#endif
+
 @end
+
+NS_ASSUME_NONNULL_END
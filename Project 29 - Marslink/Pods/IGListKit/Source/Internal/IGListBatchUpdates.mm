@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListBatchUpdates.h"
+
+#import <vector>
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListBatchUpdateData.h>
+
+#import "IGListBatchUpdateDataInternal.h"
+#import "IGListRunIndexSet.h"
+
+using namespace IGListKit;
+
+@implementation IGListBatchUpdates {
+    IGListItemUpdateRecorder _itemUpdates;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _sectionReloads = [IGListRunIndexSet new];
+        _itemUpdateBlocks = [NSMutableArray new];
+        _itemCompletionBlocks = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (const IGListItemUpdateRecorder &)itemUpdates {
+    return _itemUpdates;
+}
+
+- (void)recordItemInserts:(NSArray<NSIndexPath *> *)indexPaths {
+    for (NSIndexPath *path in indexPaths) {
+        _itemUpdates.insertItem(path.section, path.item);
+    }
+}
+
+- (void)recordItemDeletes:(NSArray<NSIndexPath *> *)indexPaths {
+    for (NSIndexPath *path in indexPaths) {
+        _itemUpdates.deleteItem(path.section, path.item);
+    }
+}
+
+- (void)recordItemMoveFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    _itemUpdates.moveItem(fromIndexPath.section, fromIndexPath.item, toIndexPath.section, toIndexPath.item);
+}
+
+- (void)recordItemReloadFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    _itemUpdates.reloadItem(fromIndexPath.section, fromIndexPath.item, toIndexPath.section, toIndexPath.item);
+}
+
+- (void)recordItemReloadsFromSection:(NSInteger)fromSection toSection:(NSInteger)toSection indexes:(NSIndexSet *)indexes {
+    IGListItemUpdateRecorder *recorder = &_itemUpdates;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            recorder->reloadItem(fromSection, index, toSection, index);
+        }
+    }];
+}
+
+- (BOOL)hasChanges {
+    return [self.itemUpdateBlocks count] > 0
+    || [self.sectionReloads count] > 0
+    || !_itemUpdates.empty();
+}
+
+- (void)reset {
+    [_sectionReloads removeAllIndexes];
+    [_itemUpdateBlocks removeAllObjects];
+    [_itemCompletionBlocks removeAllObjects];
+    _itemUpdates.clear();
+}
+
+- (IGListBatchUpdateData *)updateDataWithInsertSections:(IGListRunIndexSet *)insertSections
+                                         deleteSections:(IGListRunIndexSet *)deleteSections
+                                           moveSections:(NSSet<IGListMoveIndex *> *)moveSections {
+    std::vector<uint64_t> itemInserts;
+    std::vector<uint64_t> itemDeletes;
+    _itemUpdates.flush(itemInserts, itemDeletes);
+    return [[IGListBatchUpdateData alloc] initWithInsertSectionRuns:insertSections
+                                                  deleteSectionRuns:deleteSections
+                                                       moveSections:moveSections
+                                             packedInsertIndexPaths:itemInserts
+                                             packedDeleteIndexPaths:itemDeletes
+                                               packedMoveIndexPaths:_itemUpdates.moves()];
+}
+
+@end
@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListCollectionModel_h
+#define IGListCollectionModel_h
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "IGListBatchUpdateCleanup.h"
+
+namespace IGListKit {
+
+struct IGListItemPath {
+    int64_t section;
+    int64_t item;
+};
+
+struct IGListItemMove {
+    IGListItemPath from;
+    IGListItemPath to;
+};
+
+/// Every operation of a -[UICollectionView performBatchUpdates:completion:] call, as in IGListBatchUpdateData.
+struct IGListCollectionBatch {
+    std::vector<int64_t> deleteSections;
+    std::vector<int64_t> insertSections;
+    /// (from, to) section moves.
+    std::vector<std::pair<int64_t, int64_t>> moveSections;
+    std::vector<IGListItemPath> deleteItems;
+    std::vector<IGListItemPath> insertItems;
+    std::vector<IGListItemMove> moveItems;
+};
+
+/**
+ A headless model of the section and item counts of a UICollectionView and the consistency rules it enforces when a
+ batch update is committed. Applying a batch the collection view would reject fails with the reason UIKit would give,
+ and leaves the model unchanged.
+ */
+class IGListCollectionModel {
+public:
+    IGListCollectionModel() {}
+
+    explicit IGListCollectionModel(std::vector<int64_t> itemCounts) : _itemCounts(std::move(itemCounts)) {}
+
+    const std::vector<int64_t> &itemCounts() const {
+        return _itemCounts;
+    }
+
+    int64_t sectionCount() const {
+        return (int64_t)_itemCounts.size();
+    }
+
+    /**
+     Applies a batch update.
+
+     @param batch The operations.
+     @param insertedSectionCount Returns the item count of an inserted section by its new index, the way the collection
+     view asks its data source.
+     @param reason Set to a description of the first violated rule on failure. Optional.
+
+     @return `true` if the collection view would accept the batch.
+     */
+    bool apply(const IGListCollectionBatch &batch,
+               const std::function<int64_t(int64_t)> &insertedSectionCount,
+               std::string *reason) {
+        auto fail = [reason](const std::string &message) {
+            if (reason != nullptr) {
+                *reason = message;
+            }
+            return false;
+        };
+        const int64_t oldSectionCount = sectionCount();
+        const int64_t newSectionCount = oldSectionCount
+        - (int64_t)batch.deleteSections.size()
+        + (int64_t)batch.insertSections.size();
+        if (newSectionCount < 0) {
+            return fail("deleted more sections than exist");
+        }
+
+        // sections: every old section is deleted, moved, or fills the next free new slot in order
+        std::vector<int64_t> oldState(oldSectionCount, kUntouched);
+        std::vector<int64_t> newState(newSectionCount, kUntouched);
+        for (const int64_t section : batch.deleteSections) {
+            if (section < 0 || section >= oldSectionCount) {
+                return fail("attempt to delete section " + std::to_string(section) + ", but there are only "
+                            + std::to_string(oldSectionCount) + " sections before the update");
+            }
+            if (oldState[section] != kUntouched) {
+                return fail("attempt to perform multiple updates for section " + std::to_string(section));
+            }
+            oldState[section] = kDeleted;
+        }
+        for (const int64_t section : batch.insertSections) {
+            if (section < 0 || section >= newSectionCount) {
+                return fail("attempt to insert section " + std::to_string(section) + " but there are only "
+                            + std::to_string(newSectionCount) + " sections after the update");
+            }
+            if (newState[section] != kUntouched) {
+                return fail("attempt to perform multiple updates for section " + std::to_string(section));
+            }
+            newState[section] = kInserted;
+        }
+        std::vector<int64_t> oldToNew(oldSectionCount, kDeleted);
+        std::vector<int64_t> newToOld(newSectionCount, kInserted);
+        for (const auto &move : batch.moveSections) {
+            if (move.first < 0 || move.first >= oldSectionCount || move.second < 0 || move.second >= newSectionCount) {
+                return fail("attempt to move section " + std::to_string(move.first) + " to "
+                            + std::to_string(move.second) + ", which is out of bounds");
+            }
+            if (oldState[move.first] != kUntouched || newState[move.second] != kUntouched) {
+                return fail("attempt to perform multiple updates for section " + std::to_string(move.first));
+            }
+            oldState[move.first] = kMoved;
+            newState[move.second] = kMoved;
+            oldToNew[move.first] = move.second;
+            newToOld[move.second] = move.first;
+        }
+        int64_t slot = 0;
+        for (int64_t section = 0; section < oldSectionCount; section++) {
+            if (oldState[section] != kUntouched) {
+                continue;
+            }
+            while (slot < newSectionCount && newState[slot] != kUntouched) {
+                slot++;
+            }
+            if (slot == newSectionCount) {
+                return fail("invalid number of sections");
+            }
+            oldToNew[section] = slot;
+            newToOld[slot] = section;
+            slot++;
+        }
+
+        // items: collect per-section counts and reject out of bounds or repeated operations
+        std::vector<int64_t> removedCounts(oldSectionCount, 0);
+        std::vector<int64_t> addedCounts(newSectionCount, 0);
+        std::vector<uint64_t> removedItems;
+        std::vector<uint64_t> addedItems;
+        for (const auto &path : batch.deleteItems) {
+            if (path.section < 0 || path.section >= oldSectionCount || path.item < 0
+                || path.item >= _itemCounts[path.section]) {
+                return fail("attempt to delete item " + std::to_string(path.item) + " from section "
+                            + std::to_string(path.section) + " which does not exist before the update");
+            }
+            if (oldState[path.section] == kDeleted) {
+                // the whole section goes away
+                continue;
+            }
+            removedCounts[path.section]++;
+            removedItems.push_back(IGListPackIndexPath(path.section, path.item));
+        }
+        for (const auto &move : batch.moveItems) {
+            if (move.from.section < 0 || move.from.section >= oldSectionCount || move.from.item < 0
+                || move.from.item >= _itemCounts[move.from.section]) {
+                return fail("attempt to move index path from section " + std::to_string(move.from.section)
+                            + " which does not exist before the update");
+            }
+            if (move.to.section < 0 || move.to.section >= newSectionCount || move.to.item < 0) {
+                return fail("attempt to move index path to section " + std::to_string(move.to.section)
+                            + " which does not exist after the update");
+            }
+            if (oldState[move.from.section] == kDeleted || newState[move.to.section] == kInserted) {
+                return fail("attempt to move an item out of a deleted section or into an inserted section");
+            }
+            removedCounts[move.from.section]++;
+            addedCounts[move.to.section]++;
+            removedItems.push_back(IGListPackIndexPath(move.from.section, move.from.item));
+            addedItems.push_back(IGListPackIndexPath(move.to.section, move.to.item));
+        }
+        for (const auto &path : batch.insertItems) {
+            if (path.section < 0 || path.section >= newSectionCount || path.item < 0) {
+                return fail("attempt to insert item " + std::to_string(path.item) + " into section "
+                            + std::to_string(path.section) + ", but there are only "
+                            + std::to_string(newSectionCount) + " sections after the update");
+            }
+            if (newState[path.section] == kInserted) {
+                // the whole section is loaded from the data source
+                continue;
+            }
+            addedCounts[path.section]++;
+            addedItems.push_back(IGListPackIndexPath(path.section, path.item));
+        }
+        if (_hasDuplicates(removedItems)) {
+            return fail("attempt to delete or move the same index path more than once");
+        }
+        if (_hasDuplicates(addedItems)) {
+            return fail("attempt to insert or move to the same index path more than once");
+        }
+
+        // new counts: surviving sections carry their items over, inserted sections ask the data source
+        std::vector<int64_t> newCounts(newSectionCount, 0);
+        for (int64_t section = 0; section < newSectionCount; section++) {
+            const int64_t oldSection = newToOld[section];
+            if (oldSection == kInserted) {
+                newCounts[section] = insertedSectionCount(section);
+            } else {
+                newCounts[section] = _itemCounts[oldSection] - removedCounts[oldSection] + addedCounts[section];
+            }
+            if (newCounts[section] < 0) {
+                return fail("invalid number of items in section " + std::to_string(section));
+            }
+        }
+        for (uint64_t key : addedItems) {
+            const int64_t section = (int64_t)IGListPackedSection(key);
+            const int64_t item = (int64_t)(uint32_t)key;
+            if (item >= newCounts[section]) {
+                return fail("attempt to insert item " + std::to_string(item) + " into section "
+                            + std::to_string(section) + ", but there are only "
+                            + std::to_string(newCounts[section]) + " items in section " + std::to_string(section)
+                            + " after the update");
+            }
+        }
+
+        _itemCounts.swap(newCounts);
+        return true;
+    }
+
+private:
+    enum : int64_t {
+        kUntouched = -1,
+        kDeleted = -2,
+        kInserted = -3,
+        kMoved = -4,
+    };
+
+    static bool _hasDuplicates(std::vector<uint64_t> &keys) {
+        std::sort(keys.begin(), keys.end());
+        return std::adjacent_find(keys.begin(), keys.end()) != keys.end();
+    }
+
+    std::vector<int64_t> _itemCounts;
+};
+
+/**
+ Checks a batch against the counts the data source reports after the update, the way UICollectionView does when it
+ commits the batch.
+
+ @param before The counts displayed before the update.
+ @param batch The operations.
+ @param after The counts reported by the data source after the update.
+ @param reason Set to a description of the first violated rule on failure. Optional.
+
+ @return `true` if the collection view would accept the batch.
+ */
+inline bool IGListValidateCollectionBatch(const IGListCollectionModel &before,
+                                          const IGListCollectionBatch &batch,
+                                          const std::vector<int64_t> &after,
+                                          std::string *reason) {
+    IGListCollectionModel model = before;
+    const int64_t afterSectionCount = (int64_t)after.size();
+    if (!model.apply(batch, [&after, afterSectionCount](int64_t section) {
+        return section < afterSectionCount ? after[section] : 0;
+    }, reason)) {
+        return false;
+    }
+    if (model.sectionCount() != afterSectionCount) {
+        if (reason != nullptr) {
+            *reason = "invalid number of sections. The number of sections after the update ("
+            + std::to_string(afterSectionCount) + ") must be equal to the number of sections before the update ("
+            + std::to_string(before.sectionCount()) + "), plus or minus the number of sections inserted or deleted";
+        }
+        return false;
+    }
+    for (int64_t section = 0; section < afterSectionCount; section++) {
+        if (model.itemCounts()[section] != after[section]) {
+            if (reason != nullptr) {
+                *reason = "invalid number of items in section " + std::to_string(section)
+                + ". The number of items after the update (" + std::to_string(after[section])
+                + ") must be equal to the number of items before the update, plus or minus the number of items "
+                + "inserted or deleted (" + std::to_string(model.itemCounts()[section]) + ")";
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace IGListKit
+
+#endif /* IGListCollectionModel_h */
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListExperiments.h>
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListMovePlanning.h>
+
+@class IGListIndexSetResult;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Diffs two arrays the way IGListAdapterUpdater does, applying move planning when the experiment is enabled.
+ */
+FOUNDATION_EXTERN IGListIndexSetResult *IGListAdapterUpdaterDiff(NSArray *_Nullable fromObjects,
+                                                                 NSArray *_Nullable toObjects,
+                                                                 IGListExperiment experiments,
+                                                                 IGListMoveCostModel moveCostModel);
+
+/**
+ Removes objects with duplicate identifiers the way IGListAdapterUpdater does before diffing.
+ */
+FOUNDATION_EXTERN NSArray *IGListAdapterUpdaterObjectsWithDuplicateIdentifiersRemoved(NSArray *_Nullable objects);
+
+/**
+ An immutable capture of everything a diff reads. Snapshots are built on the main thread and handed to the diff queue,
+ so nothing the updater mutates afterwards is visible to the diff.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListDiffSnapshot : NSObject
+
+@property (nonatomic, copy, readonly, nullable) NSArray *fromObjects;
+
+/**
+ The objects to diff to. Duplicate identifiers are removed on the diff queue.
+ */
+@property (nonatomic, copy, readonly, nullable) NSArray *toObjects;
+
+@property (nonatomic, assign, readonly) IGListExperiment experiments;
+
+@property (nonatomic, assign, readonly) IGListMoveCostModel moveCostModel;
+
+- (instancetype)initWithFromObjects:(nullable NSArray *)fromObjects
+                          toObjects:(nullable NSArray *)toObjects
+                        experiments:(IGListExperiment)experiments
+                      moveCostModel:(IGListMoveCostModel)moveCostModel NS_DESIGNATED_INITIALIZER;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+/**
+ Completion for a diff submitted to an IGListDiffExecutor.
+
+ @param toObjects The snapshot's toObjects with duplicate identifiers removed.
+ @param result The diff result.
+ */
+typedef void (^IGListDiffExecutorCompletion)(NSArray *_Nullable toObjects, IGListIndexSetResult *result);
+
+/**
+ Runs diffs one at a time on a dedicated serial queue and delivers results on the main queue.
+
+ Every submission starts a new generation. A diff whose generation is superseded before it starts is skipped, and a
+ result that lands after its generation was superseded is dropped, so only the newest submission is ever delivered.
+ Submitting and cancelling must happen on the main thread.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListDiffExecutor : NSObject
+
+/**
+ `YES` between submitting a diff and its result being delivered or cancelled.
+ */
+@property (nonatomic, assign, readonly, getter=isDiffing) BOOL diffing;
+
+/**
+ Diffs a snapshot on the diff queue, superseding any diff still in flight.
+
+ @param snapshot The snapshot to diff.
+ @param completion A block called on the main queue with the result, unless the diff is superseded first.
+ */
+- (void)diffSnapshot:(IGListDiffSnapshot *)snapshot completion:(IGListDiffExecutorCompletion)completion;
+
+/**
+ Supersedes the diff in flight, if any, without submitting a new one.
+ */
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListDiffExecutor.h"
+
+#import <atomic>
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListDiff.h>
+
+#import "IGListArrayUtilsInternal.h"
+#import "IGListTracing.h"
+
+IGListIndexSetResult *IGListAdapterUpdaterDiff(NSArray *fromObjects,
+                                               NSArray *toObjects,
+                                               IGListExperiment experiments,
+                                               IGListMoveCostModel moveCostModel) {
+    const uint64_t trace = IGListTraceBegin();
+    IGListIndexSetResult *result = IGListDiffExperiment(fromObjects, toObjects, IGListDiffEquality, experiments);
+    if (IGListExperimentEnabled(experiments, IGListExperimentMovePlanning)) {
+        result = IGListIndexSetResultPlanningMoves(result, moveCostModel);
+    }
+    IGListTraceEnd(trace, "diff", fromObjects.count + toObjects.count);
+    return result;
+}
+
+NSArray *IGListAdapterUpdaterObjectsWithDuplicateIdentifiersRemoved(NSArray *objects) {
+    const uint64_t trace = IGListTraceBegin();
+    NSArray *uniqueObjects = objectsWithDuplicateIdentifiersRemoved(objects);
+    IGListTraceEnd(trace, "removeDuplicateIdentifiers", objects.count);
+    return uniqueObjects;
+}
+
+@implementation IGListDiffSnapshot
+
+- (instancetype)initWithFromObjects:(NSArray *)fromObjects
+                          toObjects:(NSArray *)toObjects
+                        experiments:(IGListExperiment)experiments
+                      moveCostModel:(IGListMoveCostModel)moveCostModel {
+    if (self = [super init]) {
+        _fromObjects = [fromObjects copy];
+        _toObjects = [toObjects copy];
+        _experiments = experiments;
+        _moveCostModel = moveCostModel;
+    }
+    return self;
+}
+
+@end
+
+@implementation IGListDiffExecutor {
+    dispatch_queue_t _queue;
+    // written on main, read on the diff queue to skip superseded work
+    std::atomic<uint64_t> _generation;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
+        _queue = dispatch_queue_create("com.instagram.IGListKit.IGListDiffExecutor", attributes);
+        _generation = 0;
+    }
+    return self;
+}
+
+- (void)diffSnapshot:(IGListDiffSnapshot *)snapshot completion:(IGListDiffExecutorCompletion)completion {
+    IGAssertMainThread();
+    IGParameterAssert(snapshot != nil);
+    IGParameterAssert(completion != nil);
+
+    const uint64_t generation = ++_generation;
+    _diffing = YES;
+
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_async(_queue, ^{
+        __typeof__(self) strongSelf = weakSelf;
+        if (strongSelf == nil || strongSelf->_generation.load() != generation) {
+            return;
+        }
+
+        NSArray *toObjects = IGListAdapterUpdaterObjectsWithDuplicateIdentifiersRemoved(snapshot.toObjects);
+        IGListIndexSetResult *result = IGListAdapterUpdaterDiff(snapshot.fromObjects,
+                                                                toObjects,
+                                                                snapshot.experiments,
+                                                                snapshot.moveCostModel);
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            __typeof__(self) mainSelf = weakSelf;
+            if (mainSelf == nil || mainSelf->_generation.load() != generation) {
+                return;
+            }
+            mainSelf->_diffing = NO;
+            completion(toObjects, result);
+        });
+    });
+}
+
+- (void)cancel {
+    IGAssertMainThread();
+    ++_generation;
+    _diffing = NO;
+}
+
+@end
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListFrameSchedule_h
+#define IGListFrameSchedule_h
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+namespace IGListKit {
+
+/**
+ The scheduling policy of `IGListFrameUpdateScheduler`, kept free of Objective-C so it can be tested and benchmarked
+ without a display.
+
+ Updates run in the order they were pushed. A frame runs the updates pending when it starts until they have used up the
+ budget, and the rest wait, still first in line, for the next frame. At least one update runs every frame, so an update
+ that exceeds the budget on its own still makes progress. Updates pushed while a frame is running wait for the next one.
+ */
+template <typename Update>
+class IGListFrameQueue {
+public:
+    void push(Update update) {
+        _pending.push_back(std::move(update));
+    }
+
+    bool empty() const {
+        return _pending.empty();
+    }
+
+    size_t size() const {
+        return _pending.size();
+    }
+
+    /// The number of times an update was left for a later frame because the budget was used up.
+    size_t deferredCount() const {
+        return _deferredCount;
+    }
+
+    void clear() {
+        _pending.clear();
+    }
+
+    /**
+     Runs one frame of updates.
+
+     @param budget The time the frame's updates may use, in the units of `now`.
+     @param now Returns the current time.
+     @param run Performs an update. It may push more updates.
+
+     @return The number of updates run.
+     */
+    template <typename Now, typename Run>
+    size_t runFrame(double budget, Now now, Run run) {
+        const double start = now();
+        const size_t count = _pending.size();
+        size_t ran = 0;
+        while (ran < count) {
+            if (ran > 0 && now() - start >= budget) {
+                break;
+            }
+            // taken off the queue first, so updates pushed while it runs queue behind the ones deferred
+            Update update = std::move(_pending.front());
+            _pending.pop_front();
+            run(update);
+            ran++;
+        }
+        _deferredCount += count - ran;
+        return ran;
+    }
+
+private:
+    std::deque<Update> _pending;
+    size_t _deferredCount = 0;
+};
+
+/**
+ Time that only moves when told to, behind `IGListMockClock`. Frames fall on multiples of the frame duration, and
+ boundaries that work ran past are skipped like a display link skips them.
+ */
+class IGListSteppedClock {
+public:
+    explicit IGListSteppedClock(double frameDuration = 1.0 / 60.0) : _frameDuration(frameDuration) {}
+
+    double currentTime() const {
+        return _currentTime;
+    }
+
+    void setCurrentTime(double currentTime) {
+        _currentTime = currentTime;
+    }
+
+    double frameDuration() const {
+        return _frameDuration;
+    }
+
+    void setFrameDuration(double frameDuration) {
+        _frameDuration = frameDuration;
+    }
+
+    void advance(double interval) {
+        _currentTime += interval;
+    }
+
+    /// Moves to the next frame boundary and returns its timestamp.
+    double nextFrame() {
+        double next = (std::floor(_currentTime / _frameDuration) + 1) * _frameDuration;
+        // a time already on a boundary can round down to the previous one
+        if (next <= _currentTime) {
+            next += _frameDuration;
+        }
+        _currentTime = next;
+        return _currentTime;
+    }
+
+private:
+    double _currentTime = 0;
+    double _frameDuration;
+};
+
+} // namespace IGListKit
+
+#endif /* IGListFrameSchedule_h */
@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListItemUpdateRecorder_h
+#define IGListItemUpdateRecorder_h
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "IGListBatchUpdateCleanup.h"
+
+namespace IGListKit {
+
+/**
+ An open addressing hash set of packed index paths. Clearing keeps the table, so a set reused across batches of a
+ similar size stops allocating once warmed up.
+ */
+class IGListPackedKeySet {
+public:
+    IGListPackedKeySet() : _count(0) {}
+
+    /// Adds `key`, returning false if it was already present.
+    bool insert(uint64_t key) {
+        assert(key != _emptyKey());
+        // keep the load factor at or below 1/2 so probe sequences stay short
+        if ((_count + 1) * 2 > _slots.size()) {
+            _grow();
+        }
+        const size_t mask = _slots.size() - 1;
+        for (size_t i = _hash(key) & mask;; i = (i + 1) & mask) {
+            if (_slots[i] == key) {
+                return false;
+            }
+            if (_slots[i] == _emptyKey()) {
+                _slots[i] = key;
+                _count++;
+                return true;
+            }
+        }
+    }
+
+    bool contains(uint64_t key) const {
+        if (_count == 0) {
+            return false;
+        }
+        const size_t mask = _slots.size() - 1;
+        for (size_t i = _hash(key) & mask;; i = (i + 1) & mask) {
+            if (_slots[i] == key) {
+                return true;
+            }
+            if (_slots[i] == _emptyKey()) {
+                return false;
+            }
+        }
+    }
+
+    size_t size() const {
+        return _count;
+    }
+
+    void clear() {
+        if (_count > 0) {
+            std::fill(_slots.begin(), _slots.end(), _emptyKey());
+            _count = 0;
+        }
+    }
+
+private:
+    // section and item UINT32_MAX, which no collection view can reach
+    static uint64_t _emptyKey() {
+        return ~(uint64_t)0;
+    }
+
+    static size_t _hash(uint64_t key) {
+        const uint64_t h = key * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h ^ (h >> 32));
+    }
+
+    void _grow() {
+        std::vector<uint64_t> old;
+        old.swap(_slots);
+        _slots.assign(old.empty() ? 16 : old.size() * 2, _emptyKey());
+        _count = 0;
+        for (const uint64_t key : old) {
+            if (key != _emptyKey()) {
+                insert(key);
+            }
+        }
+    }
+
+    std::vector<uint64_t> _slots;
+    size_t _count;
+};
+
+/**
+ Records the item operations queued during a batch update as packed index paths. Nothing is allocated per operation
+ beyond amortized vector growth; index path objects are only created for the operations that survive the flush.
+ */
+class IGListItemUpdateRecorder {
+public:
+    void insertItem(int64_t section, int64_t item) {
+        _inserts.push_back(IGListPackIndexPath(section, item));
+    }
+
+    /// Deleting the same index path twice is recorded once.
+    void deleteItem(int64_t section, int64_t item) {
+        const uint64_t key = IGListPackIndexPath(section, item);
+        if (_deleteKeys.insert(key)) {
+            _deletes.push_back(key);
+        }
+    }
+
+    void moveItem(int64_t fromSection, int64_t fromItem, int64_t toSection, int64_t toItem) {
+        _moves.push_back({IGListPackIndexPath(fromSection, fromItem), IGListPackIndexPath(toSection, toItem)});
+    }
+
+    void reloadItem(int64_t fromSection, int64_t fromItem, int64_t toSection, int64_t toItem) {
+        _reloads.push_back({IGListPackIndexPath(fromSection, fromItem), IGListPackIndexPath(toSection, toItem)});
+    }
+
+    bool empty() const {
+        return _inserts.empty() && _deletes.empty() && _moves.empty() && _reloads.empty();
+    }
+
+    /// Forgets every operation but keeps the vectors and key sets, so the next batch records into warm storage.
+    void clear() {
+        _inserts.clear();
+        _deletes.clear();
+        _moves.clear();
+        _reloads.clear();
+        _deleteKeys.clear();
+        _reloadFromKeys.clear();
+        _reloadToKeys.clear();
+    }
+
+    const std::vector<uint64_t> &inserts() const {
+        return _inserts;
+    }
+
+    const std::vector<uint64_t> &deletes() const {
+        return _deletes;
+    }
+
+    const std::vector<IGListPackedMove> &moves() const {
+        return _moves;
+    }
+
+    const std::vector<IGListPackedMove> &reloads() const {
+        return _reloads;
+    }
+
+    /**
+     The item inserts and deletes to apply. Reloads are unsafe inside -performBatchUpdates:, so each reload of an item
+     that is not also deleted becomes a delete of its old index path and an insert of its new one, once per index path.
+     */
+    void flush(std::vector<uint64_t> &inserts, std::vector<uint64_t> &deletes) {
+        inserts = _inserts;
+        deletes = _deletes;
+        _reloadFromKeys.clear();
+        _reloadToKeys.clear();
+        for (const auto &reload : _reloads) {
+            if (_deleteKeys.contains(reload.from)) {
+                continue;
+            }
+            if (_reloadFromKeys.insert(reload.from)) {
+                deletes.push_back(reload.from);
+            }
+            if (_reloadToKeys.insert(reload.to)) {
+                inserts.push_back(reload.to);
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> _inserts;
+    std::vector<uint64_t> _deletes;
+    std::vector<IGListPackedMove> _moves;
+    std::vector<IGListPackedMove> _reloads;
+    IGListPackedKeySet _deleteKeys;
+    IGListPackedKeySet _reloadFromKeys;
+    IGListPackedKeySet _reloadToKeys;
+};
+
+} // namespace IGListKit
+
+#endif /* IGListItemUpdateRecorder_h */
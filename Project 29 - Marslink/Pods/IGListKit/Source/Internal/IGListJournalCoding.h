@@ -0,0 +1,396 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListJournalCoding_h
+#define IGListJournalCoding_h
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ The update journal is a 5 byte header ("IGLJ" and a version byte) followed by records. Every record starts with a type
+ byte, the microseconds since the previous record and the item update block it was made in (0 for none), both as
+ varints. Integers are unsigned LEB128 varints except identifier hashes, which are fixed 8 byte little endian since they
+ rarely compress. Index sets are a count of ranges, each as the gap from the end of the previous range and a length.
+ */
+namespace IGListKit {
+
+static const uint8_t IGListJournalVersion = 1;
+
+enum class IGListJournalRecordType : uint8_t {
+    performUpdate = 1,   // flags, [from objects], [to objects], [delta]
+    itemUpdates = 2,     // animated, block id
+    insertItems = 3,     // index paths
+    deleteItems = 4,     // index paths
+    moveItem = 5,        // from section, from item, to section, to item
+    reloadItem = 6,      // from section, from item, to section, to item
+    reloadItems = 7,     // from section, to section, indexes
+    reloadSections = 8,  // indexes
+    reloadData = 9,
+};
+
+enum IGListJournalUpdateFlags : uint8_t {
+    IGListJournalUpdateAnimated = 1 << 0,
+    IGListJournalUpdateHasFromObjects = 1 << 1,
+    // the from objects are the to objects of the previous update, so they are not written again
+    IGListJournalUpdateFromPreviousObjects = 1 << 2,
+    IGListJournalUpdateHasToObjects = 1 << 3,
+    IGListJournalUpdateHasDelta = 1 << 4,
+};
+
+/// An object reduced to the hash of its diff identifier and a version that changes when its contents do.
+struct IGListJournalObject {
+    uint64_t identifier;
+    uint64_t version;
+
+    bool operator==(const IGListJournalObject &other) const {
+        return identifier == other.identifier && version == other.version;
+    }
+};
+
+/// Ranges as (location, length).
+typedef std::vector<std::pair<uint64_t, uint64_t>> IGListJournalRanges;
+
+struct IGListJournalRecord {
+    IGListJournalRecordType type;
+    // microseconds since the journal started
+    uint64_t time;
+    uint64_t parentBlockID;
+
+    uint8_t flags;
+    uint64_t blockID;
+    std::vector<IGListJournalObject> fromObjects;
+    std::vector<IGListJournalObject> toObjects;
+    IGListJournalRanges inserts;
+    IGListJournalRanges deletes;
+    IGListJournalRanges updates;
+    // delta moves as (from, to)
+    std::vector<std::pair<uint64_t, uint64_t>> moves;
+    // (section, item) pairs. a move or reload has its origin first and destination second
+    std::vector<std::pair<uint64_t, uint64_t>> indexPaths;
+    uint64_t fromSection;
+    uint64_t toSection;
+    // reloaded items or sections
+    IGListJournalRanges indexes;
+
+    IGListJournalRecord() : type(IGListJournalRecordType::reloadData), time(0), parentBlockID(0), flags(0), blockID(0),
+    fromSection(0), toSection(0) {}
+};
+
+class IGListJournalWriter {
+public:
+    IGListJournalWriter() : _recordCount(0) {
+        _bytes.push_back('I');
+        _bytes.push_back('G');
+        _bytes.push_back('L');
+        _bytes.push_back('J');
+        _bytes.push_back(IGListJournalVersion);
+    }
+
+    void beginRecord(IGListJournalRecordType type, uint64_t elapsed, uint64_t parentBlockID) {
+        _bytes.push_back((uint8_t)type);
+        writeVarint(elapsed);
+        writeVarint(parentBlockID);
+        _recordCount++;
+    }
+
+    void writeByte(uint8_t byte) {
+        _bytes.push_back(byte);
+    }
+
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            _bytes.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        _bytes.push_back((uint8_t)value);
+    }
+
+    void writeFixed64(uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            _bytes.push_back((uint8_t)(value >> (8 * i)));
+        }
+    }
+
+    void writeObjects(const std::vector<IGListJournalObject> &objects) {
+        writeVarint(objects.size());
+        for (const auto &object : objects) {
+            writeFixed64(object.identifier);
+            writeVarint(object.version);
+        }
+    }
+
+    /// Ranges must be sorted and disjoint, as an index set's are.
+    void writeRanges(const IGListJournalRanges &ranges) {
+        writeVarint(ranges.size());
+        uint64_t end = 0;
+        for (const auto &range : ranges) {
+            writeVarint(range.first - end);
+            writeVarint(range.second);
+            end = range.first + range.second;
+        }
+    }
+
+    void writePairs(const std::vector<std::pair<uint64_t, uint64_t>> &pairs) {
+        writeVarint(pairs.size());
+        for (const auto &pair : pairs) {
+            writeVarint(pair.first);
+            writeVarint(pair.second);
+        }
+    }
+
+    /**
+     Appends a record in the layout `IGListJournalDecode()` reads.
+
+     @param record The record. Its `time` is ignored.
+     @param elapsed The microseconds since the previous record.
+     */
+    void writeRecord(const IGListJournalRecord &record, uint64_t elapsed) {
+        beginRecord(record.type, elapsed, record.parentBlockID);
+        switch (record.type) {
+            case IGListJournalRecordType::performUpdate:
+                writeByte(record.flags);
+                if ((record.flags & IGListJournalUpdateHasFromObjects)
+                    && !(record.flags & IGListJournalUpdateFromPreviousObjects)) {
+                    writeObjects(record.fromObjects);
+                }
+                if (record.flags & IGListJournalUpdateHasToObjects) {
+                    writeObjects(record.toObjects);
+                }
+                if (record.flags & IGListJournalUpdateHasDelta) {
+                    writeRanges(record.inserts);
+                    writeRanges(record.deletes);
+                    writeRanges(record.updates);
+                    writePairs(record.moves);
+                }
+                break;
+            case IGListJournalRecordType::itemUpdates:
+                writeByte(record.flags);
+                writeVarint(record.blockID);
+                break;
+            case IGListJournalRecordType::insertItems:
+            case IGListJournalRecordType::deleteItems:
+                writePairs(record.indexPaths);
+                break;
+            case IGListJournalRecordType::moveItem:
+            case IGListJournalRecordType::reloadItem:
+                for (size_t i = 0; i < 2; i++) {
+                    const std::pair<uint64_t, uint64_t> indexPath = i < record.indexPaths.size()
+                    ? record.indexPaths[i]
+                    : std::pair<uint64_t, uint64_t>(0, 0);
+                    writeVarint(indexPath.first);
+                    writeVarint(indexPath.second);
+                }
+                break;
+            case IGListJournalRecordType::reloadItems:
+                writeVarint(record.fromSection);
+                writeVarint(record.toSection);
+                writeRanges(record.indexes);
+                break;
+            case IGListJournalRecordType::reloadSections:
+                writeRanges(record.indexes);
+                break;
+            case IGListJournalRecordType::reloadData:
+                break;
+        }
+    }
+
+    const std::vector<uint8_t> &bytes() const {
+        return _bytes;
+    }
+
+    size_t recordCount() const {
+        return _recordCount;
+    }
+
+private:
+    std::vector<uint8_t> _bytes;
+    size_t _recordCount;
+};
+
+/// Reads a journal, failing instead of reading past the end of truncated or corrupt data.
+class IGListJournalReader {
+public:
+    IGListJournalReader(const uint8_t *bytes, size_t length) : _bytes(bytes), _length(length), _offset(0) {}
+
+    bool atEnd() const {
+        return _offset >= _length;
+    }
+
+    bool readByte(uint8_t &byte) {
+        if (_offset >= _length) {
+            return false;
+        }
+        byte = _bytes[_offset++];
+        return true;
+    }
+
+    bool readVarint(uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!readByte(byte)) {
+                return false;
+            }
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readFixed64(uint64_t &value) {
+        if (_length - _offset < 8) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= (uint64_t)_bytes[_offset++] << (8 * i);
+        }
+        return true;
+    }
+
+    bool readObjects(std::vector<IGListJournalObject> &objects) {
+        uint64_t count;
+        // every object takes at least 9 bytes, which bounds the count of corrupt data
+        if (!readVarint(count) || count > (_length - _offset) / 9) {
+            return false;
+        }
+        objects.resize((size_t)count);
+        for (auto &object : objects) {
+            if (!readFixed64(object.identifier) || !readVarint(object.version)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readRanges(IGListJournalRanges &ranges) {
+        uint64_t count;
+        if (!readVarint(count) || count > (_length - _offset) / 2) {
+            return false;
+        }
+        ranges.resize((size_t)count);
+        uint64_t end = 0;
+        for (auto &range : ranges) {
+            uint64_t gap;
+            if (!readVarint(gap) || !readVarint(range.second)) {
+                return false;
+            }
+            range.first = end + gap;
+            end = range.first + range.second;
+        }
+        return true;
+    }
+
+    bool readPairs(std::vector<std::pair<uint64_t, uint64_t>> &pairs) {
+        uint64_t count;
+        if (!readVarint(count) || count > (_length - _offset) / 2) {
+            return false;
+        }
+        pairs.resize((size_t)count);
+        for (auto &pair : pairs) {
+            if (!readVarint(pair.first) || !readVarint(pair.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const uint8_t *_bytes;
+    size_t _length;
+    size_t _offset;
+};
+
+/**
+ Decodes a whole journal.
+
+ @return false if the header is wrong or a record is malformed, leaving the records decoded before it.
+ */
+inline bool IGListJournalDecode(const uint8_t *bytes, size_t length, std::vector<IGListJournalRecord> &records) {
+    if (length < 5 || bytes[0] != 'I' || bytes[1] != 'G' || bytes[2] != 'L' || bytes[3] != 'J'
+        || bytes[4] != IGListJournalVersion) {
+        return false;
+    }
+
+    IGListJournalReader reader(bytes + 5, length - 5);
+    uint64_t time = 0;
+    while (!reader.atEnd()) {
+        IGListJournalRecord record;
+        uint8_t type;
+        uint64_t elapsed;
+        if (!reader.readByte(type) || !reader.readVarint(elapsed) || !reader.readVarint(record.parentBlockID)) {
+            return false;
+        }
+        time += elapsed;
+        record.time = time;
+        record.type = (IGListJournalRecordType)type;
+
+        bool valid = true;
+        switch (record.type) {
+            case IGListJournalRecordType::performUpdate:
+                valid = reader.readByte(record.flags);
+                if (valid && (record.flags & IGListJournalUpdateHasFromObjects)
+                    && !(record.flags & IGListJournalUpdateFromPreviousObjects)) {
+                    valid = reader.readObjects(record.fromObjects);
+                }
+                if (valid && (record.flags & IGListJournalUpdateHasToObjects)) {
+                    valid = reader.readObjects(record.toObjects);
+                }
+                if (valid && (record.flags & IGListJournalUpdateHasDelta)) {
+                    valid = reader.readRanges(record.inserts)
+                    && reader.readRanges(record.deletes)
+                    && reader.readRanges(record.updates)
+                    && reader.readPairs(record.moves);
+                }
+                break;
+            case IGListJournalRecordType::itemUpdates:
+                valid = reader.readByte(record.flags) && reader.readVarint(record.blockID);
+                break;
+            case IGListJournalRecordType::insertItems:
+            case IGListJournalRecordType::deleteItems:
+                valid = reader.readPairs(record.indexPaths);
+                break;
+            case IGListJournalRecordType::moveItem:
+            case IGListJournalRecordType::reloadItem: {
+                std::pair<uint64_t, uint64_t> from, to;
+                valid = reader.readVarint(from.first) && reader.readVarint(from.second)
+                && reader.readVarint(to.first) && reader.readVarint(to.second);
+                record.indexPaths = {from, to};
+                break;
+            }
+            case IGListJournalRecordType::reloadItems:
+                valid = reader.readVarint(record.fromSection)
+                && reader.readVarint(record.toSection)
+                && reader.readRanges(record.indexes);
+                break;
+            case IGListJournalRecordType::reloadSections:
+                valid = reader.readRanges(record.indexes);
+                break;
+            case IGListJournalRecordType::reloadData:
+                break;
+            default:
+                valid = false;
+                break;
+        }
+        if (!valid) {
+            return false;
+        }
+        records.push_back(std::move(record));
+    }
+    return true;
+}
+
+} // namespace IGListKit
+
+#endif /* IGListJournalCoding_h */
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+#import <IGListKit/IGListUpdateClock.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A clock that only moves when told to, for exercising scheduling policies without a display or a run loop. Only meant
+ for tests, so it is not part of the public headers.
+
+ Time starts at zero. Update blocks can call `-advanceTime:` to simulate the cost of their work. Time is kept by the
+ `IGListSteppedClock` that Tests/linux drives `IGListFrameQueue`, the scheduling policy, with.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListMockClock : NSObject <IGListUpdateClock>
+
+/**
+ The current time, in seconds.
+ */
+@property (nonatomic, assign) CFTimeInterval currentTime;
+
+/**
+ The time between frames fired by `-fireFrame`. The default value is 1/60 of a second.
+ */
+@property (nonatomic, assign) CFTimeInterval frameDuration;
+
+/**
+ `YES` while a frame handler is set.
+ */
+@property (nonatomic, assign, readonly, getter=isRunning) BOOL running;
+
+/**
+ The number of frames delivered to a frame handler.
+ */
+@property (nonatomic, assign, readonly) NSInteger frameCount;
+
+/**
+ Moves the current time forward.
+
+ @param interval The number of seconds to advance.
+ */
+- (void)advanceTime:(CFTimeInterval)interval;
+
+/**
+ Moves the current time to the next frame boundary and calls the frame handler, if one is set.
+
+ @return `YES` if a frame handler was called.
+ */
+- (BOOL)fireFrame;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListMockClock.h"
+
+#import "IGListFrameSchedule.h"
+
+using namespace IGListKit;
+
+@implementation IGListMockClock {
+    IGListSteppedClock _clock;
+    void (^_frameHandler)(CFTimeInterval timestamp);
+}
+
+- (CFTimeInterval)currentTime {
+    return _clock.currentTime();
+}
+
+- (void)setCurrentTime:(CFTimeInterval)currentTime {
+    _clock.setCurrentTime(currentTime);
+}
+
+- (CFTimeInterval)frameDuration {
+    return _clock.frameDuration();
+}
+
+- (void)setFrameDuration:(CFTimeInterval)frameDuration {
+    _clock.setFrameDuration(frameDuration);
+}
+
+- (BOOL)isRunning {
+    return _frameHandler != nil;
+}
+
+- (void)setFrameHandler:(void (^)(CFTimeInterval))frameHandler {
+    _frameHandler = [frameHandler copy];
+}
+
+- (void)advanceTime:(CFTimeInterval)interval {
+    _clock.advance(interval);
+}
+
+- (BOOL)fireFrame {
+    const CFTimeInterval timestamp = _clock.nextFrame();
+
+    void (^frameHandler)(CFTimeInterval) = _frameHandler;
+    if (frameHandler == nil) {
+        return NO;
+    }
+    _frameCount++;
+    frameHandler(timestamp);
+    return YES;
+}
+
+@end
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <IGListKit/IGListMacros.h>
+
+@class IGListSectionController;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Holds section controllers that left an adapter's section map until the adapter hands them out for new objects,
+ grouped by class.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListSectionControllerReusePool : NSObject
+
+/**
+ The number of section controllers kept for each class. Section controllers enqueued beyond it are released.
+ */
+@property (nonatomic, assign, readonly) NSInteger maximumCountPerClass;
+
+/**
+ The number of section controllers in the pool.
+ */
+@property (nonatomic, assign, readonly) NSInteger count;
+
+/**
+ Creates a new pool.
+
+ @param maximumCountPerClass The number of section controllers kept for each class.
+
+ @return A new pool.
+ */
+- (instancetype)initWithMaximumCountPerClass:(NSInteger)maximumCountPerClass NS_DESIGNATED_INITIALIZER;
+
+/**
+ Sends a section controller `-prepareForReuse` and keeps it for reuse, unless the pool for its class is full.
+
+ @param sectionController A section controller that is no longer in any section map.
+ */
+- (void)enqueueSectionController:(IGListSectionController *)sectionController;
+
+/**
+ Removes a section controller of a class from the pool.
+
+ @param sectionControllerClass The exact class of the section controller.
+
+ @return A section controller that was prepared for reuse, or `nil` if there is none of that class.
+ */
+- (nullable IGListSectionController *)dequeueSectionControllerOfClass:(Class)sectionControllerClass;
+
+/**
+ Releases every section controller in the pool.
+ */
+- (void)removeAllSectionControllers;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
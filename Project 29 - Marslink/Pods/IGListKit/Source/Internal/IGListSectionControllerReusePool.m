@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListSectionControllerReusePool.h"
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListSectionController.h>
+
+@implementation IGListSectionControllerReusePool {
+    // keyed by class pointer, so a subclass never receives a section controller of its superclass
+    NSMapTable<Class, NSMutableArray<IGListSectionController *> *> *_sectionControllersByClass;
+}
+
+- (instancetype)initWithMaximumCountPerClass:(NSInteger)maximumCountPerClass {
+    IGParameterAssert(maximumCountPerClass >= 0);
+
+    if (self = [super init]) {
+        _maximumCountPerClass = MAX(maximumCountPerClass, 0);
+        _sectionControllersByClass = [NSMapTable mapTableWithKeyOptions:NSMapTableObjectPointerPersonality | NSMapTableStrongMemory
+                                                           valueOptions:NSMapTableStrongMemory];
+    }
+    return self;
+}
+
+- (void)enqueueSectionController:(IGListSectionController *)sectionController {
+    IGAssertMainThread();
+    IGParameterAssert(sectionController != nil);
+    IGAssert(sectionController.section == NSNotFound, @"Cannot reuse %@, it is still in section %zi",
+             sectionController, sectionController.section);
+
+    Class sectionControllerClass = [sectionController class];
+    NSMutableArray<IGListSectionController *> *sectionControllers = [_sectionControllersByClass objectForKey:sectionControllerClass];
+    if (sectionControllers == nil) {
+        sectionControllers = [NSMutableArray new];
+        [_sectionControllersByClass setObject:sectionControllers forKey:sectionControllerClass];
+    }
+    if ((NSInteger)sectionControllers.count >= _maximumCountPerClass) {
+        return;
+    }
+
+    [sectionController prepareForReuse];
+    [sectionControllers addObject:sectionController];
+    _count++;
+}
+
+- (IGListSectionController *)dequeueSectionControllerOfClass:(Class)sectionControllerClass {
+    IGAssertMainThread();
+    IGParameterAssert(sectionControllerClass != nil);
+
+    NSMutableArray<IGListSectionController *> *sectionControllers = [_sectionControllersByClass objectForKey:sectionControllerClass];
+    IGListSectionController *sectionController = sectionControllers.lastObject;
+    if (sectionController != nil) {
+        [sectionControllers removeLastObject];
+        _count--;
+    }
+    return sectionController;
+}
+
+- (void)removeAllSectionControllers {
+    IGAssertMainThread();
+
+    [_sectionControllersByClass removeAllObjects];
+    _count = 0;
+}
+
+@end
@@ -21,7 +21,7 @@
         } else {
             [debug addObject:[NSString stringWithFormat:@"Object and section controller at section: %zi:", section]];
             [debug addObject:[NSString stringWithFormat:@"  %@", object]];
-            [debug addObject:[NSString stringWithFormat:@"  %@", sectionController]];
+            [debug addObject:[NSString stringWithFormat:@"  %@", sectionController ?: @"Placeholder, section controller not created"]];
         }
     }];
 #endif // #if IGLK_DEBUG_DESCRIPTION_ENABLED
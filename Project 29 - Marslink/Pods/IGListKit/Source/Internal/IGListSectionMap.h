@@ -11,6 +11,7 @@
 
 #import <IGListKit/IGListMacros.h>
 
+@class IGListIndexSetResult;
 @class IGListSectionController;
 
 
@@ -20,26 +21,82 @@ NS_ASSUME_NONNULL_BEGIN
  The IGListSectionMap provides a way to map a collection of objects to a collection of section controllers and achieve
  constant-time lookups O(1).
 
+ Section controllers are stored by section and know their own section, so looking either up never hashes. Objects are
+ looked up through a flat table of their hashes.
+
+ A section can hold a placeholder instead of a section controller until one is set with
+ `-setSectionController:forSection:`. Looking up the section controller of a placeholder returns `nil`.
+
  IGListSectionMap is a mutable object and does not guarantee thread safety.
  */
 IGLK_SUBCLASSING_RESTRICTED
-@interface IGListSectionMap : NSObject <NSCopying>
+@interface IGListSectionMap : NSObject <NSCopying, NSFastEnumeration>
+
+/**
+ Creates a new section map.
 
-- (instancetype)initWithMapTable:(NSMapTable *)mapTable NS_DESIGNATED_INITIALIZER;
+ @param keyPointerFunctions The functions used to hash and compare objects, from
+ `-[IGListUpdatingDelegate objectLookupPointerFunctions]`. Objects are compared with `-hash` and `-isEqual:` when no hash
+ or equality function is set.
+
+ @return A new section map.
+ */
+- (instancetype)initWithKeyPointerFunctions:(NSPointerFunctions *)keyPointerFunctions NS_DESIGNATED_INITIALIZER;
 
 /**
- The objects stored in the map.
+ A copy of the objects stored in the map. Use `count`, `-objectForSection:` or fast enumeration to read them without
+ copying.
  */
 @property (nonatomic, strong, readonly) NSArray *objects;
 
+/**
+ The number of objects stored in the map.
+ */
+@property (nonatomic, assign, readonly) NSInteger count;
+
 /**
  Update the map with objects and the section controller counterparts.
 
  @param objects The objects in the collection.
- @param sectionControllers The section controllers that map to each object.
+ @param sectionControllers The section controllers that map to each object, or `NSNull` for a placeholder.
  */
 - (void)updateWithObjects:(NSArray <id <NSObject>> *)objects sectionControllers:(NSArray <IGListSectionController *> *)sectionControllers;
 
+/**
+ Check if a delta can be applied to the map.
+
+ @param delta The changes from the objects in the map to `objects`.
+ @param objects The objects in the collection after the changes.
+
+ @return A description of why the delta does not fit the map, or `nil` if it can be applied.
+ */
+- (nullable NSString *)failureReasonForDelta:(IGListIndexSetResult *)delta toObjects:(NSArray <id <NSObject>> *)objects;
+
+/**
+ Patch the map with known changes instead of rebuilding it. Sections before the first change are only compared by
+ identity when their object is a new instance, and their section controllers are not visited.
+
+ @param delta The changes from the objects in the map to `objects`.
+ @param objects The objects in the collection after the changes.
+ @param insertedSectionControllers The section controllers for the objects at `delta.inserts`, in ascending order, or
+ `NSNull` for a placeholder.
+
+ @return The sections that were not inserted and whose object was replaced by an instance that `-isObjectUpdated:` would
+ report as updated, or `nil` if a section that was not inserted holds an object that is not equal to the one it held,
+ e.g. because the map was rebuilt from other objects than the delta was diffed from. The map is not changed then.
+ */
+- (nullable NSIndexSet *)applyDelta:(IGListIndexSetResult *)delta
+                 toObjects:(NSArray <id <NSObject>> *)objects
+insertedSectionControllers:(NSArray <IGListSectionController *> *)insertedSectionControllers;
+
+/**
+ Replace the placeholder at a section with a section controller.
+
+ @param sectionController The section controller for the object at `section`.
+ @param section A section that holds a placeholder.
+ */
+- (void)setSectionController:(IGListSectionController *)sectionController forSection:(NSInteger)section;
+
 /**
  Fetch a section controller given a section.
 
@@ -85,6 +142,18 @@ IGLK_SUBCLASSING_RESTRICTED
  */
 - (NSInteger)sectionForObject:(id)object;
 
+/**
+ Check if an object is new to the map or replaces an instance with different contents.
+
+ @param object The object to look up.
+
+ @return `YES` if the section controller for the object should receive `-didUpdateToObject:`, otherwise `NO`.
+
+ @note Versioned objects (see `-[IGListDiffable diffVersion]`) that replace an instance with the same version are not
+ considered updated.
+ */
+- (BOOL)isObjectUpdated:(id)object;
+
 /**
  Remove all saved objects and section controllers.
  */
@@ -98,9 +167,13 @@ IGLK_SUBCLASSING_RESTRICTED
 /**
  Applies a given block object to the entries of the section controller map.
 
- @param block A block object to operate on entries in the section controller map.
+ @param block A block object to operate on entries in the section controller map. The section controller is `nil` for a
+ placeholder.
+
+ @note The entries are not copied, so the map must not be mutated from the block. Fast enumeration, which enumerates the
+ objects, raises if it is.
  */
-- (void)enumerateUsingBlock:(void (^)(id object, IGListSectionController *sectionController, NSInteger section, BOOL *stop))block;
+- (void)enumerateUsingBlock:(void (^)(id object, IGListSectionController *_Nullable sectionController, NSInteger section, BOOL *stop))block;
 
 /**
  :nodoc:
@@ -0,0 +1,445 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListSectionMap.h"
+
+#import <vector>
+
+#import <IGListKit/IGListAssert.h>
+#import <IGListKit/IGListIndexSetResult.h>
+
+#import "IGListDiffableInternal.h"
+#import "IGListIndexSetResultInternal.h"
+#import "IGListSectionControllerInternal.h"
+#import "IGListSectionTable.h"
+
+using namespace IGListKit;
+
+typedef NSUInteger (*IGListSectionMapSizeFunction)(const void *item);
+typedef NSUInteger (*IGListSectionMapHashFunction)(const void *item, IGListSectionMapSizeFunction size);
+typedef BOOL (*IGListSectionMapIsEqualFunction)(const void *item1, const void *item2, IGListSectionMapSizeFunction size);
+
+static NSUInteger IGListSectionMapObjectHash(const void *item, IGListSectionMapSizeFunction size) {
+    return [(__bridge id)item hash];
+}
+
+static BOOL IGListSectionMapObjectIsEqual(const void *item1, const void *item2, IGListSectionMapSizeFunction size) {
+    return [(__bridge id)item1 isEqual:(__bridge id)item2];
+}
+
+// only versioned objects can skip an update when the instance changes, equal pointers are the unversioned contract
+static BOOL IGListSectionMapObjectReplaced(id oldObject, id object) {
+    if (oldObject == object) {
+        return NO;
+    }
+    return !IGListDiffableHasVersions(oldObject, object) || [oldObject diffVersion] != [object diffVersion];
+}
+
+// placeholders are passed in as NSNull and stored as nil
+static IGListSectionController *IGListSectionMapSectionController(id sectionController) {
+    return sectionController != [NSNull null] ? sectionController : nil;
+}
+
+static uint64_t IGListSectionMapPointerHash(IGListSectionController *sectionController) {
+    return (uint64_t)(uintptr_t)(__bridge void *)sectionController;
+}
+
+@implementation IGListSectionMap {
+    NSPointerFunctions *_keyPointerFunctions;
+    // objects are looked up the way the updater's pointer functions compare them
+    IGListSectionMapHashFunction _hashFunction;
+    IGListSectionMapIsEqualFunction _isEqualFunction;
+    IGListSectionMapSizeFunction _sizeFunction;
+
+    NSMutableArray *_mObjects;
+    std::vector<IGListSectionController *> _sectionControllers;
+    // the lookup hash of the object in each section, so patching never hashes an object twice
+    std::vector<NSUInteger> _objectHashes;
+    IGListSectionTable _objectTable;
+
+    // section controllers know their own section, so this is only built when that does not point back into this map,
+    // as happens in a copy once the original is updated
+    IGListSectionTable _sectionControllerTable;
+    BOOL _sectionControllerTableValid;
+
+    // bumped by every mutation so enumerating the objects without a copy can detect one
+    unsigned long _mutations;
+}
+
+- (instancetype)initWithKeyPointerFunctions:(NSPointerFunctions *)keyPointerFunctions {
+    IGParameterAssert(keyPointerFunctions != nil);
+
+    if (self = [super init]) {
+        _keyPointerFunctions = [keyPointerFunctions copy];
+        // functions left unset by a personality compare objects with -hash and -isEqual:
+        _hashFunction = keyPointerFunctions.hashFunction ?: IGListSectionMapObjectHash;
+        _isEqualFunction = keyPointerFunctions.isEqualFunction ?: IGListSectionMapObjectIsEqual;
+        _sizeFunction = keyPointerFunctions.sizeFunction;
+        _mObjects = [NSMutableArray new];
+    }
+    return self;
+}
+
+
+#pragma mark - Public API
+
+- (NSArray *)objects {
+    return [_mObjects copy];
+}
+
+- (NSInteger)count {
+    return _mObjects.count;
+}
+
+- (NSInteger)sectionForSectionController:(IGListSectionController *)sectionController {
+    IGParameterAssert(sectionController != nil);
+
+    const NSInteger section = sectionController.section;
+    const NSInteger count = _sectionControllers.size();
+    if (section >= 0 && section < count && _sectionControllers[section] == sectionController) {
+        return section;
+    }
+
+    if (!_sectionControllerTableValid) {
+        _sectionControllerTable.clear();
+        _sectionControllerTable.reserve(count);
+        for (NSInteger i = 0; i < count; i++) {
+            if (_sectionControllers[i] != nil) {
+                _sectionControllerTable.insert(IGListSectionMapPointerHash(_sectionControllers[i]), i);
+            }
+        }
+        _sectionControllerTableValid = YES;
+    }
+
+    const std::vector<IGListSectionController *> &sectionControllers = _sectionControllers;
+    const int64_t found = _sectionControllerTable.find(IGListSectionMapPointerHash(sectionController), [&](int64_t candidate) {
+        return sectionControllers[candidate] == sectionController;
+    });
+    return found >= 0 ? (NSInteger)found : NSNotFound;
+}
+
+- (IGListSectionController *)sectionControllerForSection:(NSInteger)section {
+    if (section < 0 || section >= (NSInteger)_sectionControllers.size()) {
+        return nil;
+    }
+    return _sectionControllers[section];
+}
+
+- (void)updateWithObjects:(NSArray *)objects sectionControllers:(NSArray *)sectionControllers {
+    IGParameterAssert(objects.count == sectionControllers.count);
+
+    [self reset];
+
+    _mObjects = [objects mutableCopy];
+
+    const NSInteger count = objects.count;
+    _sectionControllers.reserve(count);
+    _objectHashes.reserve(count);
+    _objectTable.reserve(count);
+
+    for (NSInteger section = 0; section < count; section++) {
+        id object = objects[section];
+        IGListSectionController *sectionController = IGListSectionMapSectionController(sectionControllers[section]);
+        const NSUInteger hash = [self hashForObject:object];
+
+        _sectionControllers.push_back(sectionController);
+        _objectHashes.push_back(hash);
+        _objectTable.insert(hash, section);
+
+        sectionController.isFirstSection = (section == 0);
+        sectionController.isLastSection = (section == count - 1);
+        sectionController.section = section;
+    }
+}
+
+- (NSString *)failureReasonForDelta:(IGListIndexSetResult *)delta toObjects:(NSArray *)objects {
+    IGParameterAssert(delta != nil);
+    IGParameterAssert(objects != nil);
+
+    if ((NSInteger)_sectionControllers.size() != (NSInteger)_mObjects.count) {
+        return @"The map was reset";
+    }
+    return [delta failureReasonForDeltaFromCount:_mObjects.count toCount:objects.count];
+}
+
+- (NSIndexSet *)applyDelta:(IGListIndexSetResult *)delta
+                 toObjects:(NSArray *)objects
+insertedSectionControllers:(NSArray *)insertedSectionControllers {
+    IGParameterAssert(delta != nil);
+    IGParameterAssert(objects != nil);
+    IGParameterAssert(delta.inserts.count == insertedSectionControllers.count);
+
+    // replaced below rather than mutated, so no copy is needed
+    NSArray *oldObjects = _mObjects;
+    const NSInteger oldCount = oldObjects.count;
+    const NSInteger newCount = objects.count;
+    IGAssert((NSInteger)_sectionControllers.size() == oldCount, @"Cannot apply a delta to a map that was reset");
+
+    NSIndexSet *inserts = delta.inserts;
+    NSIndexSet *deletes = delta.deletes;
+    NSArray<IGListMoveIndex *> *moves = delta.moves;
+    NSInteger firstChange = MIN(inserts.firstIndex, deletes.firstIndex);
+    for (IGListMoveIndex *move in moves) {
+        firstChange = MIN(firstChange, MIN(move.from, move.to));
+    }
+    firstChange = MIN(firstChange, MIN(newCount, oldCount));
+
+    // flags for the old sections from the first change on that were deleted or moved away, and the old section of each
+    // new section that was moved to
+    std::vector<char> oldSectionRemoved(oldCount - firstChange, 0);
+    std::vector<NSInteger> moveSources(newCount - firstChange, NSNotFound);
+    // blocks capture C++ objects by const copy, so write through a pointer
+    char *deleted = oldSectionRemoved.data();
+    [deletes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        deleted[idx - firstChange] = 1;
+    }];
+    for (IGListMoveIndex *move in moves) {
+        oldSectionRemoved[move.from - firstChange] = 1;
+        moveSources[move.to - firstChange] = move.from;
+    }
+
+    // sections that kept their object's identity but were handed a new instance of it. the delta only describes the
+    // objects it was diffed from, so a section that kept its place must still hold an equal object
+    NSMutableIndexSet *replacedSections = [NSMutableIndexSet new];
+    for (NSInteger section = 0; section < firstChange; section++) {
+        id oldObject = oldObjects[section];
+        id object = objects[section];
+        if (oldObject == object) {
+            continue;
+        }
+        if (![self object:oldObject isEqualToObject:object]) {
+            return nil;
+        }
+        if (IGListSectionMapObjectReplaced(oldObject, object)) {
+            [replacedSections addIndex:section];
+        }
+    }
+
+    IGListSectionController *oldFirstSectionController = oldCount > 0 ? _sectionControllers.front() : nil;
+    IGListSectionController *oldLastSectionController = oldCount > 0 ? _sectionControllers.back() : nil;
+
+    // resolve the section controller of every section from the first change on. sections that are neither inserted
+    // nor moved keep their order, skipping deleted and moved old sections
+    std::vector<IGListSectionController *> shiftedSectionControllers;
+    std::vector<NSUInteger> shiftedHashes;
+    shiftedSectionControllers.reserve(newCount - firstChange);
+    shiftedHashes.reserve(newCount - firstChange);
+    NSInteger insertedIndex = 0;
+    NSInteger oldSection = firstChange;
+    for (NSInteger section = firstChange; section < newCount; section++) {
+        id object = objects[section];
+        NSInteger source = moveSources[section - firstChange];
+        if ([inserts containsIndex:section]) {
+            source = NSNotFound;
+            shiftedSectionControllers.push_back(IGListSectionMapSectionController(insertedSectionControllers[insertedIndex++]));
+        } else {
+            if (source == NSNotFound) {
+                while (oldSectionRemoved[oldSection - firstChange]) {
+                    oldSection++;
+                }
+                source = oldSection++;
+            }
+            shiftedSectionControllers.push_back(_sectionControllers[source]);
+        }
+
+        // equal objects hash alike, so only a new instance can need hashing
+        const BOOL sameInstance = source != NSNotFound && oldObjects[source] == object;
+        if (source != NSNotFound && !sameInstance) {
+            if (![self object:oldObjects[source] isEqualToObject:object]) {
+                return nil;
+            }
+            if (IGListSectionMapObjectReplaced(oldObjects[source], object)) {
+                [replacedSections addIndex:section];
+            }
+        }
+        shiftedHashes.push_back(sameInstance ? _objectHashes[source] : [self hashForObject:object]);
+    }
+
+    [deletes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        IGListSectionController *sectionController = self->_sectionControllers[idx];
+        sectionController.section = NSNotFound;
+        sectionController.isFirstSection = NO;
+        sectionController.isLastSection = NO;
+    }];
+
+    for (NSInteger section = firstChange; section < oldCount; section++) {
+        _objectTable.remove(_objectHashes[section], section);
+    }
+    _sectionControllers.resize(firstChange);
+    _objectHashes.resize(firstChange);
+    _sectionControllers.insert(_sectionControllers.end(), shiftedSectionControllers.begin(), shiftedSectionControllers.end());
+    _objectHashes.insert(_objectHashes.end(), shiftedHashes.begin(), shiftedHashes.end());
+    for (NSInteger section = firstChange; section < newCount; section++) {
+        _objectTable.insert(_objectHashes[section], section);
+        _sectionControllers[section].section = section;
+    }
+    _sectionControllerTableValid = NO;
+
+    _mObjects = [objects mutableCopy];
+    _mutations++;
+
+    oldFirstSectionController.isFirstSection = NO;
+    oldLastSectionController.isLastSection = NO;
+    if (newCount > 0) {
+        _sectionControllers.front().isFirstSection = YES;
+        _sectionControllers.back().isLastSection = YES;
+    }
+    return replacedSections;
+}
+
+- (void)setSectionController:(IGListSectionController *)sectionController forSection:(NSInteger)section {
+    IGParameterAssert(sectionController != nil);
+
+    const NSInteger count = _sectionControllers.size();
+    IGAssert(section >= 0 && section < count && _sectionControllers[section] == nil,
+             @"Section %zi does not hold a placeholder", section);
+    if (section < 0 || section >= count || _sectionControllers[section] != nil) {
+        return;
+    }
+
+    // the objects do not change, so enumerations in progress stay valid
+    _sectionControllers[section] = sectionController;
+    if (_sectionControllerTableValid) {
+        _sectionControllerTable.insert(IGListSectionMapPointerHash(sectionController), section);
+    }
+
+    sectionController.isFirstSection = (section == 0);
+    sectionController.isLastSection = (section == count - 1);
+    sectionController.section = section;
+}
+
+- (nullable IGListSectionController *)sectionControllerForObject:(id)object {
+    IGParameterAssert(object != nil);
+
+    const NSInteger section = [self sectionForObject:object];
+    return section != NSNotFound ? _sectionControllers[section] : nil;
+}
+
+- (nullable id)objectForSection:(NSInteger)section {
+    NSArray *objects = _mObjects;
+    if (section >= 0 && section < (NSInteger)objects.count) {
+        return objects[section];
+    } else {
+        return nil;
+    }
+}
+
+- (NSInteger)sectionForObject:(id)object {
+    IGParameterAssert(object != nil);
+
+    NSArray *objects = _mObjects;
+    const void *key = (__bridge const void *)object;
+    const IGListSectionMapIsEqualFunction isEqual = _isEqualFunction;
+    const IGListSectionMapSizeFunction size = _sizeFunction;
+    const int64_t section = _objectTable.find([self hashForObject:object], [&](int64_t candidate) {
+        return isEqual((__bridge const void *)objects[candidate], key, size) != NO;
+    });
+    return section >= 0 ? (NSInteger)section : NSNotFound;
+}
+
+- (BOOL)isObjectUpdated:(id)object {
+    IGParameterAssert(object != nil);
+
+    const NSInteger section = [self sectionForObject:object];
+    if (section == NSNotFound) {
+        return YES;
+    }
+
+    return IGListSectionMapObjectReplaced([self objectForSection:section], object);
+}
+
+- (void)reset {
+    for (IGListSectionController *sectionController : _sectionControllers) {
+        sectionController.section = NSNotFound;
+        sectionController.isFirstSection = NO;
+        sectionController.isLastSection = NO;
+    }
+
+    _sectionControllers.clear();
+    _objectHashes.clear();
+    _objectTable.clear();
+    _sectionControllerTable.clear();
+    _sectionControllerTableValid = NO;
+    _mutations++;
+}
+
+- (void)updateObject:(id)object {
+    IGParameterAssert(object != nil);
+    const NSInteger section = [self sectionForObject:object];
+    IGAssert(section != NSNotFound, @"Cannot update %@, it is not in the map", object);
+    if (section != NSNotFound) {
+        // the new instance is equal to the old one, so its hash and table entry stay
+        _mObjects[section] = object;
+        _mutations++;
+    }
+}
+
+- (void)enumerateUsingBlock:(void (^)(id object, IGListSectionController *sectionController, NSInteger section, BOOL *stop))block {
+    IGParameterAssert(block != nil);
+
+    BOOL stop = NO;
+    const unsigned long mutations = _mutations;
+    for (NSInteger section = 0; section < (NSInteger)_mObjects.count; section++) {
+        block(_mObjects[section], [self sectionControllerForSection:section], section, &stop);
+        if (stop) {
+            break;
+        }
+        if (mutations != _mutations) {
+            IGFailAssert(@"%@ was mutated while being enumerated", self);
+            break;
+        }
+    }
+}
+
+#pragma mark - NSFastEnumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state
+                                  objects:(id __unsafe_unretained [])buffer
+                                    count:(NSUInteger)len {
+    if (state->state == 0) {
+        state->state = 1;
+        state->mutationsPtr = &_mutations;
+        state->extra[0] = 0;
+    }
+
+    // hand out the objects a buffer at a time instead of copying the array, the runtime raises if _mutations changes
+    const NSUInteger index = state->extra[0];
+    const NSUInteger count = MIN(len, _mObjects.count - MIN(index, _mObjects.count));
+    if (count > 0) {
+        [_mObjects getObjects:buffer range:NSMakeRange(index, count)];
+    }
+    state->itemsPtr = buffer;
+    state->extra[0] = index + count;
+    return count;
+}
+
+#pragma mark - Private API
+
+- (NSUInteger)hashForObject:(id)object {
+    return _hashFunction((__bridge const void *)object, _sizeFunction);
+}
+
+- (BOOL)object:(id)object isEqualToObject:(id)otherObject {
+    return _isEqualFunction((__bridge const void *)object, (__bridge const void *)otherObject, _sizeFunction) != NO;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone {
+    IGListSectionMap *copy = [[IGListSectionMap allocWithZone:zone] initWithKeyPointerFunctions:_keyPointerFunctions];
+    if (copy != nil) {
+        copy->_mObjects = [_mObjects mutableCopy];
+        copy->_sectionControllers = _sectionControllers;
+        copy->_objectHashes = _objectHashes;
+        copy->_objectTable = _objectTable;
+    }
+    return copy;
+}
+
+@end
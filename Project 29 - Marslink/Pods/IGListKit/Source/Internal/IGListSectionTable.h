@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListSectionTable_h
+#define IGListSectionTable_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace IGListKit {
+
+/**
+ An open addressing hash table from a precomputed hash to a section. Several sections may share a hash, so lookups take a
+ predicate that confirms a candidate section. Removal shifts entries back instead of leaving tombstones, so a table
+ patched many times probes as quickly as a fresh one.
+ */
+class IGListSectionTable {
+public:
+    IGListSectionTable() : _count(0) {}
+
+    /// Makes room for `count` entries without growing.
+    void reserve(size_t count) {
+        size_t capacity = 16;
+        while (capacity < count * 2) {
+            capacity *= 2;
+        }
+        if (capacity > _slots.size()) {
+            _rehash(capacity);
+        }
+    }
+
+    void insert(uint64_t hash, int64_t section) {
+        // keep the load factor at or below 1/2 so probe sequences stay short
+        if ((_count + 1) * 2 > _slots.size()) {
+            _rehash(_slots.empty() ? 16 : _slots.size() * 2);
+        }
+        const size_t mask = _slots.size() - 1;
+        size_t i = _index(hash) & mask;
+        while (_slots[i].section != _emptySection()) {
+            i = (i + 1) & mask;
+        }
+        _slots[i] = {hash, section};
+        _count++;
+    }
+
+    /// Removes the entry for `section` stored under `hash`, returning false if there is none.
+    bool remove(uint64_t hash, int64_t section) {
+        if (_count == 0) {
+            return false;
+        }
+        const size_t mask = _slots.size() - 1;
+        size_t i = _index(hash) & mask;
+        for (;; i = (i + 1) & mask) {
+            if (_slots[i].section == _emptySection()) {
+                return false;
+            }
+            if (_slots[i].section == section && _slots[i].hash == hash) {
+                break;
+            }
+        }
+
+        // shift back every following entry of the run whose ideal slot is not between the hole and itself
+        for (size_t j = (i + 1) & mask; _slots[j].section != _emptySection(); j = (j + 1) & mask) {
+            const size_t ideal = _index(_slots[j].hash) & mask;
+            const bool stays = i <= j ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (!stays) {
+                _slots[i] = _slots[j];
+                i = j;
+            }
+        }
+        _slots[i].section = _emptySection();
+        _count--;
+        return true;
+    }
+
+    /// The first section stored under `hash` that `matches` accepts, or -1.
+    template <typename Matches>
+    int64_t find(uint64_t hash, const Matches &matches) const {
+        if (_count == 0) {
+            return -1;
+        }
+        const size_t mask = _slots.size() - 1;
+        for (size_t i = _index(hash) & mask; _slots[i].section != _emptySection(); i = (i + 1) & mask) {
+            if (_slots[i].hash == hash && matches(_slots[i].section)) {
+                return _slots[i].section;
+            }
+        }
+        return -1;
+    }
+
+    /// Removes every entry, keeping the table's capacity.
+    void clear() {
+        if (_count > 0) {
+            for (auto &slot : _slots) {
+                slot.section = _emptySection();
+            }
+            _count = 0;
+        }
+    }
+
+    size_t size() const {
+        return _count;
+    }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        int64_t section;
+    };
+
+    static int64_t _emptySection() {
+        return -1;
+    }
+
+    // -hash of many Foundation objects is the value itself, so spread it before masking
+    static size_t _index(uint64_t hash) {
+        const uint64_t h = hash * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h ^ (h >> 32));
+    }
+
+    void _rehash(size_t capacity) {
+        std::vector<Slot> old;
+        old.swap(_slots);
+        _slots.assign(capacity, {0, _emptySection()});
+        _count = 0;
+        for (const auto &slot : old) {
+            if (slot.section != _emptySection()) {
+                insert(slot.hash, slot.section);
+            }
+        }
+    }
+
+    std::vector<Slot> _slots;
+    size_t _count;
+};
+
+} // namespace IGListKit
+
+#endif /* IGListSectionTable_h */
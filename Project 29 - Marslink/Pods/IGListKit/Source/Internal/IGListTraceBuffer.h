@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef IGListTraceBuffer_h
+#define IGListTraceBuffer_h
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace IGListKit {
+
+/**
+ A timed section of work. Times are in the clock's ticks, names must outlive the buffer (string literals).
+ */
+struct IGListTraceSpan {
+    const char *name;
+    uint64_t start;
+    uint64_t end;
+    uint64_t thread;
+    int64_t count;
+};
+
+/**
+ A fixed size ring buffer of spans. Recording never allocates; once full, the oldest spans are overwritten.
+ */
+class IGListTraceBuffer {
+public:
+    explicit IGListTraceBuffer(size_t capacity) : _spans(std::max<size_t>(capacity, 1)), _recorded(0) {}
+
+    void record(const IGListTraceSpan &span) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _spans[_recorded % _spans.size()] = span;
+        _recorded++;
+    }
+
+    /// The retained spans, oldest first.
+    std::vector<IGListTraceSpan> spans() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const uint64_t capacity = _spans.size();
+        const uint64_t count = std::min<uint64_t>(_recorded, capacity);
+        std::vector<IGListTraceSpan> spans;
+        spans.reserve(count);
+        for (uint64_t i = _recorded - count; i < _recorded; i++) {
+            spans.push_back(_spans[i % capacity]);
+        }
+        return spans;
+    }
+
+    /// The number of spans overwritten since the last clear.
+    uint64_t droppedCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _recorded > _spans.size() ? _recorded - _spans.size() : 0;
+    }
+
+    size_t capacity() const {
+        return _spans.size();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _recorded = 0;
+    }
+
+private:
+    std::vector<IGListTraceSpan> _spans;
+    uint64_t _recorded;
+    mutable std::mutex _mutex;
+};
+
+inline void IGListTraceAppendJSONString(std::string &json, const char *string) {
+    json += '"';
+    for (const char *c = string; *c != '\0'; c++) {
+        switch (*c) {
+            case '"':
+                json += "\\\"";
+                break;
+            case '\\':
+                json += "\\\\";
+                break;
+            default:
+                if ((unsigned char)*c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)*c);
+                    json += escaped;
+                } else {
+                    json += *c;
+                }
+                break;
+        }
+    }
+    json += '"';
+}
+
+/**
+ Formats spans as Chrome trace-event JSON, loadable in chrome://tracing and Perfetto.
+
+ @param spans The spans to export.
+ @param microsecondsPerTick Converts span times to microseconds.
+ @param mainThread The thread to label "main".
+ */
+inline std::string IGListTraceChromeJSON(const std::vector<IGListTraceSpan> &spans,
+                                         double microsecondsPerTick,
+                                         uint64_t mainThread) {
+    // chrome://tracing wants small timestamps, so make them relative to the first span
+    uint64_t origin = UINT64_MAX;
+    for (const auto &span : spans) {
+        origin = std::min(origin, span.start);
+    }
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char buffer[160];
+    snprintf(buffer, sizeof(buffer),
+             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,\"args\":{\"name\":\"main\"}}",
+             (unsigned long long)mainThread);
+    json += buffer;
+    for (const auto &span : spans) {
+        json += ",{\"name\":";
+        IGListTraceAppendJSONString(json, span.name);
+        snprintf(buffer, sizeof(buffer),
+                 ",\"cat\":\"IGListKit\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%llu,\"args\":{\"count\":%lld}}",
+                 (span.start - origin) * microsecondsPerTick,
+                 (span.end - span.start) * microsecondsPerTick,
+                 (unsigned long long)span.thread,
+                 (long long)span.count);
+        json += buffer;
+    }
+    json += "]}";
+    return json;
+}
+
+} // namespace IGListKit
+
+#endif /* IGListTraceBuffer_h */
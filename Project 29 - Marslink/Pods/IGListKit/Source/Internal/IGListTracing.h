@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <mach/mach_time.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Mirrors -[IGListTracer isEnabled]. Read without synchronization; a span racing with a toggle is kept or dropped.
+ */
+FOUNDATION_EXTERN BOOL IGListTracingEnabled;
+
+/**
+ Records a span into the shared tracer.
+
+ @param name A string literal naming the step.
+ @param start The start time in mach absolute time.
+ @param end The end time in mach absolute time.
+ @param count The number of objects, changes or blocks the step covered.
+ */
+FOUNDATION_EXTERN void IGListTraceRecordSpan(const char *name, uint64_t start, uint64_t end, NSInteger count);
+
+/**
+ Begins a span. Returns 0 while tracing is disabled, which makes the matching IGListTraceEnd free.
+ */
+NS_INLINE uint64_t IGListTraceBegin(void) {
+    return IGListTracingEnabled ? mach_absolute_time() : 0;
+}
+
+/**
+ Ends a span begun with IGListTraceBegin. A macro so that `count` is only evaluated while tracing.
+ */
+#define IGListTraceEnd(start, name, count) \
+    do { \
+        if ((start) != 0) { \
+            IGListTraceRecordSpan((name), (start), mach_absolute_time(), (count)); \
+        } \
+    } while (0)
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListUpdateCoordinator.h>
+
+#import "IGListDiffExecutor.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface IGListUpdateCoordinator ()
+
+/**
+ Collects an update for the next frame. Updates run parent-first by the depth of their collection view.
+
+ @param updater The updater the update belongs to. If the updater stops being coordinated, or the coordinator is
+ deallocated, before the frame, the update is scheduled again with `-[IGListAdapterUpdater rescheduleUpdate]`.
+ @param collectionView The collection view the update applies to.
+ @param update The block performing the update.
+ */
+- (void)scheduleUpdateForUpdater:(IGListAdapterUpdater *)updater
+                  collectionView:(UICollectionView *)collectionView
+                           block:(void (^)(void))update;
+
+/**
+ Diffs a snapshot alongside every other diff prepared in the same frame. Completions are called on the main thread in
+ submission order once all of the frame's diffs have finished.
+
+ @param snapshot The snapshot to diff.
+ @param completion A block called with the result.
+ */
+- (void)diffSnapshot:(IGListDiffSnapshot *)snapshot completion:(IGListDiffExecutorCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListUpdateJournal.h>
+
+@class IGListIndexSetResult;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface IGListUpdateJournal ()
+
+- (void)recordUpdateFromObjects:(nullable NSArray *)fromObjects
+                      toObjects:(nullable NSArray *)toObjects
+                          delta:(nullable IGListIndexSetResult *)delta
+                       animated:(BOOL)animated;
+
+/**
+ Records a call to perform item updates.
+
+ @return The ID of the item update block, to pass to -beginItemUpdateBlock: when the block runs.
+ */
+- (uint64_t)recordItemUpdatesAnimated:(BOOL)animated;
+
+/**
+ Tags the records made until the matching -endItemUpdateBlock as made inside an item update block. Blocks can nest.
+ */
+- (void)beginItemUpdateBlock:(uint64_t)blockID;
+
+- (void)endItemUpdateBlock;
+
+- (void)recordInsertItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths;
+
+- (void)recordDeleteItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths;
+
+- (void)recordMoveItemFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+- (void)recordReloadItemFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+- (void)recordReloadItemsFromSection:(NSInteger)fromSection toSection:(NSInteger)toSection indexes:(NSIndexSet *)indexes;
+
+- (void)recordReloadSections:(NSIndexSet *)sections;
+
+- (void)recordReloadData;
+
+@end
+
+NS_ASSUME_NONNULL_END
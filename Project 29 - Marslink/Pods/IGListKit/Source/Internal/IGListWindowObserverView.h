@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import <IGListKit/IGListMacros.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A hidden, empty view that reports when it moves to a window. Added to a collection view, it tells when the collection
+ view enters a window, which UIKit offers no notification for.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListWindowObserverView : UIView
+
+/**
+ Called each time the view moves to a window, or out of one with a `nil` window.
+ */
+@property (nonatomic, copy, nullable) void (^didMoveToWindowBlock)(UIWindow *_Nullable window);
+
+@end
+
+NS_ASSUME_NONNULL_END
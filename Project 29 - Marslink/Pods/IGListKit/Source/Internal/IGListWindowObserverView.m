@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "IGListWindowObserverView.h"
+
+@implementation IGListWindowObserverView
+
+- (instancetype)initWithFrame:(CGRect)frame {
+    if (self = [super initWithFrame:frame]) {
+        self.hidden = YES;
+        self.userInteractionEnabled = NO;
+    }
+    return self;
+}
+
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+
+    void (^block)(UIWindow *) = self.didMoveToWindowBlock;
+    if (block != nil) {
+        block(self.window);
+    }
+}
+
+@end
@@ -18,6 +18,7 @@
 #import <IGListKit/IGListSectionController.h>
 #import <IGListKit/IGListWorkingRangeDelegate.h>
 
+#import "IGListAdapterInternal.h"
 #import "IGListWorkingRangeDelegate.h"
 
 struct _IGListWorkingRangeHandlerIndexPath {
@@ -119,14 +120,13 @@ typedef std::unordered_set<_IGListWorkingRangeHandlerIndexPath, _IGListWorkingRa
         end = 0;
     } else {
         start = MAX(*visibleSectionSet.begin() - _workingRangeSize, 0);
-        end = MIN(*visibleSectionSet.rbegin() + 1 + _workingRangeSize, (NSInteger)listAdapter.objects.count);
+        end = MIN(*visibleSectionSet.rbegin() + 1 + _workingRangeSize, listAdapter.sectionMap.count);
     }
 
     // Build the current set of working range section controllers
     _IGListWorkingRangeSectionControllerSet workingRangeSectionControllers (visibleSectionSet.size());
     for (NSInteger idx = start; idx < end; idx++) {
-        id item = [listAdapter objectAtSection:idx];
-        IGListSectionController *sectionController = [listAdapter sectionControllerForObject:item];
+        IGListSectionController *sectionController = [listAdapter sectionControllerForSection:idx];
         workingRangeSectionControllers.insert({sectionController});
     }
 
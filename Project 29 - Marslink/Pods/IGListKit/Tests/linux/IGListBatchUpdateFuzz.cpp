@@ -0,0 +1,312 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Fuzzes and benchmarks the path of -[UICollectionView ig_applyBatchUpdateData:] without UIKit. Each workload is a
+// random data source change expressed the way IGListAdapterUpdater records it, including the operations
+// IGListBatchUpdateData has to clean up. The cleaned batch must be accepted by IGListCollectionModel and produce the
+// counts the data source reports after the change.
+//
+//     IGListBatchUpdateFuzz [--iterations N] [--seed S]
+//     IGListBatchUpdateFuzz --bench [--sections N] [--items N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "IGListBatchUpdateCleanup.h"
+#include "IGListCollectionModel.h"
+
+using namespace IGListKit;
+
+namespace {
+
+struct IGListBatchWorkload {
+    std::vector<int64_t> before;
+    std::vector<int64_t> after;
+
+    // as recorded by the updater, before IGListBatchUpdateData cleans them up
+    std::vector<size_t> insertSections;
+    std::vector<size_t> deleteSections;
+    std::vector<std::pair<size_t, size_t>> moveSections;
+    std::vector<IGListItemPath> insertItems;
+    std::vector<IGListItemPath> deleteItems;
+    std::vector<IGListItemMove> moveItems;
+};
+
+int64_t IGListRandom(std::mt19937_64 &rng, int64_t bound) {
+    return bound > 0 ? (int64_t)(rng() % (uint64_t)bound) : 0;
+}
+
+bool IGListChance(std::mt19937_64 &rng, int64_t oneIn) {
+    return IGListRandom(rng, oneIn) == 0;
+}
+
+// Changes the items of an old section that survives at `toSection`. Deletes and move origins use `fromSection`, inserts
+// and move destinations use `toSection`, and the new count is returned.
+int64_t IGListChangeItems(std::mt19937_64 &rng,
+                          int64_t fromSection,
+                          int64_t toSection,
+                          int64_t count,
+                          int64_t maxChanges,
+                          bool allowsMoves,
+                          IGListBatchWorkload &workload) {
+    // old item, or -1 for an inserted one, in their new order
+    std::vector<int64_t> items;
+    std::vector<int64_t> moved;
+    for (int64_t item = 0; item < count; item++) {
+        const int64_t roll = IGListRandom(rng, 8);
+        if (roll == 0 && (int64_t)workload.deleteItems.size() < maxChanges) {
+            workload.deleteItems.push_back({fromSection, item});
+            // the adapter can delete an index path twice, which the cleanup deduplicates
+            if (IGListChance(rng, 4)) {
+                workload.deleteItems.push_back({fromSection, item});
+            }
+        } else if (roll == 1 && allowsMoves) {
+            moved.push_back(item);
+        } else {
+            items.push_back(item);
+        }
+    }
+    for (const int64_t item : moved) {
+        items.insert(items.begin() + IGListRandom(rng, items.size() + 1), item);
+    }
+    const int64_t inserts = IGListRandom(rng, 3);
+    for (int64_t i = 0; i < inserts; i++) {
+        items.insert(items.begin() + IGListRandom(rng, items.size() + 1), -1);
+    }
+    for (int64_t index = 0; index < (int64_t)items.size(); index++) {
+        if (items[index] < 0) {
+            workload.insertItems.push_back({toSection, index});
+        } else if (std::find(moved.begin(), moved.end(), items[index]) != moved.end()) {
+            workload.moveItems.push_back({{fromSection, items[index]}, {toSection, index}});
+        }
+    }
+    return (int64_t)items.size();
+}
+
+IGListBatchWorkload IGListMakeWorkload(std::mt19937_64 &rng, int64_t maxSections, int64_t maxItems) {
+    IGListBatchWorkload workload;
+    const int64_t sectionCount = IGListRandom(rng, maxSections + 1);
+    for (int64_t section = 0; section < sectionCount; section++) {
+        workload.before.push_back(IGListRandom(rng, maxItems + 1));
+    }
+
+    // sections: delete some, relocate some of the rest, and insert new ones. sections that are not relocated keep
+    // their relative order, as UICollectionView requires
+    std::vector<int64_t> order;
+    std::vector<char> relocated(sectionCount, 0);
+    std::vector<int64_t> relocations;
+    for (int64_t section = 0; section < sectionCount; section++) {
+        if (IGListChance(rng, 6)) {
+            workload.deleteSections.push_back(section);
+            // changes to the items of a deleted section are discarded, or dropped by the cleanup if they are moves
+            if (workload.before[section] > 0 && IGListChance(rng, 3)) {
+                workload.deleteItems.push_back({section, IGListRandom(rng, workload.before[section])});
+            }
+            if (workload.before[section] > 1 && IGListChance(rng, 3)) {
+                workload.moveItems.push_back({{section, 0}, {0, 0}});
+            }
+        } else if (IGListChance(rng, 8)) {
+            relocated[section] = 1;
+            relocations.push_back(section);
+        } else {
+            order.push_back(section);
+        }
+    }
+    for (const int64_t section : relocations) {
+        order.insert(order.begin() + IGListRandom(rng, order.size() + 1), section);
+    }
+    const int64_t insertCount = IGListRandom(rng, 3);
+    for (int64_t i = 0; i < insertCount; i++) {
+        order.insert(order.begin() + IGListRandom(rng, order.size() + 1), -1);
+    }
+
+    const int64_t maxChanges = std::max<int64_t>(1, maxItems / 4);
+    workload.after.resize(order.size());
+    for (int64_t newSection = 0; newSection < (int64_t)order.size(); newSection++) {
+        const int64_t oldSection = order[newSection];
+        if (oldSection < 0) {
+            workload.insertSections.push_back(newSection);
+            workload.after[newSection] = IGListRandom(rng, maxItems + 1);
+            continue;
+        }
+        const int64_t count = workload.before[oldSection];
+        if (!relocated[oldSection]) {
+            workload.after[newSection] = IGListChangeItems(rng, oldSection, newSection, count, maxChanges, true, workload);
+            continue;
+        }
+        workload.moveSections.push_back({oldSection, newSection});
+        // item changes in a moved section make the cleanup reload it with a delete and an insert
+        workload.after[newSection] = IGListChance(rng, 2)
+        ? IGListChangeItems(rng, oldSection, newSection, count, maxChanges, false, workload)
+        : count;
+    }
+    return workload;
+}
+
+// What IGListBatchUpdateData and -ig_applyBatchUpdateData: hand to UICollectionView for a workload.
+IGListCollectionBatch IGListCleanUpWorkload(const IGListBatchWorkload &workload) {
+    IGListBatchUpdateCleanup cleanup;
+    for (const size_t section : workload.insertSections) {
+        cleanup.insertSections.set(section);
+    }
+    for (const size_t section : workload.deleteSections) {
+        cleanup.deleteSections.set(section);
+    }
+    cleanup.sectionMoves = workload.moveSections;
+    for (const auto &path : workload.insertItems) {
+        cleanup.insertItems.push_back(IGListPackIndexPath(path.section, path.item));
+    }
+    for (const auto &path : workload.deleteItems) {
+        cleanup.deleteItems.push_back(IGListPackIndexPath(path.section, path.item));
+    }
+    for (const auto &move : workload.moveItems) {
+        cleanup.itemMoveFromSections.push_back(move.from.section);
+    }
+    cleanup.run();
+
+    IGListCollectionBatch batch;
+    cleanup.insertSections.enumerateRanges([&batch](size_t location, size_t length) {
+        for (size_t section = location; section < location + length; section++) {
+            batch.insertSections.push_back(section);
+        }
+    });
+    cleanup.deleteSections.enumerateRanges([&batch](size_t location, size_t length) {
+        for (size_t section = location; section < location + length; section++) {
+            batch.deleteSections.push_back(section);
+        }
+    });
+    for (const size_t position : cleanup.keptSectionMoves) {
+        batch.moveSections.push_back({(int64_t)workload.moveSections[position].first,
+                                      (int64_t)workload.moveSections[position].second});
+    }
+    for (const size_t position : cleanup.keptInsertItems) {
+        batch.insertItems.push_back(workload.insertItems[position]);
+    }
+    for (const size_t position : cleanup.keptDeleteItems) {
+        batch.deleteItems.push_back(workload.deleteItems[position]);
+    }
+    for (const size_t position : cleanup.keptItemMoves) {
+        batch.moveItems.push_back(workload.moveItems[position]);
+    }
+    return batch;
+}
+
+void IGListPrintWorkload(const IGListBatchWorkload &workload) {
+    auto print = [](const char *name, const std::vector<int64_t> &values) {
+        fprintf(stderr, "%s:", name);
+        for (const int64_t value : values) {
+            fprintf(stderr, " %lld", (long long)value);
+        }
+        fprintf(stderr, "\n");
+    };
+    print("before", workload.before);
+    print("after", workload.after);
+    for (const size_t section : workload.deleteSections) {
+        fprintf(stderr, "delete section %zu\n", section);
+    }
+    for (const size_t section : workload.insertSections) {
+        fprintf(stderr, "insert section %zu\n", section);
+    }
+    for (const auto &move : workload.moveSections) {
+        fprintf(stderr, "move section %zu -> %zu\n", move.first, move.second);
+    }
+    for (const auto &path : workload.deleteItems) {
+        fprintf(stderr, "delete item %lld-%lld\n", (long long)path.section, (long long)path.item);
+    }
+    for (const auto &path : workload.insertItems) {
+        fprintf(stderr, "insert item %lld-%lld\n", (long long)path.section, (long long)path.item);
+    }
+    for (const auto &move : workload.moveItems) {
+        fprintf(stderr, "move item %lld-%lld -> %lld-%lld\n", (long long)move.from.section, (long long)move.from.item,
+                (long long)move.to.section, (long long)move.to.item);
+    }
+}
+
+int IGListRunFuzz(uint64_t seed, int64_t iterations) {
+    std::mt19937_64 rng(seed);
+    for (int64_t iteration = 0; iteration < iterations; iteration++) {
+        const IGListBatchWorkload workload = IGListMakeWorkload(rng, 12, 8);
+        const IGListCollectionBatch batch = IGListCleanUpWorkload(workload);
+        std::string reason;
+        if (!IGListValidateCollectionBatch(IGListCollectionModel(workload.before), batch, workload.after, &reason)) {
+            fprintf(stderr, "iteration %lld rejected: %s\n", (long long)iteration, reason.c_str());
+            IGListPrintWorkload(workload);
+            return 1;
+        }
+    }
+    printf("%lld batches accepted\n", (long long)iterations);
+    return 0;
+}
+
+int IGListRunBenchmark(uint64_t seed, int64_t sections, int64_t items, int64_t iterations) {
+    std::mt19937_64 rng(seed);
+    std::vector<IGListBatchWorkload> workloads;
+    for (int64_t i = 0; i < 16; i++) {
+        workloads.push_back(IGListMakeWorkload(rng, sections, items));
+    }
+
+    double cleanupMs = 0;
+    double applyMs = 0;
+    size_t operations = 0;
+    for (int64_t iteration = 0; iteration < iterations; iteration++) {
+        const IGListBatchWorkload &workload = workloads[iteration % workloads.size()];
+        const auto start = std::chrono::steady_clock::now();
+        const IGListCollectionBatch batch = IGListCleanUpWorkload(workload);
+        const auto cleaned = std::chrono::steady_clock::now();
+        if (!IGListValidateCollectionBatch(IGListCollectionModel(workload.before), batch, workload.after, nullptr)) {
+            fprintf(stderr, "benchmark batch %lld rejected\n", (long long)iteration);
+            return 1;
+        }
+        const auto applied = std::chrono::steady_clock::now();
+        cleanupMs += std::chrono::duration<double, std::milli>(cleaned - start).count();
+        applyMs += std::chrono::duration<double, std::milli>(applied - cleaned).count();
+        operations += workload.deleteItems.size() + workload.insertItems.size() + workload.moveItems.size();
+    }
+    printf("sections=%lld items<=%lld iterations=%lld item-ops/batch=%.0f cleanup=%.3fms apply=%.3fms per batch\n",
+           (long long)sections, (long long)items, (long long)iterations, (double)operations / iterations,
+           cleanupMs / iterations, applyMs / iterations);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool bench = false;
+    uint64_t seed = 1;
+    int64_t iterations = -1;
+    int64_t sections = 2000;
+    int64_t items = 64;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = strtoll(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--sections") == 0 && hasValue) {
+            sections = strtoll(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--items") == 0 && hasValue) {
+            items = strtoll(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--bench] [--seed S] [--iterations N] [--sections N] [--items N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (bench) {
+        return IGListRunBenchmark(seed, sections, items, iterations > 0 ? iterations : 200);
+    }
+    return IGListRunFuzz(seed, iterations > 0 ? iterations : 20000);
+}
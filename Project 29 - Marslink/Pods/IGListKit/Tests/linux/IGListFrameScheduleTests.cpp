@@ -0,0 +1,332 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Checks the scheduling policy of IGListFrameUpdateScheduler against the stepped clock behind IGListMockClock: updates
+// run first in, first out, a frame stops once the budget is used up but always runs one update, and updates scheduled
+// during a frame wait for the next one. With --bench, adapters whose data changes faster than the frame rate are
+// simulated and the resulting update latency and per-frame work are reported for several budgets.
+//
+//     IGListFrameScheduleTests [--iterations N] [--seed S]
+//     IGListFrameScheduleTests --bench [--adapters N] [--seconds N]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "IGListFrameSchedule.h"
+
+using namespace IGListKit;
+
+namespace {
+
+// IGListFrameUpdateScheduler's default budget, half a 60Hz frame
+const double IGListDefaultBudget = 1.0 / 120.0;
+
+int IGListFailures = 0;
+
+void IGListExpect(bool condition, const char *what) {
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s\n", what);
+        IGListFailures++;
+    }
+}
+
+// an update that takes `cost` seconds of the clock and records its id when it runs
+struct IGListTimedUpdate {
+    int id;
+    double cost;
+};
+
+size_t IGListRunFrame(IGListFrameQueue<IGListTimedUpdate> &queue,
+                      IGListSteppedClock &clock,
+                      double budget,
+                      std::vector<int> &ran) {
+    clock.nextFrame();
+    return queue.runFrame(budget, [&clock]() {
+        return clock.currentTime();
+    }, [&clock, &ran](const IGListTimedUpdate &update) {
+        clock.advance(update.cost);
+        ran.push_back(update.id);
+    });
+}
+
+void IGListTestFirstInFirstOut() {
+    IGListFrameQueue<IGListTimedUpdate> queue;
+    IGListSteppedClock clock;
+    std::vector<int> ran;
+    for (int i = 0; i < 5; i++) {
+        queue.push({i, 0});
+    }
+    IGListExpect(IGListRunFrame(queue, clock, IGListDefaultBudget, ran) == 5, "cheap updates all run in one frame");
+    IGListExpect(ran == std::vector<int>({0, 1, 2, 3, 4}), "updates run in the order they were scheduled");
+    IGListExpect(queue.empty() && queue.deferredCount() == 0, "nothing is deferred under the budget");
+}
+
+void IGListTestBudgetDefersTheRest() {
+    IGListFrameQueue<IGListTimedUpdate> queue;
+    IGListSteppedClock clock;
+    std::vector<int> ran;
+    for (int i = 0; i < 5; i++) {
+        queue.push({i, 0.003});
+    }
+    // 3ms each against a budget of 8.3ms: the third update starts at 6ms and ends past the budget
+    IGListExpect(IGListRunFrame(queue, clock, IGListDefaultBudget, ran) == 3,
+                 "a frame stops once the budget is used up");
+    IGListExpect(queue.size() == 2 && queue.deferredCount() == 2, "the rest are deferred and counted");
+
+    queue.push({5, 0});
+    IGListExpect(IGListRunFrame(queue, clock, IGListDefaultBudget, ran) == 3, "the next frame runs what is left");
+    IGListExpect(ran == std::vector<int>({0, 1, 2, 3, 4, 5}), "deferred updates stay ahead of newer ones");
+    IGListExpect(queue.deferredCount() == 2, "the deferred count only grows when the budget runs out");
+}
+
+void IGListTestOverBudgetUpdateStillRuns() {
+    IGListFrameQueue<IGListTimedUpdate> queue;
+    IGListSteppedClock clock;
+    std::vector<int> ran;
+    queue.push({0, 0.05});
+    queue.push({1, 0.05});
+    IGListExpect(IGListRunFrame(queue, clock, IGListDefaultBudget, ran) == 1, "one update runs even past the budget");
+    IGListExpect(IGListRunFrame(queue, clock, IGListDefaultBudget, ran) == 1, "and the next one the frame after");
+    IGListExpect(queue.empty() && queue.deferredCount() == 1, "the second update was deferred once");
+
+    // a zero budget still makes progress
+    queue.push({2, 0});
+    queue.push({3, 0});
+    IGListExpect(IGListRunFrame(queue, clock, 0, ran) == 1, "a zero budget runs one update per frame");
+}
+
+void IGListTestUpdatesScheduledDuringAFrameWait() {
+    IGListFrameQueue<IGListTimedUpdate> queue;
+    IGListSteppedClock clock;
+    std::vector<int> ran;
+    queue.push({0, 0});
+    queue.push({1, 0});
+    clock.nextFrame();
+    const size_t count = queue.runFrame(IGListDefaultBudget, [&clock]() {
+        return clock.currentTime();
+    }, [&queue, &ran](const IGListTimedUpdate &update) {
+        ran.push_back(update.id);
+        // an update that queues another, like a batch update completing and requeueing
+        if (update.id < 10) {
+            queue.push({update.id + 10, 0});
+        }
+    });
+    IGListExpect(count == 2, "only updates pending at the start of a frame run in it");
+    IGListExpect(queue.size() == 2 && queue.deferredCount() == 0, "updates scheduled during a frame are not deferrals");
+    IGListRunFrame(queue, clock, IGListDefaultBudget, ran);
+    IGListExpect(ran == std::vector<int>({0, 1, 10, 11}), "updates scheduled during a frame run in the next one");
+}
+
+void IGListTestSteppedClock() {
+    IGListSteppedClock clock;
+    const double frame = clock.frameDuration();
+    IGListExpect(clock.nextFrame() == frame, "the first frame is one frame duration in");
+    clock.advance(frame * 2.5);
+    IGListExpect(std::fabs(clock.nextFrame() - frame * 4) < 1e-12, "frame boundaries that work ran past are skipped");
+
+    // frames land on boundaries that may not round trip through the division
+    double previous = clock.currentTime();
+    bool increasing = true;
+    for (int i = 0; i < 100000; i++) {
+        const double next = clock.nextFrame();
+        increasing = increasing && next > previous && next - previous < frame * 1.5;
+        previous = next;
+    }
+    IGListExpect(increasing, "every frame moves exactly one frame duration");
+}
+
+// Random costs, budgets and re-entrant pushes. Every update runs exactly once and in the order it was pushed, and a
+// frame only stops early once its budget was used up.
+void IGListTestRandomSchedules(uint64_t seed, int64_t iterations) {
+    std::mt19937_64 rng(seed);
+    for (int64_t iteration = 0; iteration < iterations && IGListFailures == 0; iteration++) {
+        IGListFrameQueue<IGListTimedUpdate> queue;
+        IGListSteppedClock clock(1.0 / (30 + rng() % 91));
+        const double budget = clock.frameDuration() * (double)(rng() % 100) / 100.0;
+        int nextId = 0;
+        std::vector<int> ran;
+        size_t expectedDeferred = 0;
+        for (int frame = 0; frame < 50; frame++) {
+            for (int i = rng() % 6; i > 0; i--) {
+                queue.push({nextId++, budget * (double)(rng() % 80) / 100.0});
+            }
+            const size_t pending = queue.size();
+            clock.nextFrame();
+            const double start = clock.currentTime();
+            double lastStart = start;
+            const size_t count = queue.runFrame(budget, [&clock]() {
+                return clock.currentTime();
+            }, [&](const IGListTimedUpdate &update) {
+                lastStart = clock.currentTime();
+                clock.advance(update.cost);
+                ran.push_back(update.id);
+                if (rng() % 8 == 0) {
+                    queue.push({nextId++, 0});
+                }
+            });
+            expectedDeferred += pending - count;
+            IGListExpect(count <= pending, "a frame never runs updates scheduled during it");
+            IGListExpect(pending == 0 || count >= 1, "a frame with pending updates runs at least one");
+            IGListExpect(count == 0 || count == 1 || lastStart - start < budget,
+                         "an update only starts while the frame is within its budget");
+            IGListExpect(count == pending || clock.currentTime() - start >= budget,
+                         "updates are only deferred once the budget is used up");
+        }
+        IGListExpect(queue.deferredCount() == expectedDeferred, "every update left for a later frame is counted");
+        for (size_t i = 0; i < ran.size(); i++) {
+            if (ran[i] != (int)i) {
+                IGListExpect(false, "updates run exactly once, first in, first out");
+                break;
+            }
+        }
+    }
+}
+
+int IGListRunTests(uint64_t seed, int64_t iterations) {
+    IGListTestFirstInFirstOut();
+    IGListTestBudgetDefersTheRest();
+    IGListTestOverBudgetUpdateStillRuns();
+    IGListTestUpdatesScheduledDuringAFrameWait();
+    IGListTestSteppedClock();
+    IGListTestRandomSchedules(seed, iterations);
+    if (IGListFailures > 0) {
+        return 1;
+    }
+    printf("%lld random schedules verified\n", (long long)iterations);
+    return 0;
+}
+
+// An adapter whose data source changes `changesPerSecond` times a second. Like IGListAdapterUpdater it has at most one
+// update scheduled, which applies every change made before it runs.
+struct IGListSimulatedAdapter {
+    double changesPerSecond;
+    double updateCost;
+    double nextChange = 0;
+    double firstUnappliedChange = -1;
+    bool scheduled = false;
+};
+
+struct IGListScheduleStats {
+    size_t updates = 0;
+    size_t frames = 0;
+    size_t droppedFrames = 0;
+    double maxFrameWork = 0;
+    double totalLatency = 0;
+    double maxLatency = 0;
+};
+
+IGListScheduleStats IGListSimulate(std::vector<IGListSimulatedAdapter> adapters, double budget, double seconds) {
+    IGListScheduleStats stats;
+    IGListFrameQueue<size_t> queue;
+    IGListSteppedClock clock;
+    while (clock.currentTime() < seconds) {
+        const double frameStart = clock.nextFrame();
+        // changes made since the last frame schedule an update for their adapter
+        for (size_t index = 0; index < adapters.size(); index++) {
+            IGListSimulatedAdapter &adapter = adapters[index];
+            while (adapter.nextChange <= frameStart) {
+                if (adapter.firstUnappliedChange < 0) {
+                    adapter.firstUnappliedChange = adapter.nextChange;
+                }
+                adapter.nextChange += 1.0 / adapter.changesPerSecond;
+            }
+            if (adapter.firstUnappliedChange >= 0 && !adapter.scheduled) {
+                adapter.scheduled = true;
+                queue.push(index);
+            }
+        }
+        queue.runFrame(budget, [&clock]() {
+            return clock.currentTime();
+        }, [&](size_t index) {
+            IGListSimulatedAdapter &adapter = adapters[index];
+            clock.advance(adapter.updateCost);
+            const double latency = clock.currentTime() - adapter.firstUnappliedChange;
+            stats.totalLatency += latency;
+            stats.maxLatency = std::max(stats.maxLatency, latency);
+            stats.updates++;
+            adapter.firstUnappliedChange = -1;
+            adapter.scheduled = false;
+        });
+        const double work = clock.currentTime() - frameStart;
+        stats.frames++;
+        stats.maxFrameWork = std::max(stats.maxFrameWork, work);
+        if (work > clock.frameDuration()) {
+            stats.droppedFrames++;
+        }
+    }
+    return stats;
+}
+
+int IGListRunBenchmark(uint64_t seed, size_t adapterCount, double seconds) {
+    std::mt19937_64 rng(seed);
+    std::vector<IGListSimulatedAdapter> adapters;
+    for (size_t i = 0; i < adapterCount; i++) {
+        IGListSimulatedAdapter adapter;
+        // between 10 and 1000 changes a second, each update costing 0.2ms to 3ms
+        adapter.changesPerSecond = 10 + (double)(rng() % 991);
+        adapter.updateCost = (0.2 + (double)(rng() % 29) / 10.0) / 1000.0;
+        adapter.nextChange = (double)(rng() % 1000) / 1000.0 / adapter.changesPerSecond;
+        adapters.push_back(adapter);
+    }
+
+    size_t changes = 0;
+    for (const IGListSimulatedAdapter &adapter : adapters) {
+        changes += (size_t)(adapter.changesPerSecond * seconds);
+    }
+    printf("%zu adapters, %zu data source changes over %.0fs at 60Hz\n", adapterCount, changes, seconds);
+    printf("%-12s %10s %10s %12s %14s %14s %14s\n", "budget", "updates", "frames", "dropped", "max work ms",
+           "mean lat ms", "max lat ms");
+    const double budgets[] = {INFINITY, 1.0 / 60.0, IGListDefaultBudget, 1.0 / 240.0, 0};
+    for (const double budget : budgets) {
+        const IGListScheduleStats stats = IGListSimulate(adapters, budget, seconds);
+        char name[32];
+        if (std::isinf(budget)) {
+            snprintf(name, sizeof(name), "none");
+        } else {
+            snprintf(name, sizeof(name), "%.2fms", budget * 1000);
+        }
+        printf("%-12s %10zu %10zu %12zu %14.2f %14.2f %14.2f\n", name, stats.updates, stats.frames,
+               stats.droppedFrames, stats.maxFrameWork * 1000,
+               stats.updates > 0 ? stats.totalLatency / stats.updates * 1000 : 0, stats.maxLatency * 1000);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool bench = false;
+    uint64_t seed = 1;
+    int64_t iterations = 2000;
+    size_t adapters = 24;
+    double seconds = 10;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = strtoll(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--adapters") == 0 && hasValue) {
+            adapters = std::max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            seconds = std::max(1.0, strtod(argv[++i], nullptr));
+        } else {
+            fprintf(stderr, "usage: %s [--bench] [--seed S] [--iterations N] [--adapters N] [--seconds N]\n", argv[0]);
+            return 2;
+        }
+    }
+    return bench ? IGListRunBenchmark(seed, adapters, seconds) : IGListRunTests(seed, iterations);
+}
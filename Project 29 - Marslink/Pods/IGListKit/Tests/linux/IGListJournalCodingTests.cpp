@@ -0,0 +1,404 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Round trips the update journal format through IGListJournalWriter and IGListJournalDecode(): every record type and
+// update flag, every truncation of a journal, and corrupt headers, types, counts and varints. With --dump-with, the
+// same journal is also read by scripts/journal_dump.py, the second reader of the format, and its output compared.
+//
+//     IGListJournalCodingTests [--iterations N] [--seed S]
+//     IGListJournalCodingTests --dump-with python3 scripts/journal_dump.py
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "IGListJournalCoding.h"
+
+using namespace IGListKit;
+
+namespace {
+
+int IGListFailures = 0;
+
+void IGListExpect(bool condition, const char *what) {
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s\n", what);
+        IGListFailures++;
+    }
+}
+
+struct IGListJournalFixture {
+    std::vector<IGListJournalRecord> records;
+    std::vector<uint64_t> elapsed;
+    std::vector<uint8_t> bytes;
+    // the length of the journal after each record
+    std::vector<size_t> boundaries;
+};
+
+IGListJournalRecord IGListMakeRecord(IGListJournalRecordType type, uint64_t parentBlockID) {
+    IGListJournalRecord record;
+    record.type = type;
+    record.parentBlockID = parentBlockID;
+    return record;
+}
+
+// One record of every type and an update of every flag combination the journal writes, with values that need
+// multi-byte varints and identifier hashes with the high bits set.
+IGListJournalFixture IGListMakeFixture() {
+    IGListJournalFixture fixture;
+    const std::vector<IGListJournalObject> objects = {
+        {0xFEDCBA9876543210ull, 1}, {0x8000000000000000ull, 300}, {1, ~0ull},
+    };
+    const std::vector<IGListJournalObject> reordered = {objects[2], objects[0]};
+
+    IGListJournalRecord update = IGListMakeRecord(IGListJournalRecordType::performUpdate, 0);
+    update.flags = IGListJournalUpdateAnimated | IGListJournalUpdateHasFromObjects | IGListJournalUpdateHasToObjects
+    | IGListJournalUpdateHasDelta;
+    update.fromObjects = objects;
+    update.toObjects = reordered;
+    update.inserts = {};
+    update.deletes = {{1, 1}};
+    update.updates = {{0, 1}};
+    update.moves = {{2, 0}, {0, 1}};
+    fixture.records.push_back(update);
+
+    // the from objects are the previous to objects, so only the to objects are written
+    IGListJournalRecord previous = IGListMakeRecord(IGListJournalRecordType::performUpdate, 0);
+    previous.flags = IGListJournalUpdateHasFromObjects | IGListJournalUpdateFromPreviousObjects
+    | IGListJournalUpdateHasToObjects;
+    previous.toObjects = objects;
+    fixture.records.push_back(previous);
+
+    IGListJournalRecord toOnly = IGListMakeRecord(IGListJournalRecordType::performUpdate, 0);
+    toOnly.flags = IGListJournalUpdateHasToObjects;
+    fixture.records.push_back(toOnly);
+
+    IGListJournalRecord itemUpdates = IGListMakeRecord(IGListJournalRecordType::itemUpdates, 0);
+    itemUpdates.flags = 1;
+    itemUpdates.blockID = 1;
+    fixture.records.push_back(itemUpdates);
+
+    IGListJournalRecord nested = IGListMakeRecord(IGListJournalRecordType::itemUpdates, 1);
+    nested.blockID = 200;
+    fixture.records.push_back(nested);
+
+    IGListJournalRecord inserts = IGListMakeRecord(IGListJournalRecordType::insertItems, 200);
+    inserts.indexPaths = {{0, 0}, {3, 1000000}};
+    fixture.records.push_back(inserts);
+
+    IGListJournalRecord deletes = IGListMakeRecord(IGListJournalRecordType::deleteItems, 1);
+    deletes.indexPaths = {{128, 2}};
+    fixture.records.push_back(deletes);
+
+    IGListJournalRecord move = IGListMakeRecord(IGListJournalRecordType::moveItem, 1);
+    move.indexPaths = {{1, 2}, {3, 4}};
+    fixture.records.push_back(move);
+
+    IGListJournalRecord reloadItem = IGListMakeRecord(IGListJournalRecordType::reloadItem, 0);
+    reloadItem.indexPaths = {{5, 6}, {7, 8}};
+    fixture.records.push_back(reloadItem);
+
+    IGListJournalRecord reloadItems = IGListMakeRecord(IGListJournalRecordType::reloadItems, 0);
+    reloadItems.fromSection = 2;
+    reloadItems.toSection = 9;
+    reloadItems.indexes = {{0, 3}, {10, 1}, {500, 20}};
+    fixture.records.push_back(reloadItems);
+
+    IGListJournalRecord reloadSections = IGListMakeRecord(IGListJournalRecordType::reloadSections, 0);
+    reloadSections.indexes = {{4, 1}};
+    fixture.records.push_back(reloadSections);
+
+    IGListJournalRecord emptySections = IGListMakeRecord(IGListJournalRecordType::reloadSections, 0);
+    fixture.records.push_back(emptySections);
+
+    fixture.records.push_back(IGListMakeRecord(IGListJournalRecordType::reloadData, 0));
+
+    IGListJournalWriter writer;
+    uint64_t time = 0;
+    for (size_t i = 0; i < fixture.records.size(); i++) {
+        const uint64_t elapsed = i == 0 ? 0 : i * 1500 + (i % 3 == 0 ? 200000 : 0);
+        time += elapsed;
+        fixture.records[i].time = time;
+        fixture.elapsed.push_back(elapsed);
+        writer.writeRecord(fixture.records[i], elapsed);
+        fixture.boundaries.push_back(writer.bytes().size());
+    }
+    IGListExpect(writer.recordCount() == fixture.records.size(), "the writer counts its records");
+    fixture.bytes = writer.bytes();
+    return fixture;
+}
+
+bool IGListRecordsEqual(const IGListJournalRecord &decoded, const IGListJournalRecord &written) {
+    // from objects that are the previous to objects are not written, so they decode empty
+    const bool fromObjectsWritten = (written.flags & IGListJournalUpdateHasFromObjects)
+    && !(written.flags & IGListJournalUpdateFromPreviousObjects);
+    const bool hasFromObjects = written.type == IGListJournalRecordType::performUpdate && fromObjectsWritten;
+    return decoded.type == written.type
+    && decoded.time == written.time
+    && decoded.parentBlockID == written.parentBlockID
+    && decoded.flags == written.flags
+    && decoded.blockID == written.blockID
+    && decoded.fromObjects == (hasFromObjects ? written.fromObjects : std::vector<IGListJournalObject>())
+    && decoded.toObjects == written.toObjects
+    && decoded.inserts == written.inserts
+    && decoded.deletes == written.deletes
+    && decoded.updates == written.updates
+    && decoded.moves == written.moves
+    && decoded.indexPaths == written.indexPaths
+    && decoded.fromSection == written.fromSection
+    && decoded.toSection == written.toSection
+    && decoded.indexes == written.indexes;
+}
+
+// The decoded records are the first records of the fixture, unchanged.
+bool IGListDecodedPrefixMatches(const std::vector<IGListJournalRecord> &decoded, const IGListJournalFixture &fixture) {
+    if (decoded.size() > fixture.records.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < decoded.size(); i++) {
+        if (!IGListRecordsEqual(decoded[i], fixture.records[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void IGListTestRoundTrip(const IGListJournalFixture &fixture) {
+    std::vector<IGListJournalRecord> decoded;
+    IGListExpect(IGListJournalDecode(fixture.bytes.data(), fixture.bytes.size(), decoded), "a whole journal decodes");
+    IGListExpect(decoded.size() == fixture.records.size(), "every record is decoded");
+    for (size_t i = 0; i < decoded.size() && i < fixture.records.size(); i++) {
+        if (!IGListRecordsEqual(decoded[i], fixture.records[i])) {
+            fprintf(stderr, "record %zu of type %d\n", i, (int)fixture.records[i].type);
+            IGListExpect(false, "records decode to what was written");
+        }
+    }
+
+    std::vector<IGListJournalRecord> empty;
+    IGListExpect(IGListJournalDecode(fixture.bytes.data(), 5, empty) && empty.empty(), "a header alone is empty");
+}
+
+void IGListTestTruncation(const IGListJournalFixture &fixture) {
+    for (size_t length = 0; length < fixture.bytes.size(); length++) {
+        std::vector<IGListJournalRecord> decoded;
+        const bool valid = IGListJournalDecode(fixture.bytes.data(), length, decoded);
+        size_t complete = 0;
+        while (complete < fixture.boundaries.size() && fixture.boundaries[complete] <= length) {
+            complete++;
+        }
+        const bool atBoundary = length == 5 || (complete > 0 && fixture.boundaries[complete - 1] == length);
+        if (valid != atBoundary || decoded.size() != complete || !IGListDecodedPrefixMatches(decoded, fixture)) {
+            fprintf(stderr, "truncated to %zu bytes: %s with %zu records\n", length, valid ? "valid" : "invalid",
+                    decoded.size());
+            IGListExpect(false, "a truncated journal keeps exactly its complete records and fails unless cut between them");
+        }
+    }
+}
+
+void IGListTestCorruptHeaders(const IGListJournalFixture &fixture) {
+    for (size_t i = 0; i < 5; i++) {
+        std::vector<uint8_t> bytes = fixture.bytes;
+        bytes[i] ^= 0x20;
+        std::vector<IGListJournalRecord> decoded;
+        IGListExpect(!IGListJournalDecode(bytes.data(), bytes.size(), decoded) && decoded.empty(),
+                     "a wrong magic or version is rejected");
+    }
+}
+
+std::vector<uint8_t> IGListJournalWithRecordBytes(const std::vector<uint8_t> &recordBytes) {
+    std::vector<uint8_t> bytes = IGListJournalWriter().bytes();
+    bytes.insert(bytes.end(), recordBytes.begin(), recordBytes.end());
+    return bytes;
+}
+
+void IGListTestCorruptRecords(const IGListJournalFixture &fixture) {
+    std::vector<IGListJournalRecord> decoded;
+
+    // types 0 and past reloadData do not exist
+    for (const uint8_t type : {0, 10, 0xFF}) {
+        const std::vector<uint8_t> bytes = IGListJournalWithRecordBytes({type, 0, 0});
+        decoded.clear();
+        IGListExpect(!IGListJournalDecode(bytes.data(), bytes.size(), decoded), "an unknown record type is rejected");
+    }
+
+    // a varint longer than 64 bits
+    std::vector<uint8_t> longVarint = {(uint8_t)IGListJournalRecordType::reloadData};
+    longVarint.insert(longVarint.end(), 10, 0xFF);
+    longVarint.push_back(0);
+    longVarint.push_back(0);
+    const std::vector<uint8_t> longVarintBytes = IGListJournalWithRecordBytes(longVarint);
+    decoded.clear();
+    IGListExpect(!IGListJournalDecode(longVarintBytes.data(), longVarintBytes.size(), decoded),
+                 "a varint of more than ten bytes is rejected");
+
+    // counts far larger than the remaining data fail before anything is allocated for them
+    IGListJournalWriter counts;
+    counts.beginRecord(IGListJournalRecordType::performUpdate, 0, 0);
+    counts.writeByte(IGListJournalUpdateHasToObjects);
+    counts.writeVarint(1ull << 60);
+    decoded.clear();
+    IGListExpect(!IGListJournalDecode(counts.bytes().data(), counts.bytes().size(), decoded),
+                 "an object count past the end is rejected");
+    for (const IGListJournalRecordType type : {IGListJournalRecordType::insertItems,
+                                               IGListJournalRecordType::reloadSections}) {
+        IGListJournalWriter writer;
+        writer.beginRecord(type, 0, 0);
+        writer.writeVarint(1ull << 62);
+        decoded.clear();
+        IGListExpect(!IGListJournalDecode(writer.bytes().data(), writer.bytes().size(), decoded),
+                     "a pair or range count past the end is rejected");
+    }
+
+    // records after a good one: the good one is kept
+    std::vector<uint8_t> bytes(fixture.bytes.begin(), fixture.bytes.begin() + fixture.boundaries[2]);
+    bytes.push_back(0x7F);
+    decoded.clear();
+    IGListExpect(!IGListJournalDecode(bytes.data(), bytes.size(), decoded) && decoded.size() == 3
+                 && IGListDecodedPrefixMatches(decoded, fixture), "records before a corrupt one are kept");
+}
+
+// Flipped bytes never read out of bounds, and the records before the first flipped byte decode unchanged.
+void IGListTestRandomCorruption(const IGListJournalFixture &fixture, uint64_t seed, int64_t iterations) {
+    std::mt19937_64 rng(seed);
+    for (int64_t iteration = 0; iteration < iterations; iteration++) {
+        std::vector<uint8_t> bytes = fixture.bytes;
+        size_t first = bytes.size();
+        for (int flips = 1 + rng() % 3; flips > 0; flips--) {
+            const size_t offset = 5 + rng() % (bytes.size() - 5);
+            bytes[offset] ^= (uint8_t)(1 + rng() % 255);
+            first = std::min(first, offset);
+        }
+        // and sometimes cut short, into a heap block of exactly that size so overreads are caught
+        const size_t length = rng() % 4 == 0 ? 5 + rng() % (bytes.size() - 5) : bytes.size();
+        std::vector<uint8_t> exact(bytes.begin(), bytes.begin() + length);
+        std::vector<IGListJournalRecord> decoded;
+        IGListJournalDecode(exact.data(), exact.size(), decoded);
+
+        size_t intact = 0;
+        while (intact < fixture.boundaries.size() && fixture.boundaries[intact] <= std::min(first, length)) {
+            intact++;
+        }
+        std::vector<IGListJournalRecord> untouched(decoded.begin(), decoded.begin() + std::min(intact, decoded.size()));
+        if (decoded.size() < intact || !IGListDecodedPrefixMatches(untouched, fixture)) {
+            IGListExpect(false, "records before corrupt data decode unchanged");
+            return;
+        }
+    }
+}
+
+// the journal as scripts/journal_dump.py prints it
+const char *const IGListExpectedDump =
+"       0.000ms  performUpdate   animated, from 3 objects, to 2 objects, delta inserts [] deletes [1] updates [0] moves 2\n"
+"       1.500ms  performUpdate   not animated, from previous, to 3 objects\n"
+"       4.500ms  performUpdate   not animated, to 0 objects\n"
+"     209.000ms  itemUpdates     block 1, animated\n"
+"     215.000ms    itemUpdates     block 200, not animated\n"
+"     222.500ms      insertItems     [0.0, 3.1000000]\n"
+"     431.500ms    deleteItems     [128.2]\n"
+"     442.000ms    moveItem        1.2 -> 3.4\n"
+"     454.000ms  reloadItem      5.6 -> 7.8\n"
+"     667.500ms  reloadItems     section 2 -> 9, items [0-2, 10, 500-519]\n"
+"     682.500ms  reloadSections  [4]\n"
+"     699.000ms  reloadSections  []\n"
+"     917.000ms  reloadData      \n";
+
+bool IGListRunDumper(const std::string &command, const std::vector<uint8_t> &bytes, std::string &output, int &status) {
+    char path[] = "/tmp/IGListJournalCodingTestsXXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        return false;
+    }
+    const bool written = write(fd, bytes.data(), bytes.size()) == (ssize_t)bytes.size();
+    close(fd);
+    FILE *pipe = written ? popen((command + " '" + path + "' 2>&1").c_str(), "r") : nullptr;
+    if (pipe == nullptr) {
+        unlink(path);
+        return false;
+    }
+    char buffer[256];
+    output.clear();
+    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+        output += buffer;
+    }
+    status = pclose(pipe);
+    unlink(path);
+    return true;
+}
+
+int IGListRunDumperCheck(const std::string &command) {
+    const IGListJournalFixture fixture = IGListMakeFixture();
+    std::string output;
+    int status = 0;
+    if (!IGListRunDumper(command, fixture.bytes, output, status)) {
+        fprintf(stderr, "could not run %s\n", command.c_str());
+        return 1;
+    }
+    if (status != 0 || output != IGListExpectedDump) {
+        fprintf(stderr, "journal_dump.py printed:\n%s\nexpected:\n%s", output.c_str(), IGListExpectedDump);
+        return 1;
+    }
+
+    // a truncated journal prints the complete records and then fails
+    const std::vector<uint8_t> truncated(fixture.bytes.begin(), fixture.bytes.begin() + fixture.boundaries[1] + 2);
+    if (!IGListRunDumper(command, truncated, output, status)) {
+        return 1;
+    }
+    const std::string expected = std::string(IGListExpectedDump).substr(0, strchr(strchr(IGListExpectedDump, '\n') + 1,
+                                                                                 '\n') - IGListExpectedDump + 1)
+    + "error: truncated journal\n";
+    if (status == 0 || output != expected) {
+        fprintf(stderr, "journal_dump.py printed for a truncated journal:\n%s\nexpected:\n%s", output.c_str(),
+                expected.c_str());
+        return 1;
+    }
+    printf("journal_dump.py reads what IGListJournalWriter writes\n");
+    return 0;
+}
+
+int IGListRunTests(uint64_t seed, int64_t iterations) {
+    const IGListJournalFixture fixture = IGListMakeFixture();
+    IGListTestRoundTrip(fixture);
+    IGListTestTruncation(fixture);
+    IGListTestCorruptHeaders(fixture);
+    IGListTestCorruptRecords(fixture);
+    IGListTestRandomCorruption(fixture, seed, iterations);
+    if (IGListFailures > 0) {
+        return 1;
+    }
+    printf("%zu records and %zu byte journal verified, %lld corruptions decoded safely\n", fixture.records.size(),
+           fixture.bytes.size(), (long long)iterations);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    uint64_t seed = 1;
+    int64_t iterations = 20000;
+    std::string dumper;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--dump-with") == 0 && i + 2 < argc) {
+            dumper = std::string("'") + argv[i + 1] + "' '" + argv[i + 2] + "'";
+            i += 2;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = strtoll(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seed S] [--iterations N] [--dump-with PYTHON SCRIPT]\n", argv[0]);
+            return 2;
+        }
+    }
+    return dumper.empty() ? IGListRunTests(seed, iterations) : IGListRunDumperCheck(dumper);
+}
@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Checks IGListKeyDiffing() and IGListDiffKeys() against a direct implementation of the IGListDiffing() rules: the n-th
+// occurrence of a key in the new keys is paired with its n-th occurrence in the old keys, unpaired keys are inserted or
+// deleted, every pairing of a key is updated if any of them changed version, and a pair moves unless the deletes before
+// its old index and the inserts before its new index account for the shift.
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "IGListArena.h"
+#include "IGListDiffKeys.h"
+#include "IGListKeyDiff.h"
+
+using namespace IGListKit;
+
+namespace {
+
+struct IGListExpectedDiff {
+    std::vector<size_t> inserts;
+    std::vector<size_t> deletes;
+    std::vector<size_t> updates;
+    std::vector<std::pair<size_t, size_t>> moves;
+    std::vector<size_t> oldToNew;
+    std::vector<size_t> newToOld;
+};
+
+IGListExpectedDiff IGListExpectedDiffOfKeys(const std::vector<uint64_t> &oldKeys,
+                                            const std::vector<uint64_t> &newKeys,
+                                            const uint64_t *oldVersions,
+                                            const uint64_t *newVersions) {
+    IGListExpectedDiff expected;
+    expected.oldToNew.assign(oldKeys.size(), kIGListKeyNotFound);
+    expected.newToOld.assign(newKeys.size(), kIGListKeyNotFound);
+
+    std::map<uint64_t, std::vector<size_t>> oldOccurrences;
+    for (size_t i = 0; i < oldKeys.size(); i++) {
+        oldOccurrences[oldKeys[i]].push_back(i);
+    }
+    std::map<uint64_t, size_t> pairedCounts;
+    std::set<uint64_t> updatedKeys;
+    for (size_t i = 0; i < newKeys.size(); i++) {
+        const std::vector<size_t> &occurrences = oldOccurrences[newKeys[i]];
+        const size_t occurrence = pairedCounts[newKeys[i]]++;
+        if (occurrence < occurrences.size()) {
+            const size_t oldIndex = occurrences[occurrence];
+            expected.newToOld[i] = oldIndex;
+            expected.oldToNew[oldIndex] = i;
+            if (oldVersions != nullptr && oldVersions[oldIndex] != newVersions[i]) {
+                updatedKeys.insert(newKeys[i]);
+            }
+        }
+    }
+
+    std::vector<size_t> deleteOffsets(oldKeys.size());
+    for (size_t i = 0, offset = 0; i < oldKeys.size(); i++) {
+        deleteOffsets[i] = offset;
+        if (expected.oldToNew[i] == kIGListKeyNotFound) {
+            expected.deletes.push_back(i);
+            offset++;
+        }
+    }
+    for (size_t i = 0, offset = 0; i < newKeys.size(); i++) {
+        const size_t oldIndex = expected.newToOld[i];
+        if (oldIndex == kIGListKeyNotFound) {
+            expected.inserts.push_back(i);
+            offset++;
+            continue;
+        }
+        if (updatedKeys.count(newKeys[i]) > 0) {
+            expected.updates.push_back(oldIndex);
+        }
+        if (oldIndex - deleteOffsets[oldIndex] + offset != i) {
+            expected.moves.push_back({oldIndex, i});
+        }
+    }
+    std::sort(expected.updates.begin(), expected.updates.end());
+    return expected;
+}
+
+template <typename T>
+std::vector<T> IGListSorted(std::vector<T> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+bool IGListCheckKeyDiffing(const std::vector<uint64_t> &oldKeys,
+                           const std::vector<uint64_t> &newKeys,
+                           const uint64_t *oldVersions,
+                           const uint64_t *newVersions,
+                           const IGListExpectedDiff &expected,
+                           IGListArena *arena) {
+    arena->reset();
+    IGListKeyDiffOutput output(arena);
+    IGListKeyDiffing(oldKeys.data(), oldKeys.size(), newKeys.data(), newKeys.size(), oldVersions, newVersions, arena,
+                     output);
+    const std::vector<size_t> updates(output.updates.begin(), output.updates.end());
+    const std::vector<std::pair<size_t, size_t>> moves(output.moves.begin(), output.moves.end());
+    return std::vector<size_t>(output.inserts.begin(), output.inserts.end()) == expected.inserts
+    && std::vector<size_t>(output.deletes.begin(), output.deletes.end()) == expected.deletes
+    && IGListSorted(updates) == expected.updates
+    && moves == expected.moves
+    && std::vector<size_t>(output.oldToNew.begin(), output.oldToNew.end()) == expected.oldToNew
+    && std::vector<size_t>(output.newToOld.begin(), output.newToOld.end()) == expected.newToOld;
+}
+
+bool IGListCheckDiffKeys(const std::vector<uint64_t> &oldKeys,
+                         const std::vector<uint64_t> &newKeys,
+                         const uint64_t *oldVersions,
+                         const uint64_t *newVersions,
+                         const IGListExpectedDiff &expected) {
+    IGListKeyDiffResult result = IGListDiffKeys(oldKeys.data(), oldKeys.size(), newKeys.data(), newKeys.size(),
+                                                oldVersions, newVersions);
+    auto array = [](const size_t *values, size_t count) {
+        return std::vector<size_t>(values, values + count);
+    };
+    std::vector<std::pair<size_t, size_t>> moves;
+    for (size_t i = 0; i < result.moveCount; i++) {
+        moves.push_back({result.moves[i].from, result.moves[i].to});
+    }
+    // the C interface promises ascending updates
+    const bool matches = array(result.inserts, result.insertCount) == expected.inserts
+    && array(result.deletes, result.deleteCount) == expected.deletes
+    && array(result.updates, result.updateCount) == expected.updates
+    && moves == expected.moves
+    && array(result.oldToNew, oldKeys.size()) == expected.oldToNew
+    && array(result.newToOld, newKeys.size()) == expected.newToOld;
+    IGListKeyDiffResultRelease(&result);
+    return matches && result._storage == nullptr && result.moves == nullptr && result.moveCount == 0;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937_64 rng(3);
+    IGListArena arena;
+    const int iterations = 20000;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        // a small key space produces duplicates in both collections
+        const size_t keySpace = 1 + rng() % 20;
+        std::vector<uint64_t> oldKeys(rng() % 24);
+        std::vector<uint64_t> newKeys(rng() % 24);
+        std::vector<uint64_t> oldVersions(oldKeys.size());
+        std::vector<uint64_t> newVersions(newKeys.size());
+        for (auto &key : oldKeys) {
+            key = rng() % keySpace;
+        }
+        for (auto &key : newKeys) {
+            key = rng() % keySpace;
+        }
+        for (auto &version : oldVersions) {
+            version = rng() % 3;
+        }
+        for (auto &version : newVersions) {
+            version = rng() % 3;
+        }
+
+        const bool versioned = rng() % 2 == 0;
+        const uint64_t *oldVersionsOrNull = versioned ? oldVersions.data() : nullptr;
+        const uint64_t *newVersionsOrNull = versioned ? newVersions.data() : nullptr;
+        const IGListExpectedDiff expected = IGListExpectedDiffOfKeys(oldKeys, newKeys, oldVersionsOrNull,
+                                                                     newVersionsOrNull);
+        if (oldKeys.size() - expected.deletes.size() + expected.inserts.size() != newKeys.size()) {
+            fprintf(stderr, "iteration %d: the expected diff does not add up\n", iteration);
+            return 1;
+        }
+        if (!IGListCheckKeyDiffing(oldKeys, newKeys, oldVersionsOrNull, newVersionsOrNull, expected, &arena)) {
+            fprintf(stderr, "iteration %d: IGListKeyDiffing() differs from the IGListDiffing() rules\n", iteration);
+            return 1;
+        }
+        if (!IGListCheckDiffKeys(oldKeys, newKeys, oldVersionsOrNull, newVersionsOrNull, expected)) {
+            fprintf(stderr, "iteration %d: IGListDiffKeys() differs from the IGListDiffing() rules\n", iteration);
+            return 1;
+        }
+    }
+
+    IGListKeyDiffResult empty = IGListDiffKeys(nullptr, 0, nullptr, 0, nullptr, nullptr);
+    if (empty.insertCount != 0 || empty.deleteCount != 0 || empty.moveCount != 0) {
+        fprintf(stderr, "diffing no keys reported changes\n");
+        return 1;
+    }
+    IGListKeyDiffResultRelease(&empty);
+
+    printf("%d key diffs match\n", iterations);
+    return 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Compares the moves IGListPlanMoves() plans with the raw moves of the diff it starts from. By default random diffs
+// are checked: applying the plan's moves and delete+insert pairs the way UICollectionView does must produce the new
+// order, and every relocated object must use the cheaper of a move and a delete+insert pair. With --bench, common reorderings are timed and priced under the default cost model.
+//
+//     IGListMovePlanBenchmark [--iterations N] [--seed S]
+//     IGListMovePlanBenchmark --bench [--count N]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "IGListArena.h"
+#include "IGListKeyDiff.h"
+#include "IGListMovePlanner.h"
+
+using namespace IGListKit;
+
+namespace {
+
+// IGListMoveCostModelDefault
+const IGListMovePlannerCost IGListDefaultCost = {1, 0, 2};
+
+struct IGListPlannedDiff {
+    std::vector<size_t> inserts;
+    std::vector<size_t> deletes;
+    std::vector<IGListIndexPair> diffMoves;
+    IGListMovePlan plan;
+    double diffMs = 0;
+    double planMs = 0;
+};
+
+IGListPlannedDiff IGListDiffAndPlan(const std::vector<uint64_t> &oldKeys,
+                                    const std::vector<uint64_t> &newKeys,
+                                    const IGListMovePlannerCost &model,
+                                    IGListArena *arena) {
+    IGListPlannedDiff result;
+    arena->reset();
+    IGListKeyDiffOutput output(arena);
+    const auto start = std::chrono::steady_clock::now();
+    IGListKeyDiffing(oldKeys.data(), oldKeys.size(), newKeys.data(), newKeys.size(), nullptr, nullptr, arena, output);
+    const auto diffed = std::chrono::steady_clock::now();
+
+    // what IGListIndexSetResultPlanningMoves() hands to the planner
+    std::vector<IGListIndexPair> common;
+    for (size_t oldIndex = 0; oldIndex < output.oldToNew.size(); oldIndex++) {
+        if (output.oldToNew[oldIndex] != kIGListKeyNotFound) {
+            common.push_back({(int64_t)oldIndex, (int64_t)output.oldToNew[oldIndex]});
+        }
+    }
+    result.plan = IGListPlanMoves(std::move(common), model);
+    const auto planned = std::chrono::steady_clock::now();
+
+    result.inserts.assign(output.inserts.begin(), output.inserts.end());
+    result.deletes.assign(output.deletes.begin(), output.deletes.end());
+    for (const auto &move : output.moves) {
+        result.diffMoves.push_back({(int64_t)move.first, (int64_t)move.second});
+    }
+    result.diffMs = std::chrono::duration<double, std::milli>(diffed - start).count();
+    result.planMs = std::chrono::duration<double, std::milli>(planned - diffed).count();
+    return result;
+}
+
+// Applies deletes, inserts and moves like -[UICollectionView performBatchUpdates:completion:]: moved and inserted
+// objects take their new slots and every other surviving object fills the remaining slots in its old order.
+bool IGListPlanProducesNewOrder(const std::vector<uint64_t> &oldKeys,
+                                const std::vector<uint64_t> &newKeys,
+                                const IGListPlannedDiff &diff) {
+    const uint64_t unfilled = ~(uint64_t)0;
+    std::vector<uint64_t> result(newKeys.size(), unfilled);
+    std::vector<char> oldRemoved(oldKeys.size(), 0);
+    std::vector<char> newTaken(newKeys.size(), 0);
+    for (const size_t index : diff.deletes) {
+        oldRemoved[index] = 1;
+    }
+    for (const size_t index : diff.inserts) {
+        newTaken[index] = 1;
+        result[index] = newKeys[index];
+    }
+    for (const auto &move : diff.plan.moves) {
+        oldRemoved[move.first] = 1;
+        newTaken[move.second] = 1;
+        result[move.second] = oldKeys[move.first];
+    }
+    // a delete+insert reloads the object from the data source
+    for (const auto &pair : diff.plan.deleteInserts) {
+        oldRemoved[pair.first] = 1;
+        newTaken[pair.second] = 1;
+        result[pair.second] = newKeys[pair.second];
+    }
+    size_t slot = 0;
+    for (size_t oldIndex = 0; oldIndex < oldKeys.size(); oldIndex++) {
+        if (oldRemoved[oldIndex]) {
+            continue;
+        }
+        while (slot < newKeys.size() && newTaken[slot]) {
+            slot++;
+        }
+        if (slot == newKeys.size()) {
+            return false;
+        }
+        result[slot++] = oldKeys[oldIndex];
+    }
+    return result == newKeys;
+}
+
+// Each relocated object is a move unless a delete+insert pair is cheaper for it, and the plan's cost is their sum.
+bool IGListPlanIsCheapestPerObject(const IGListMovePlan &plan, const IGListMovePlannerCost &model) {
+    double cost = 0;
+    for (const auto &move : plan.moves) {
+        if (IGListMoveCost(model, move) > model.deleteInsert) {
+            return false;
+        }
+        cost += IGListMoveCost(model, move);
+    }
+    for (const auto &pair : plan.deleteInserts) {
+        if (IGListMoveCost(model, pair) <= model.deleteInsert) {
+            return false;
+        }
+        cost += model.deleteInsert;
+    }
+    return std::abs(cost - plan.cost) < 1e-6;
+}
+
+// Unique keys, with some deleted and some inserted, reordered by `reorder`.
+template <typename F>
+void IGListMakeKeys(std::mt19937_64 &rng, size_t count, int changesOneIn, std::vector<uint64_t> &oldKeys,
+                    std::vector<uint64_t> &newKeys, F reorder) {
+    oldKeys.clear();
+    newKeys.clear();
+    for (size_t i = 0; i < count; i++) {
+        oldKeys.push_back(i);
+        if (changesOneIn == 0 || rng() % changesOneIn != 0) {
+            newKeys.push_back(i);
+        }
+    }
+    reorder(newKeys);
+    if (changesOneIn > 0) {
+        for (size_t i = 0; i < count / changesOneIn; i++) {
+            newKeys.insert(newKeys.begin() + rng() % (newKeys.size() + 1), count + i);
+        }
+    }
+}
+
+int IGListRunCheck(uint64_t seed, int64_t iterations) {
+    std::mt19937_64 rng(seed);
+    IGListArena arena;
+    std::vector<uint64_t> oldKeys;
+    std::vector<uint64_t> newKeys;
+    for (int64_t iteration = 0; iteration < iterations; iteration++) {
+        const size_t count = rng() % 40;
+        const bool mostlySorted = rng() % 2 == 0;
+        IGListMakeKeys(rng, count, 4, oldKeys, newKeys, [&rng, mostlySorted](std::vector<uint64_t> &keys) {
+            if (!mostlySorted) {
+                std::shuffle(keys.begin(), keys.end(), rng);
+                return;
+            }
+            for (size_t i = rng() % 4; i > 0 && keys.size() > 1; i--) {
+                const size_t from = rng() % keys.size();
+                const uint64_t key = keys[from];
+                keys.erase(keys.begin() + from);
+                keys.insert(keys.begin() + rng() % (keys.size() + 1), key);
+            }
+        });
+        const IGListMovePlannerCost model = {1, (double)(rng() % 2) * 0.2, (double)(rng() % 3) + 0.5};
+        const IGListPlannedDiff diff = IGListDiffAndPlan(oldKeys, newKeys, model, &arena);
+        if (!IGListPlanProducesNewOrder(oldKeys, newKeys, diff)) {
+            fprintf(stderr, "iteration %lld: the plan does not produce the new order\n", (long long)iteration);
+            return 1;
+        }
+        if (!IGListPlanIsCheapestPerObject(diff.plan, model)) {
+            fprintf(stderr, "iteration %lld: an object is not relocated at its cheapest cost\n", (long long)iteration);
+            return 1;
+        }
+    }
+    printf("%lld plans verified\n", (long long)iterations);
+    return 0;
+}
+
+int IGListRunBenchmark(uint64_t seed, size_t count) {
+    struct Workload {
+        const char *name;
+        void (*reorder)(std::mt19937_64 &rng, std::vector<uint64_t> &keys);
+    };
+    const Workload workloads[] = {
+        {"move last to front", [](std::mt19937_64 &, std::vector<uint64_t> &keys) {
+            std::rotate(keys.begin(), keys.end() - 1, keys.end());
+        }},
+        {"move block of 5%", [](std::mt19937_64 &rng, std::vector<uint64_t> &keys) {
+            const size_t length = keys.size() / 20;
+            const size_t from = rng() % (keys.size() - length);
+            std::vector<uint64_t> block(keys.begin() + from, keys.begin() + from + length);
+            keys.erase(keys.begin() + from, keys.begin() + from + length);
+            keys.insert(keys.begin() + rng() % (keys.size() + 1), block.begin(), block.end());
+        }},
+        {"10 adjacent swaps", [](std::mt19937_64 &rng, std::vector<uint64_t> &keys) {
+            for (int i = 0; i < 10; i++) {
+                const size_t index = rng() % (keys.size() - 1);
+                std::swap(keys[index], keys[index + 1]);
+            }
+        }},
+        {"reverse", [](std::mt19937_64 &, std::vector<uint64_t> &keys) {
+            std::reverse(keys.begin(), keys.end());
+        }},
+        {"shuffle", [](std::mt19937_64 &rng, std::vector<uint64_t> &keys) {
+            std::shuffle(keys.begin(), keys.end(), rng);
+        }},
+    };
+
+    std::mt19937_64 rng(seed);
+    IGListArena arena;
+    std::vector<uint64_t> oldKeys;
+    std::vector<uint64_t> newKeys;
+    printf("%-20s %10s %10s %10s %12s %12s %9s %9s\n", "workload", "diff moves", "plan moves", "del+ins",
+           "diff cost", "plan cost", "diff ms", "plan ms");
+    for (const Workload &workload : workloads) {
+        IGListMakeKeys(rng, count, 0, oldKeys, newKeys, [&rng, &workload](std::vector<uint64_t> &keys) {
+            workload.reorder(rng, keys);
+        });
+        const IGListPlannedDiff diff = IGListDiffAndPlan(oldKeys, newKeys, IGListDefaultCost, &arena);
+        if (!IGListPlanProducesNewOrder(oldKeys, newKeys, diff)) {
+            fprintf(stderr, "%s: the plan does not produce the new order\n", workload.name);
+            return 1;
+        }
+        printf("%-20s %10zu %10zu %10zu %12.0f %12.0f %9.3f %9.3f\n", workload.name, diff.diffMoves.size(),
+               diff.plan.moves.size(), diff.plan.deleteInserts.size(), IGListMovesCost(diff.diffMoves, IGListDefaultCost),
+               diff.plan.cost, diff.diffMs, diff.planMs);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool bench = false;
+    uint64_t seed = 1;
+    int64_t iterations = 20000;
+    size_t count = 10000;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = strtoll(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--count") == 0 && hasValue) {
+            count = std::max<size_t>(100, strtoull(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: %s [--bench] [--seed S] [--iterations N] [--count N]\n", argv[0]);
+            return 2;
+        }
+    }
+    return bench ? IGListRunBenchmark(seed, count) : IGListRunCheck(seed, iterations);
+}
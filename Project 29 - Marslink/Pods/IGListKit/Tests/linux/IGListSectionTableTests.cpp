@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Checks IGListSectionTable, the open addressing table behind IGListSectionMap's object and section controller lookups,
+// against std::unordered_multimap. Random inserts, removes, finds, clears and reserves run on small tables where many
+// sections share a hash and probe runs wrap past the last slot, so backward shift deletion is exercised at the seam.
+//
+//     IGListSectionTableTests [--iterations N] [--seed S]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "IGListSectionTable.h"
+
+using namespace IGListKit;
+
+namespace {
+
+typedef std::unordered_multimap<uint64_t, int64_t> IGListReferenceTable;
+
+// mirrors the mixing in IGListSectionTable so some hashes can be aimed at the last slots of a table. if the mixing
+// changes the test still checks the same behavior, only with fewer runs that wrap
+size_t IGListIdealSlot(uint64_t hash, size_t capacity) {
+    const uint64_t h = hash * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h ^ (h >> 32)) & (capacity - 1);
+}
+
+bool IGListReferenceContains(const IGListReferenceTable &reference, uint64_t hash, int64_t section) {
+    const auto range = reference.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == section) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void IGListReferenceErase(IGListReferenceTable &reference, uint64_t hash, int64_t section) {
+    const auto range = reference.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == section) {
+            reference.erase(it);
+            return;
+        }
+    }
+}
+
+// Hashes to draw from: a few shared by many sections, and some whose ideal slot is the last one of a 16, 32 or 64 slot
+// table so their probe runs wrap to the first slots.
+std::vector<uint64_t> IGListMakeHashPool(std::mt19937_64 &rng) {
+    std::vector<uint64_t> pool;
+    for (int i = 0; i < 6; i++) {
+        pool.push_back(rng());
+    }
+    for (const size_t capacity : {16, 32, 64}) {
+        size_t found = 0;
+        for (uint64_t hash = rng() % 1000; found < 4; hash++) {
+            if (IGListIdealSlot(hash, capacity) >= capacity - 2) {
+                pool.push_back(hash);
+                found++;
+            }
+        }
+    }
+    return pool;
+}
+
+// Every entry of the reference is found, and the table holds nothing else.
+bool IGListTableMatches(const IGListSectionTable &table, const IGListReferenceTable &reference) {
+    if (table.size() != reference.size()) {
+        fprintf(stderr, "size %zu, expected %zu\n", table.size(), reference.size());
+        return false;
+    }
+    for (const auto &entry : reference) {
+        const int64_t section = entry.second;
+        if (table.find(entry.first, [section](int64_t candidate) { return candidate == section; }) != section) {
+            fprintf(stderr, "section %lld with hash %llu is missing\n", (long long)section,
+                    (unsigned long long)entry.first);
+            return false;
+        }
+    }
+    return true;
+}
+
+int IGListRunCheck(uint64_t seed, int64_t iterations) {
+    std::mt19937_64 rng(seed);
+    size_t wrapped = 0;
+    for (int64_t iteration = 0; iteration < iterations; iteration++) {
+        const std::vector<uint64_t> pool = IGListMakeHashPool(rng);
+        IGListSectionTable table;
+        IGListReferenceTable reference;
+        std::vector<std::pair<uint64_t, int64_t>> entries;
+        int64_t nextSection = 0;
+        // stay small so tables keep rehashing between 16 and 64 slots
+        const size_t maximumSize = 4 + rng() % 28;
+
+        for (int step = 0; step < 400; step++) {
+            const uint64_t roll = rng() % 100;
+            if (roll < 45 && entries.size() < maximumSize) {
+                const uint64_t hash = pool[rng() % pool.size()];
+                const int64_t section = nextSection++;
+                table.insert(hash, section);
+                reference.insert({hash, section});
+                entries.push_back({hash, section});
+                wrapped += IGListIdealSlot(hash, 16) >= 14 ? 1 : 0;
+            } else if (roll < 80 && !entries.empty()) {
+                const size_t index = rng() % entries.size();
+                const auto entry = entries[index];
+                if (!table.remove(entry.first, entry.second)) {
+                    fprintf(stderr, "iteration %lld: could not remove section %lld\n", (long long)iteration,
+                            (long long)entry.second);
+                    return 1;
+                }
+                IGListReferenceErase(reference, entry.first, entry.second);
+                entries.erase(entries.begin() + index);
+            } else if (roll < 88) {
+                // removing what is not there fails and changes nothing
+                const uint64_t hash = pool[rng() % pool.size()];
+                const int64_t section = (int64_t)(rng() % (nextSection + 1));
+                const bool present = IGListReferenceContains(reference, hash, section);
+                if (table.remove(hash, section) != present) {
+                    fprintf(stderr, "iteration %lld: remove of section %lld returned %d\n", (long long)iteration,
+                            (long long)section, (int)!present);
+                    return 1;
+                }
+                if (present) {
+                    IGListReferenceErase(reference, hash, section);
+                    entries.erase(std::find(entries.begin(), entries.end(), std::make_pair(hash, section)));
+                }
+            } else if (roll < 97) {
+                // a predicate that accepts some of the sections sharing a hash returns one of those, or -1 if none
+                const uint64_t hash = pool[rng() % pool.size()];
+                const int64_t modulus = 1 + rng() % 3;
+                const int64_t remainder = (int64_t)(rng() % modulus);
+                auto accepts = [modulus, remainder](int64_t section) { return section % modulus == remainder; };
+                const int64_t found = table.find(hash, accepts);
+                bool anyAccepted = false;
+                const auto range = reference.equal_range(hash);
+                for (auto it = range.first; it != range.second; ++it) {
+                    anyAccepted = anyAccepted || accepts(it->second);
+                }
+                const bool valid = found == -1
+                ? !anyAccepted
+                : accepts(found) && IGListReferenceContains(reference, hash, found);
+                if (!valid) {
+                    fprintf(stderr, "iteration %lld: find returned section %lld\n", (long long)iteration,
+                            (long long)found);
+                    return 1;
+                }
+            } else if (roll < 99) {
+                table.reserve(entries.size() + rng() % 40);
+            } else {
+                table.clear();
+                reference.clear();
+                entries.clear();
+            }
+
+            if (!IGListTableMatches(table, reference)) {
+                fprintf(stderr, "iteration %lld, step %d: the table differs from the reference\n", (long long)iteration,
+                        step);
+                return 1;
+            }
+        }
+    }
+    printf("%lld tables verified, %zu inserts at the last slots of a 16 slot table\n", (long long)iterations, wrapped);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    uint64_t seed = 1;
+    int64_t iterations = 2000;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = strtoll(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seed S] [--iterations N]\n", argv[0]);
+            return 2;
+        }
+    }
+    return IGListRunCheck(seed, iterations);
+}
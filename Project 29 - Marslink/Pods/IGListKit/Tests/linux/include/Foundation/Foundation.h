@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// The few Foundation macros used by the C interfaces of the C++ cores, so those sources build with a plain C++ compiler.
+// Assertions map to assert().
+
+#ifndef IGListLinuxFoundation_h
+#define IGListLinuxFoundation_h
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NS_ASSUME_NONNULL_BEGIN
+#define NS_ASSUME_NONNULL_END
+#define NS_SWIFT_NAME(name)
+#define _Nullable
+#define _Nonnull
+
+#ifdef __cplusplus
+#define FOUNDATION_EXTERN extern "C"
+#else
+#define FOUNDATION_EXTERN extern
+#endif
+
+#define NSCAssert(condition, ...) assert(condition)
+
+#endif /* IGListLinuxFoundation_h */
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+# Copyright (c) 2016-present, Facebook, Inc.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree. An additional grant
+# of patent rights can be found in the PATENTS file in the same directory.
+
+"""Print the records of a journal written by -[IGListUpdateJournal writeToURL:error:].
+
+Each line is a record with its time since the start of the journal. Records made inside an item update block are
+indented under it. With --summary, only the number of records of each type is printed.
+
+    scripts/journal_dump.py session.igjournal
+    scripts/journal_dump.py --summary session.igjournal
+"""
+
+import argparse
+import sys
+from collections import Counter
+
+PERFORM_UPDATE = 1
+ITEM_UPDATES = 2
+RECORD_NAMES = {
+    1: "performUpdate",
+    2: "itemUpdates",
+    3: "insertItems",
+    4: "deleteItems",
+    5: "moveItem",
+    6: "reloadItem",
+    7: "reloadItems",
+    8: "reloadSections",
+    9: "reloadData",
+}
+
+ANIMATED = 1 << 0
+HAS_FROM_OBJECTS = 1 << 1
+FROM_PREVIOUS_OBJECTS = 1 << 2
+HAS_TO_OBJECTS = 1 << 3
+HAS_DELTA = 1 << 4
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def at_end(self):
+        return self.offset >= len(self.data)
+
+    def byte(self):
+        if self.offset >= len(self.data):
+            raise ValueError("truncated journal")
+        value = self.data[self.offset]
+        self.offset += 1
+        return value
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            if byte & 0x80 == 0:
+                return value
+            shift += 7
+
+    def fixed64(self):
+        if len(self.data) - self.offset < 8:
+            raise ValueError("truncated journal")
+        value = int.from_bytes(self.data[self.offset:self.offset + 8], "little")
+        self.offset += 8
+        return value
+
+    def objects(self):
+        return [(self.fixed64(), self.varint()) for _ in range(self.varint())]
+
+    def ranges(self):
+        ranges = []
+        end = 0
+        for _ in range(self.varint()):
+            location = end + self.varint()
+            length = self.varint()
+            ranges.append((location, length))
+            end = location + length
+        return ranges
+
+    def pairs(self):
+        return [(self.varint(), self.varint()) for _ in range(self.varint())]
+
+
+def format_ranges(ranges):
+    return "[" + ", ".join(str(l) if n == 1 else "%d-%d" % (l, l + n - 1) for l, n in ranges) + "]"
+
+
+def format_index_paths(pairs):
+    return "[" + ", ".join("%d.%d" % pair for pair in pairs) + "]"
+
+
+def decode(data):
+    if data[:4] != b"IGLJ" or len(data) < 5:
+        raise ValueError("not an update journal")
+    if data[4] != 1:
+        raise ValueError("unsupported journal version %d" % data[4])
+
+    reader = Reader(data[5:])
+    time = 0
+    while not reader.at_end():
+        kind = reader.byte()
+        time += reader.varint()
+        parent = reader.varint()
+        if kind not in RECORD_NAMES:
+            raise ValueError("unknown record type %d" % kind)
+
+        details = ""
+        block = None
+        if kind == PERFORM_UPDATE:
+            flags = reader.byte()
+            parts = ["animated" if flags & ANIMATED else "not animated"]
+            if flags & HAS_FROM_OBJECTS:
+                if flags & FROM_PREVIOUS_OBJECTS:
+                    parts.append("from previous")
+                else:
+                    parts.append("from %d objects" % len(reader.objects()))
+            if flags & HAS_TO_OBJECTS:
+                parts.append("to %d objects" % len(reader.objects()))
+            if flags & HAS_DELTA:
+                inserts, deletes, updates = reader.ranges(), reader.ranges(), reader.ranges()
+                moves = reader.pairs()
+                parts.append("delta inserts %s deletes %s updates %s moves %d"
+                             % (format_ranges(inserts), format_ranges(deletes), format_ranges(updates), len(moves)))
+            details = ", ".join(parts)
+        elif kind == ITEM_UPDATES:
+            animated = reader.byte()
+            block = reader.varint()
+            details = "block %d, %s" % (block, "animated" if animated else "not animated")
+        elif kind in (3, 4):
+            details = format_index_paths(reader.pairs())
+        elif kind in (5, 6):
+            details = "%d.%d -> %d.%d" % (reader.varint(), reader.varint(), reader.varint(), reader.varint())
+        elif kind == 7:
+            details = "section %d -> %d, items %s" % (reader.varint(), reader.varint(), format_ranges(reader.ranges()))
+        elif kind == 8:
+            details = format_ranges(reader.ranges())
+        yield time, parent, RECORD_NAMES[kind], block, details
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("journal", help="a journal file")
+    parser.add_argument("--summary", action="store_true", help="only count records of each type")
+    args = parser.parse_args()
+
+    with open(args.journal, "rb") as f:
+        data = f.read()
+
+    counts = Counter()
+    depths = {}
+    try:
+        for time, parent, name, block, details in decode(data):
+            counts[name] += 1
+            depth = depths.get(parent, 0) if parent else 0
+            if block is not None:
+                depths[block] = depth + 1
+            if not args.summary:
+                print("%12.3fms  %s%-15s %s" % (time / 1000.0, "  " * depth, name, details))
+    except ValueError as error:
+        print("error: %s" % error, file=sys.stderr)
+        return 1
+
+    if args.summary:
+        for name, count in counts.most_common():
+            print("%-15s %d" % (name, count))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
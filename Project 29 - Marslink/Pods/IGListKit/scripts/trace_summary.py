@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Copyright (c) 2016-present, Facebook, Inc.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree. An additional grant
+# of patent rights can be found in the PATENTS file in the same directory.
+
+"""Summarize Chrome trace JSON exported by -[IGListTracer chromeTraceData].
+
+Prints, per span name, how often it ran and how long it took. With --slowest, also lists the slowest individual spans
+together with the spans nested inside them on the same thread.
+
+    scripts/trace_summary.py trace.json
+    scripts/trace_summary.py --slowest 10 trace.json other-session.json
+
+The same files open directly in chrome://tracing or https://ui.perfetto.dev for a timeline.
+"""
+
+import argparse
+import json
+import sys
+from collections import defaultdict
+
+
+def load_spans(paths):
+    spans = []
+    for index, path in enumerate(paths):
+        with open(path) as f:
+            trace = json.load(f)
+        events = trace['traceEvents'] if isinstance(trace, dict) else trace
+        for event in events:
+            if event.get('ph') != 'X':
+                continue
+            spans.append({
+                'file': index,
+                'name': event['name'],
+                'tid': event.get('tid', 0),
+                'ts': float(event['ts']),
+                'dur': float(event.get('dur', 0)),
+                'count': event.get('args', {}).get('count', 0),
+            })
+    return spans
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, int(round(fraction * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def print_summary(spans, out):
+    durations = defaultdict(list)
+    counts = defaultdict(int)
+    for span in spans:
+        durations[span['name']].append(span['dur'])
+        counts[span['name']] += span['count']
+
+    rows = sorted(durations.items(), key=lambda item: sum(item[1]), reverse=True)
+    header = '{:<28} {:>7} {:>11} {:>9} {:>9} {:>9} {:>9} {:>10}'
+    out.write(header.format('span', 'calls', 'total ms', 'mean ms', 'p50 ms', 'p95 ms', 'max ms', 'count') + '\n')
+    for name, values in rows:
+        values.sort()
+        out.write(header.format(
+            name[:28],
+            len(values),
+            '%.3f' % (sum(values) / 1000.0),
+            '%.3f' % (sum(values) / len(values) / 1000.0),
+            '%.3f' % (percentile(values, 0.5) / 1000.0),
+            '%.3f' % (percentile(values, 0.95) / 1000.0),
+            '%.3f' % (values[-1] / 1000.0),
+            counts[name]) + '\n')
+
+
+def print_slowest(spans, limit, out):
+    # spans on one thread nest by time, so children of a span are the ones that start and end within it
+    by_thread = defaultdict(list)
+    for span in spans:
+        by_thread[(span['file'], span['tid'])].append(span)
+    for thread_spans in by_thread.values():
+        thread_spans.sort(key=lambda span: (span['ts'], -span['dur']))
+
+    out.write('\nslowest spans\n')
+    for span in sorted(spans, key=lambda span: span['dur'], reverse=True)[:limit]:
+        out.write('%9.3f ms  %s (count %s) at %.3f ms\n' % (
+            span['dur'] / 1000.0, span['name'], span['count'], span['ts'] / 1000.0))
+        end = span['ts'] + span['dur']
+        for child in by_thread[(span['file'], span['tid'])]:
+            if child is span or child['ts'] < span['ts'] or child['ts'] + child['dur'] > end:
+                continue
+            out.write('    %9.3f ms  %s (count %s)\n' % (child['dur'] / 1000.0, child['name'], child['count']))
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('traces', nargs='+', help='Chrome trace JSON files')
+    parser.add_argument('--slowest', type=int, default=0, metavar='N', help='list the N slowest spans')
+    args = parser.parse_args(argv)
+
+    spans = load_spans(args.traces)
+    if not spans:
+        sys.stderr.write('no spans found\n')
+        return 1
+
+    print_summary(spans, sys.stdout)
+    if args.slowest > 0:
+        print_slowest(spans, args.slowest, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
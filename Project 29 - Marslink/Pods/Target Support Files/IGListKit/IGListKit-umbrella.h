@@ -15,13 +15,16 @@
 #import "IGListCompatibility.h"
 #import "IGListDiff.h"
 #import "IGListDiffable.h"
+#import "IGListDiffKeys.h"
 #import "IGListDiffKit.h"
 #import "IGListExperiments.h"
+#import "IGListHashQualityReport.h"
 #import "IGListIndexPathResult.h"
 #import "IGListIndexSetResult.h"
 #import "IGListMacros.h"
 #import "IGListMoveIndex.h"
 #import "IGListMoveIndexPath.h"
+#import "IGListMovePlanning.h"
 #import "NSNumber+IGListDiffable.h"
 #import "NSString+IGListDiffable.h"
 #import "IGListAdapter.h"
@@ -37,14 +40,26 @@
 #import "IGListCollectionContext.h"
 #import "IGListCollectionViewLayout.h"
 #import "IGListDisplayDelegate.h"
+#import "IGListDisplayLinkClock.h"
+#import "IGListFrameUpdateScheduler.h"
 #import "IGListGenericSectionController.h"
+#import "IGListJournalingUpdater.h"
 #import "IGListKit.h"
+#import "IGListMainQueueUpdateScheduler.h"
 #import "IGListReloadDataUpdater.h"
 #import "IGListScrollDelegate.h"
 #import "IGListSectionController.h"
+#import "IGListSimulatedCollectionView.h"
 #import "IGListSingleSectionController.h"
 #import "IGListStackedSectionController.h"
 #import "IGListSupplementaryViewSource.h"
+#import "IGListTracer.h"
+#import "IGListUpdateClock.h"
+#import "IGListUpdateCoordinator.h"
+#import "IGListUpdateCostModel.h"
+#import "IGListUpdateJournal.h"
+#import "IGListUpdateJournalReplayer.h"
+#import "IGListUpdateScheduler.h"
 #import "IGListUpdatingDelegate.h"
 #import "IGListWorkingRangeDelegate.h"
 #import "IGListAssert.h"
@@ -52,13 +67,16 @@
 #import "IGListCompatibility.h"
 #import "IGListDiff.h"
 #import "IGListDiffable.h"
+#import "IGListDiffKeys.h"
 #import "IGListDiffKit.h"
 #import "IGListExperiments.h"
+#import "IGListHashQualityReport.h"
 #import "IGListIndexPathResult.h"
 #import "IGListIndexSetResult.h"
 #import "IGListMacros.h"
 #import "IGListMoveIndex.h"
 #import "IGListMoveIndexPath.h"
+#import "IGListMovePlanning.h"
 #import "NSNumber+IGListDiffable.h"
 #import "NSString+IGListDiffable.h"
 